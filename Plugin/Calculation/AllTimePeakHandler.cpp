@@ -2,51 +2,55 @@
 
 #include "AllTimePeakHandler.h"
 
+#include <algorithm>
+
 
 AllTimePeakHandler::AllTimePeakHandler(
 	std::shared_ptr<IStatReader> statReader, 
 	std::shared_ptr<IStatWriter> statWriter, 
 	std::shared_ptr<PluginState> pluginState, 
-	std::shared_ptr<ShotStats> shotStats) 
+	std::shared_ptr<ShotStats> shotStats,
+	std::shared_ptr<SessionPrefetchCache> prefetchCache)
 	: _statReader( statReader )
 	, _statWriter( statWriter)
 	, _pluginState( pluginState )
 	, _currentStats( shotStats )
+	, _prefetchCache( prefetchCache )
 
 {
 }
 
-void copyGoalSpeedStats(const std::shared_ptr<IGoalSpeedProvider>& sourceProvider, const std::shared_ptr<FakeGoalSpeedProvider>& fakeStorage)
-{
-	fakeStorage->setFakeMin(sourceProvider->getMin());
-	fakeStorage->setFakeMax(sourceProvider->getMax());
-	fakeStorage->setFakeMean(sourceProvider->getMean());
-	fakeStorage->setFakeMedian(sourceProvider->getMedian());
-}
-
-void copyGoalSpeedStatsIfHigher(const std::shared_ptr<IGoalSpeedProvider>& sourceProvider, const std::shared_ptr<FakeGoalSpeedProvider>& fakeStorage)
+/** The peak stats only store distinct values of min, max, mean and median goal speed, which do not belong to any actual list of goal speeds. */
+GoalSpeedSummary toPeakGoalSpeed(const GoalSpeedSummary& source)
 {
-	if (fakeStorage->getMin() < sourceProvider->getMin()) { fakeStorage->setFakeMin(sourceProvider->getMin()); }
-	if (fakeStorage->getMax() < sourceProvider->getMax()) { fakeStorage->setFakeMax(sourceProvider->getMax()); }
-	if (fakeStorage->getMean() < sourceProvider->getMean()) { fakeStorage->setFakeMean(sourceProvider->getMean()); }
-	if (fakeStorage->getMedian() < sourceProvider->getMedian()) { fakeStorage->setFakeMedian(sourceProvider->getMedian()); }
+	GoalSpeedSummary peakGoalSpeed;
+	peakGoalSpeed.Min = source.Min;
+	peakGoalSpeed.Max = source.Max;
+	peakGoalSpeed.Mean = source.Mean;
+	peakGoalSpeed.Median = source.Median;
+	return peakGoalSpeed;
 }
 
+/** Returns true if the local value has been replaced. */
 template<typename T>
-void copyIfHigher(const T& newValue, T& localValue)
+bool copyIfHigher(const T& newValue, T& localValue)
 {
 	if (newValue > localValue)
 	{
 		localValue = newValue;
+		return true;
 	}
+	return false;
 }
-void copyMaxStats(const StatsData& source, StatsData& localStats, std::shared_ptr<FakeGoalSpeedProvider> localGoalSpeed)
+/** Returns true if at least one peak has been improved. */
+bool copyMaxStats(const StatsData& source, StatsData& localStats)
 {
 	// Do not modify stats where comparing doesn't make much sense / would produce conflicting results
 	// - Attempts
 	// - Goals
 	// - Initial Hits
-	// - Last50Shots
+	// - RecentShots
+	// - Rolling windows
 	// - Last 50 shot percentage
 	// - GoalStreakCounter
 	// - MissStreakCounter
@@ -57,147 +61,169 @@ void copyMaxStats(const StatsData& source, StatsData& localStats, std::shared_pt
 	// - Latest Goal Speed
 	// - LongestMissStreak (If the user does 5 shots with zero misses, and then 200 shots with one miss, is that really worse?)
 
-	// Copy over any other stats
-	copyIfHigher(source.Stats.LongestGoalStreak, localStats.Stats.LongestGoalStreak);
-	copyGoalSpeedStatsIfHigher(source.Stats.GoalSpeedStats(), localGoalSpeed);
-	copyIfHigher(source.Stats.MaxAirDribbleTouches, localStats.Stats.MaxAirDribbleTouches);
-	copyIfHigher(source.Stats.MaxAirDribbleTime, localStats.Stats.MaxAirDribbleTime);
-	copyIfHigher(source.Stats.MaxGroundDribbleTime, localStats.Stats.MaxGroundDribbleTime);
-	copyIfHigher(source.Stats.DoubleTapGoals, localStats.Stats.DoubleTapGoals);
-	copyIfHigher(source.Stats.MaxFlipResets, localStats.Stats.MaxFlipResets);
-	copyIfHigher(source.Stats.FlipResetAttemptsScored, localStats.Stats.FlipResetAttemptsScored);
+	// Copy over any other stats. Every stat has to be compared, so the results must not be combined with a short-circuiting ||
+	auto hasImproved = false;
+	hasImproved |= copyIfHigher(source.Stats.LongestGoalStreak, localStats.Stats.LongestGoalStreak);
+	hasImproved |= copyIfHigher(source.Stats.GoalSpeed.Min, localStats.Stats.GoalSpeed.Min);
+	hasImproved |= copyIfHigher(source.Stats.GoalSpeed.Max, localStats.Stats.GoalSpeed.Max);
+	hasImproved |= copyIfHigher(source.Stats.GoalSpeed.Mean, localStats.Stats.GoalSpeed.Mean);
+	hasImproved |= copyIfHigher(source.Stats.GoalSpeed.Median, localStats.Stats.GoalSpeed.Median);
+	hasImproved |= copyIfHigher(source.Stats.MaxAirDribbleTouches, localStats.Stats.MaxAirDribbleTouches);
+	hasImproved |= copyIfHigher(source.Stats.MaxAirDribbleTime, localStats.Stats.MaxAirDribbleTime);
+	hasImproved |= copyIfHigher(source.Stats.MaxGroundDribbleTime, localStats.Stats.MaxGroundDribbleTime);
+	hasImproved |= copyIfHigher(source.Stats.DoubleTapGoals, localStats.Stats.DoubleTapGoals);
+	hasImproved |= copyIfHigher(source.Stats.MaxFlipResets, localStats.Stats.MaxFlipResets);
+	hasImproved |= copyIfHigher(source.Stats.FlipResetAttemptsScored, localStats.Stats.FlipResetAttemptsScored);
 
 	// Copy over calculated data
-	copyIfHigher(source.Data.AverageFlipResetsPerAttempt, localStats.Data.AverageFlipResetsPerAttempt);
-	copyIfHigher(source.Data.DoubleTapGoalPercentage, localStats.Data.DoubleTapGoalPercentage);
-	copyIfHigher(source.Data.FlipResetGoalPercentage, localStats.Data.FlipResetGoalPercentage);
-	copyIfHigher(source.Data.InitialHitPercentage, localStats.Data.InitialHitPercentage);
-	copyIfHigher(source.Data.PeakSuccessPercentage, localStats.Data.PeakSuccessPercentage);
-	copyIfHigher(source.Data.SuccessPercentage, localStats.Data.SuccessPercentage);
+	hasImproved |= copyIfHigher(source.Data.AverageFlipResetsPerAttempt, localStats.Data.AverageFlipResetsPerAttempt);
+	hasImproved |= copyIfHigher(source.Data.DoubleTapGoalPercentage, localStats.Data.DoubleTapGoalPercentage);
+	hasImproved |= copyIfHigher(source.Data.FlipResetGoalPercentage, localStats.Data.FlipResetGoalPercentage);
+	hasImproved |= copyIfHigher(source.Data.InitialHitPercentage, localStats.Data.InitialHitPercentage);
+	hasImproved |= copyIfHigher(source.Data.PeakSuccessPercentage, localStats.Data.PeakSuccessPercentage);
+	hasImproved |= copyIfHigher(source.Data.SuccessPercentage, localStats.Data.SuccessPercentage);
+	return hasImproved;
 }
 
 void AllTimePeakHandler::reset()
 {
-	// Read the all time stats from the file. If that doesn't work, use the current stats (most likely empty) as peak base
-	if (!readAllStatFile())
-	{
-		copyStats(*_currentStats, false /* stats weren't restored from file */);
-	}
-}
+	auto resetNumber = ++_numberOfResets;
+	_peakStatsAreLoading = true;
+	readAllStatFile([this, resetNumber](const ShotStats& stats) {
+		if (resetNumber != _numberOfResets)
+		{
+			return; // The training pack was changed in the meantime
+		}
 
-void restoreGoalSpeedFromFile(const PlayerStats& statsFromFile, const std::shared_ptr<FakeGoalSpeedProvider> fakeProvider)
-{
-	fakeProvider->setFakeMin(statsFromFile.MinGoalSpeedFromFile);
-	fakeProvider->setFakeMax(statsFromFile.MaxGoalSpeedFromFile);
-	fakeProvider->setFakeMean(statsFromFile.MeanGoalSpeedFromFile);
-	fakeProvider->setFakeMedian(statsFromFile.MedianGoalSpeedFromFile);
+		// Use the all time stats from the file. If there are none, use the current stats (most likely empty) as peak base
+		if (stats.hasAttempts())
+		{
+			copyStats(stats);
+			markAllPeaksAsDirty(false);
+		}
+		else
+		{
+			// There is no peak file yet, so it has to be created
+			copyStats(*_currentStats);
+			markAllPeaksAsDirty(true);
+		}
+		_peakStatsAreLoading = false;
+
+		auto pendingRequests = std::move(_pendingRequests);
+		_pendingRequests.clear();
+		for (const auto& request : pendingRequests)
+		{
+			request(getPeakStats());
+		}
+	});
 }
-void AllTimePeakHandler::copyStats(const ShotStats& source, bool statsWereRestoredFromFile)
+
+void AllTimePeakHandler::copyStats(const ShotStats& source)
 {
-	// Looks like this is called the first time, or the pack has changed. Store everything
-	_allTimePeakStats = source;
+	// Looks like this is called the first time, or the pack has changed. Store everything except for the goal speed values
+	_allTimePeakStats = ShotStats();
+	_allTimePeakStats.AllShotStats = source.AllShotStats;
+	_allTimePeakStats.PerShotStats = source.PerShotStats;
 
 	// Set attempts to 1. We only use it to detect whether or not we were able to restore the file
 	_allTimePeakStats.AllShotStats.Stats.Attempts = 1;
 
-	// We have to do a little more work for goal speed: We don't want to store the actual goal stats, but rather the
-	// single values of min, max, mean and median distinctly
-	_allTimePeakStats.AllShotStats.Stats.setGoalSpeedProvider(_allStatGoalSpeedProvider);
-	if (statsWereRestoredFromFile)
-	{
-		restoreGoalSpeedFromFile(source.AllShotStats.Stats, _allStatGoalSpeedProvider);
-	}
-	else
+	// We don't want to store the actual goal stats, but rather the single values of min, max, mean and median distinctly
+	_allTimePeakStats.AllShotStats.Stats.GoalSpeed = toPeakGoalSpeed(source.AllShotStats.Stats.GoalSpeed);
+	for (auto& statsData : _allTimePeakStats.PerShotStats)
 	{
-		copyGoalSpeedStats(source.AllShotStats.Stats.GoalSpeedStats(), _allStatGoalSpeedProvider);
-	}
-
-	_perShotGoalSpeedProviders.clear();
-	for (auto shotNumber = 0; shotNumber < _allTimePeakStats.PerShotStats.size(); shotNumber++)
-	{
-		auto fakeProvider = std::make_shared<FakeGoalSpeedProvider>();
-		if (statsWereRestoredFromFile)
-		{
-			restoreGoalSpeedFromFile(source.PerShotStats[shotNumber].Stats, fakeProvider);
-		}
-		else
-		{
-			copyGoalSpeedStats(source.PerShotStats[shotNumber].Stats.GoalSpeedStats(), fakeProvider);
-		}
-		_allTimePeakStats.PerShotStats[shotNumber].Stats.setGoalSpeedProvider(fakeProvider);
-		_perShotGoalSpeedProviders.push_back(fakeProvider);
+		statsData.Stats.GoalSpeed = toPeakGoalSpeed(statsData.Stats.GoalSpeed);
 	}
 }
 
 void AllTimePeakHandler::updateMaximumStats()
 {
-	auto statsHaveBeenAdapted = false;
+	if (_peakStatsAreLoading)
+	{
+		return; // Writing now would replace the stored peak stats. Any improvement will be picked up by the next update instead
+	}
+
 	if (_currentStats->PerShotStats.size() != _allTimePeakStats.PerShotStats.size())
 	{
 		// First call or the training pack changed, or the file got corrupted => reset
 		reset();
-		statsHaveBeenAdapted = true;
 	}
 	else
 	{
 		// Start storing peak stats only after hitting 20 shots. Otherwise, the first shot could set everything to 100% if it is a goal
 		if (_currentStats->AllShotStats.Stats.Attempts >= 20)
 		{
-			copyMaxStats(_currentStats->AllShotStats, _allTimePeakStats.AllShotStats, _allStatGoalSpeedProvider);
+			if (copyMaxStats(_currentStats->AllShotStats, _allTimePeakStats.AllShotStats))
+			{
+				_allShotPeaksAreDirty = true;
+			}
 			for (auto shotNumber = 0; shotNumber < _allTimePeakStats.PerShotStats.size(); shotNumber++)
 			{
-				copyMaxStats(_currentStats->PerShotStats.at(shotNumber), _allTimePeakStats.PerShotStats[shotNumber], _perShotGoalSpeedProviders[shotNumber]);
+				if (copyMaxStats(_currentStats->PerShotStats.at(shotNumber), _allTimePeakStats.PerShotStats[shotNumber]))
+				{
+					_dirtyShotPeaks[shotNumber] = true;
+				}
 			}
-			statsHaveBeenAdapted = true;
 		}
 	}
 
-	if (statsHaveBeenAdapted)
+	// Rewriting unchanged peaks would only cost file I/O on every round change
+	if (!_peakStatsAreLoading && hasDirtyPeaks())
 	{
 		writeAllStatFile();
 	}
 }
 
-ShotStats AllTimePeakHandler::getPeakStats() const
+void AllTimePeakHandler::markAllPeaksAsDirty(bool isDirty)
 {
-	auto newStats = ShotStats{ _allTimePeakStats };
-
-	// We don't want the stats to be automatically updated, so we need to replace fake goal speed providers
-	auto fakeProvider = std::make_shared<FakeGoalSpeedProvider>();
-	newStats.AllShotStats.Stats.setGoalSpeedProvider(fakeProvider);
-	copyGoalSpeedStats(_allTimePeakStats.AllShotStats.Stats.GoalSpeedStats(), fakeProvider);
+	_allShotPeaksAreDirty = isDirty;
+	_dirtyShotPeaks.assign(_allTimePeakStats.PerShotStats.size(), isDirty);
+}
 
-	for (auto shotNumber = 0; shotNumber < newStats.PerShotStats.size(); shotNumber++)
-	{
-		fakeProvider = std::make_shared<FakeGoalSpeedProvider>();
-		newStats.PerShotStats[shotNumber].Stats.setGoalSpeedProvider(fakeProvider);
-		copyGoalSpeedStats(_allTimePeakStats.PerShotStats[shotNumber].Stats.GoalSpeedStats(), fakeProvider);
-	}
+bool AllTimePeakHandler::hasDirtyPeaks() const
+{
+	return _allShotPeaksAreDirty || std::find(_dirtyShotPeaks.begin(), _dirtyShotPeaks.end(), true) != _dirtyShotPeaks.end();
+}
 
-	return newStats;
+ShotStats AllTimePeakHandler::getPeakStats() const
+{
+	// The goal speed statistics are stored by value, so the copy won't be updated along with the peak stats
+	return _allTimePeakStats;
 }
 
 bool AllTimePeakHandler::writeAllStatFile()
 {
 	if (_pluginState->TrainingPackCode.empty()) { return true; }
 
-	auto fileName = _pluginState->TrainingPackCode;
+	// The peak file is still stored as text, so it can only be replaced as a whole, even if only some of the shots are dirty
 	_statWriter->writeTrainingPackStatistics(_allTimePeakStats, _pluginState->TrainingPackCode);
+	markAllPeaksAsDirty(false);
 	return true;
 }
 
-bool AllTimePeakHandler::readAllStatFile()
+void AllTimePeakHandler::requestPeakStats(std::function<void(const ShotStats&)> onAvailable)
 {
-	if (_pluginState->TrainingPackCode.empty()) { return false; }
-
-	auto stats = _statReader->readTrainingPackStatistics(_pluginState->TrainingPackCode);
-	if (!stats.hasAttempts())
+	if (_peakStatsAreLoading)
 	{
-		// We couldn't restore anything
-		return false;
+		_pendingRequests.push_back(onAvailable);
+		return;
 	}
+	onAvailable(getPeakStats());
+}
 
-	// Else: restore the all time peak stats from the file
-	copyStats(stats, true /* stats were restored from file. */);
-	return true;
+void AllTimePeakHandler::readAllStatFile(std::function<void(const ShotStats&)> onRead)
+{
+	if (_prefetchCache)
+	{
+		// The file was most likely prefetched as soon as the training pack code was known
+		_prefetchCache->requestPeakStats(_pluginState->TrainingPackCode, onRead);
+	}
+	else if (_pluginState->TrainingPackCode.empty())
+	{
+		onRead({});
+	}
+	else
+	{
+		onRead(_statReader->readTrainingPackStatistics(_pluginState->TrainingPackCode));
+	}
 }
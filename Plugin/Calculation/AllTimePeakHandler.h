@@ -1,17 +1,20 @@
 #pragma once
 
+#include "../DLLImportExport.h"
 #include "../Core/IStatReader.h"
 #include "../Core/IStatWriter.h"
 #include "../Data/PluginState.h"
-#include "../Data/FakeGoalSpeedProvider.h"
+#include "../Storage/SessionPrefetchCache.h"
 
+#include <functional>
 #include <memory>
 
 /** This class is responsible for storing the "all time peak" of any stat for each shot/pack. 
 
 	This allows detection of breaking personal records, and will be a better indicator than comparing to e.g. a session which was aborted, but not continued.
+	The peak file only gets written if at least one peak has actually improved since it was written last.
 */
-class AllTimePeakHandler
+class GOALPERCENTAGECOUNTER_IMPORT_EXPORT AllTimePeakHandler
 {
 public:
 	/** Constructor. */
@@ -19,10 +22,11 @@ public:
 		std::shared_ptr<IStatReader> statReader,
 		std::shared_ptr<IStatWriter> statWriter,
 		std::shared_ptr<PluginState> pluginState,
-		std::shared_ptr<ShotStats> shotStats
+		std::shared_ptr<ShotStats> shotStats,
+		std::shared_ptr<SessionPrefetchCache> prefetchCache
 	);
 
-	/** Resets, e.g. after switching to a new training pack. */
+	/** Resets, e.g. after switching to a new training pack. The peak stats of the training pack might get loaded in the background. */
 	void reset();
 
 	/** Updates any stat which is considered better if higher and writes them to the file in case they were improved. */
@@ -30,17 +34,29 @@ public:
 
 	/** Retrieves the peak stats for the current training pack. Empty struct if not in a training pack, or during the first time. */
 	ShotStats getPeakStats() const;
+
+	/** Passes the peak stats for the current training pack to the callback as soon as they have been loaded. */
+	void requestPeakStats(std::function<void(const ShotStats&)> onAvailable);
 private:
 
-	void copyStats(const ShotStats& source, bool statsWereRestoredFromFile);
+	void copyStats(const ShotStats& source);
+	/** Marks the peaks of every shot and of the training pack as a whole as changed or unchanged. */
+	void markAllPeaksAsDirty(bool isDirty);
+	/** Checks whether any peak has changed since the peak file was written last. */
+	bool hasDirtyPeaks() const;
 	bool writeAllStatFile();
-	bool readAllStatFile();
+	/** Passes the all time stats from the file to the callback. They have zero attempts if there is no file. */
+	void readAllStatFile(std::function<void(const ShotStats&)> onRead);
 
 	std::shared_ptr<IStatReader> _statReader;		///< Allows reading the all time max from a file.
 	std::shared_ptr<IStatWriter> _statWriter;		///< Allows writing the all time max to a file.
 	std::shared_ptr<PluginState> _pluginState;		///< The current settings of the plugin.
 	std::shared_ptr<ShotStats> _currentStats;		///< The stats of the current training session.
-	ShotStats _allTimePeakStats;	///< The current best stats for a pack. Note that for some stats, a lower value might be better.
-	std::shared_ptr<FakeGoalSpeedProvider> _allStatGoalSpeedProvider = std::make_shared<FakeGoalSpeedProvider>(); ///< Allows setting fake values for min, max, median and mean goal speed.
-	std::vector<std::shared_ptr<FakeGoalSpeedProvider>> _perShotGoalSpeedProviders; ///< Allows setting fake values for min, max, median and mean goal speed for single shots.
+	std::shared_ptr<SessionPrefetchCache> _prefetchCache;	///< Provides the peak file, which is loaded in the background. May be nullptr, in which case the file gets read right away.
+	bool _peakStatsAreLoading = false;					///< True while the peak file of the current training pack is being loaded. Nothing may be written meanwhile.
+	int _numberOfResets = 0;							///< Identifies the most recent reset, so outdated peak stats can be ignored.
+	std::vector<std::function<void(const ShotStats&)>> _pendingRequests; ///< Requests for the peak stats which were made while they were being loaded.
+	ShotStats _allTimePeakStats;	///< The current best stats for a pack. Note that for some stats, a lower value might be better. Goal speed values are not stored, only their peak statistics.
+	bool _allShotPeaksAreDirty = false;	///< True if a peak of the training pack as a whole has changed since the peak file was written last.
+	std::vector<bool> _dirtyShotPeaks;	///< Stores for every shot whether one of its peaks has changed since the peak file was written last.
 };
\ No newline at end of file
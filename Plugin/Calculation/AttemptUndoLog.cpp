@@ -0,0 +1,61 @@
+#include <pch.h>
+#include "AttemptUndoLog.h"
+
+#include <algorithm>
+
+AttemptUndoLog::AttemptUndoLog(size_t capacity)
+	: _records(std::max<size_t>(capacity, 1))
+{
+}
+
+void AttemptUndoLog::clear()
+{
+	_nextIndex = 0;
+	_numberOfUndoableRecords = 0;
+	_numberOfRedoableRecords = 0;
+}
+
+AttemptUndoRecord& AttemptUndoLog::beginAttempt(int shotIndex)
+{
+	// The stats are not reset since the caller replaces them anyway
+	auto& record = _records[_nextIndex];
+	record.ShotIndex = shotIndex;
+	record.IsFinished = false;
+	record.WasGoal = false;
+	record.GoalSpeed = .0f;
+	record.FlipResetOccurred = false;
+
+	// Once the buffer is full, the oldest record gets replaced
+	_nextIndex = (_nextIndex + 1) % _records.size();
+	_numberOfUndoableRecords = std::min<size_t>(_numberOfUndoableRecords + 1, _records.size());
+	_numberOfRedoableRecords = 0;
+	return record;
+}
+
+AttemptUndoRecord* AttemptUndoLog::getMostRecent()
+{
+	if (_numberOfUndoableRecords == 0) { return nullptr; }
+
+	return &_records[(_nextIndex + _records.size() - 1) % _records.size()];
+}
+
+AttemptUndoRecord* AttemptUndoLog::undo()
+{
+	if (_numberOfUndoableRecords == 0) { return nullptr; }
+
+	_nextIndex = (_nextIndex + _records.size() - 1) % _records.size();
+	_numberOfUndoableRecords--;
+	_numberOfRedoableRecords++;
+	return &_records[_nextIndex];
+}
+
+AttemptUndoRecord* AttemptUndoLog::redo()
+{
+	if (_numberOfRedoableRecords == 0) { return nullptr; }
+
+	auto& record = _records[_nextIndex];
+	_nextIndex = (_nextIndex + 1) % _records.size();
+	_numberOfRedoableRecords--;
+	_numberOfUndoableRecords++;
+	return &record;
+}
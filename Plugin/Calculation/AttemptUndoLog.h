@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+
+#include "../DLLImportExport.h"
+#include "../Data/StatsData.h"
+
+/** A single attempt of the AttemptUndoLog.
+ *
+ * Only the all shot stats and the stats of the shot the attempt was made on are stored, since an attempt doesn't change any other shot.
+ * This way, recording an attempt takes the same time no matter how many shots the training pack has.
+ */
+struct AttemptUndoRecord
+{
+	int ShotIndex = -1;						///< The shot the attempt was made on, or -1 if it could not be assigned to a shot.
+	bool IsFinished = false;				///< True once the attempt ended with a goal or a miss.
+	bool WasGoal = false;					///< True if the attempt ended with a goal.
+	float GoalSpeed = .0f;					///< The goal speed which was added for the goal, if the attempt ended with a goal.
+	bool FlipResetOccurred = false;			///< True if a flip reset happened during the attempt. This decides whether a goal counts as a flip reset goal when toggling.
+	StatsData AllShotStatsAtStart;			///< The all shot stats before the attempt was started. Restoring them undoes the whole attempt.
+	StatsData ShotStatsAtStart;				///< The stats of the shot before the attempt was started.
+	StatsData AllShotStatsBeforeOutcome;	///< The all shot stats right before the goal or the miss. Restoring them allows replacing the outcome.
+	StatsData ShotStatsBeforeOutcome;		///< The stats of the shot right before the goal or the miss.
+	StatsData AllShotStatsAtUndo;			///< The all shot stats at the moment the attempt was undone. Restoring them redoes the attempt.
+	StatsData ShotStatsAtUndo;				///< The stats of the shot at the moment the attempt was undone.
+};
+
+/** Remembers the most recent attempts, so they can be undone, redone, or toggled between goal and miss.
+ *
+ * The records are stored in a ring buffer which gets allocated once, so recording an attempt does not allocate anything. Once the log is full,
+ * the oldest attempt can't be undone anymore. Undone attempts can be redone until a new attempt gets started.
+ */
+class GOALPERCENTAGECOUNTER_IMPORT_EXPORT AttemptUndoLog
+{
+public:
+	static constexpr size_t DefaultCapacity = 20;	///< The number of attempts which can be undone by default.
+
+	/** Creates an empty log which is able to store the given number of attempts. */
+	explicit AttemptUndoLog(size_t capacity = DefaultCapacity);
+
+	/** Forgets all attempts, e.g. after resetting or restoring stats. */
+	void clear();
+
+	/** Adds a new attempt on the given shot and provides its record, so the stats can be stored in it. Undone attempts can't be redone anymore afterwards. */
+	AttemptUndoRecord& beginAttempt(int shotIndex);
+	/** Provides the most recent attempt which has not been undone, or nullptr if there is none. */
+	AttemptUndoRecord* getMostRecent();
+	/** Marks the most recent attempt as undone and provides its record, or returns nullptr if there is nothing to be undone. */
+	AttemptUndoRecord* undo();
+	/** Marks the most recently undone attempt as done again and provides its record, or returns nullptr if there is nothing to be redone. */
+	AttemptUndoRecord* redo();
+
+	/** Retrieves the number of attempts which can be undone. */
+	inline size_t getNumberOfUndoableAttempts() const { return _numberOfUndoableRecords; }
+	/** Retrieves the number of attempts which can be redone. */
+	inline size_t getNumberOfRedoableAttempts() const { return _numberOfRedoableRecords; }
+
+	/** Calls the given function for every stats object which is stored in any record, e.g. for applying changed rolling windows. */
+	template<typename Function>
+	void forEachStatsData(Function function)
+	{
+		for (auto& record : _records)
+		{
+			function(record.AllShotStatsAtStart);
+			function(record.ShotStatsAtStart);
+			function(record.AllShotStatsBeforeOutcome);
+			function(record.ShotStatsBeforeOutcome);
+			function(record.AllShotStatsAtUndo);
+			function(record.ShotStatsAtUndo);
+		}
+	}
+
+private:
+	std::vector<AttemptUndoRecord> _records;	///< The ring buffer of records. Its size never changes.
+	size_t _nextIndex = 0;						///< The index of the record which follows the most recent attempt. Redoable records start here.
+	size_t _numberOfUndoableRecords = 0;		///< The number of records before _nextIndex which can be undone.
+	size_t _numberOfRedoableRecords = 0;		///< The number of records from _nextIndex on which can be redone.
+};
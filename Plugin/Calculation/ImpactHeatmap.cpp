@@ -0,0 +1,82 @@
+#include <pch.h>
+#include "ImpactHeatmap.h"
+
+#include <algorithm>
+
+constexpr auto KernelSize = 2 * ImpactHeatmap::KernelRadius + 1;
+
+/** Calculates the falloff for each distance to the impact bracket, which halves with every bracket: 0.5, 0.25, 0.125, ... */
+constexpr std::array<float, KernelSize> createFalloffKernel()
+{
+	std::array<float, KernelSize> kernel = {};
+	for (auto index = 0; index < KernelSize; index++)
+	{
+		auto distance = index < ImpactHeatmap::KernelRadius ? ImpactHeatmap::KernelRadius - index : index - ImpactHeatmap::KernelRadius;
+		auto magnitude = 0.5f;
+		for (auto step = 0; step < distance; step++)
+		{
+			magnitude /= 2.0f; // Powers of two are exact, so this matches 0.5f / pow(2.0f, distance)
+		}
+		kernel[index] = magnitude;
+	}
+	return kernel;
+}
+
+/** The falloff along a single axis. A bracket receives the sum of the falloff in X and in Z direction. */
+constexpr auto FalloffKernel = createFalloffKernel();
+static_assert(FalloffKernel[ImpactHeatmap::KernelRadius] == 0.5f, "The impact bracket must receive half of an impact per dimension.");
+
+void ImpactHeatmap::clear()
+{
+	_data = {};
+	_maximumValue = .0f;
+}
+
+void ImpactHeatmap::restore(const Grid& data, float maximumValue)
+{
+	_data = data;
+	_maximumValue = maximumValue;
+}
+
+void ImpactHeatmap::addImpact(const Vector& location)
+{
+	// Get the array bracket for the X dimension
+	auto xBracket = (int)(location.X + 4000) / XBracketWidth;
+	// Get the array bracket for the Z dimension
+	auto zBracket = (int)location.Z / ZBracketHeight;
+
+	addImpact(xBracket, zBracket);
+}
+
+void ImpactHeatmap::addImpact(int xBracket, int zBracket)
+{
+	// Clip the kernel to the grid once, so the loops below do not need to check every bracket
+	auto xBegin = std::max<int>(xBracket - KernelRadius, 0);
+	auto xEnd = std::min<int>(xBracket + KernelRadius + 1, XBrackets);
+	auto zBegin = std::max<int>(zBracket - KernelRadius, 0);
+	auto zEnd = std::min<int>(zBracket + KernelRadius + 1, ZBrackets);
+	if (xBegin >= xEnd || zBegin >= zEnd)
+	{
+		return; // The kernel does not overlap the grid at all
+	}
+
+	auto maximumValue = _maximumValue;
+	auto zKernel = FalloffKernel.data() + (zBegin - zBracket + KernelRadius);
+	auto numberOfZBrackets = zEnd - zBegin;
+	for (auto x = xBegin; x < xEnd; x++)
+	{
+		auto xMagnitude = FalloffKernel[x - xBracket + KernelRadius];
+		auto row = _data[x].data() + zBegin;
+
+		// Plain loops over contiguous memory without branches, so the compiler can vectorize them
+		for (auto z = 0; z < numberOfZBrackets; z++)
+		{
+			row[z] += xMagnitude + zKernel[z];
+		}
+		for (auto z = 0; z < numberOfZBrackets; z++)
+		{
+			maximumValue = std::max<float>(maximumValue, row[z]);
+		}
+	}
+	_maximumValue = maximumValue;
+}
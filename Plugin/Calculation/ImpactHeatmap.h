@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+
+#include <bakkesmod/wrappers/wrapperstructs.h>
+
+#include "../DLLImportExport.h"
+
+/** Accumulates the impact locations on the backboard or goal surface into a grid of brackets.
+ *
+ * Every impact adds a falloff kernel around its bracket. The kernel is precomputed at compile time, and the area it covers gets clipped to
+ * the grid once per impact, so restoring a session with many impacts only has to add up contiguous rows.
+ */
+class GOALPERCENTAGECOUNTER_IMPORT_EXPORT ImpactHeatmap
+{
+public:
+	static constexpr int XBrackets = 160; ///< Defines the number of brackets in X dimension. The number 8000 should be dividable by this number.
+	static constexpr int ZBrackets = 80; ///< Defines the number of brackets in Z dimension. The number 4000 should be dividable by this number.
+	static constexpr int XBracketWidth = 8000 / XBrackets; ///< The width of a bracket in unreal units.
+	static constexpr int ZBracketHeight = 4000 / ZBrackets; ///< The height of a bracket in unreal units.
+	static constexpr int KernelRadius = 5; ///< The number of brackets around the impact bracket which get incremented as well, in each direction.
+
+	using Grid = std::array<std::array<float, ZBrackets>, XBrackets>;
+
+	/** Removes all impacts. */
+	void clear();
+	/** Replaces all brackets, e.g. by a heatmap which was stored along with the impact locations. */
+	void restore(const Grid& data, float maximumValue);
+
+	/** Increments the bracket at the given location by 1 and slightly increments brackets around that location. */
+	void addImpact(const Vector& location);
+	/** Increments the given bracket by 1 and slightly increments brackets around it. The bracket may be outside of the grid. */
+	void addImpact(int xBracket, int zBracket);
+
+	/** Retrieves the value of every bracket. */
+	inline const Grid& getData() const { return _data; }
+	/** Retrieves the maximum value of all brackets. */
+	inline float getMaximumValue() const { return _maximumValue; }
+
+private:
+	Grid _data = {};			///< Stores the accumulated kernels of all impacts.
+	float _maximumValue = .0f;	///< The maximum value of all brackets.
+};
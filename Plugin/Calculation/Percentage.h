@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cmath>
+
+/** Calculates the percentage of goals in the given attempts, rounded to two decimal places, e.g. 33.33 for 1 goal in 3 attempts. */
+inline double getPercentageValue(double attempts, double goals)
+{
+	return std::round((goals / attempts) * 10000.0) / 100.0;
+}
@@ -0,0 +1,97 @@
+#include <pch.h>
+#include "RollingWindowCalculator.h"
+#include "Percentage.h"
+
+#include <algorithm>
+
+/** Converts the given window sizes into the windows which can actually be tracked. */
+std::vector<int> getValidWindowSizes(const std::vector<int>& windowSizes)
+{
+	std::vector<int> validSizes;
+	for (auto windowSize : windowSizes)
+	{
+		if (validSizes.size() >= (size_t)RollingWindowDefs::MaxNumberOfWindows) { break; }
+
+		if (windowSize > 0 && windowSize <= RollingWindowDefs::MaxWindowSize)
+		{
+			validSizes.push_back(windowSize);
+		}
+	}
+	return validSizes;
+}
+
+void RollingWindowCalculator::configureWindows(StatsData& statsData, const std::vector<int>& windowSizes)
+{
+	const auto& recentShots = statsData.Stats.RecentShots;
+	auto previousWindows = statsData.Data.RollingWindows;
+	auto validSizes = getValidWindowSizes(windowSizes);
+
+	statsData.Data.RollingWindows = {};
+	for (size_t index = 0; index < validSizes.size(); index++)
+	{
+		auto& window = statsData.Data.RollingWindows[index];
+		auto previousWindow = std::find_if(previousWindows.begin(), previousWindows.end(), [size = validSizes[index]](const RollingWindow& previous) {
+			return previous.Size == size;
+		});
+		if (previousWindow != previousWindows.end())
+		{
+			window = *previousWindow;
+			continue;
+		}
+
+		// A new window can only count the shots which are still known. Its peak starts from scratch
+		window.Size = validSizes[index];
+		window.Goals = (int32_t)recentShots.numberOfGoalsInLast((size_t)window.Size);
+	}
+	updatePercentages(statsData);
+}
+
+bool RollingWindowCalculator::hasWindowSizes(const StatsData& statsData, const std::vector<int>& windowSizes)
+{
+	auto validSizes = getValidWindowSizes(windowSizes);
+	for (size_t index = 0; index < statsData.Data.RollingWindows.size(); index++)
+	{
+		auto expectedSize = index < validSizes.size() ? validSizes[index] : 0;
+		if (statsData.Data.RollingWindows[index].Size != expectedSize) { return false; }
+	}
+	return true;
+}
+
+void RollingWindowCalculator::addShot(StatsData& statsData, bool isGoal)
+{
+	auto& recentShots = statsData.Stats.RecentShots;
+	for (auto& window : statsData.Data.RollingWindows)
+	{
+		if (window.Size <= 0) { break; }
+
+		// Once the window is full, the oldest shot in it leaves the window
+		if (recentShots.size() >= (size_t)window.Size && recentShots[recentShots.size() - window.Size])
+		{
+			window.Goals--;
+		}
+		if (isGoal)
+		{
+			window.Goals++;
+		}
+	}
+	recentShots.push_back(isGoal);
+}
+
+void RollingWindowCalculator::updatePercentages(StatsData& statsData)
+{
+	auto numberOfShots = (int)statsData.Stats.RecentShots.size();
+	for (auto& window : statsData.Data.RollingWindows)
+	{
+		if (window.Size <= 0) { break; }
+
+		auto numberOfShotsInWindow = std::min<int>(numberOfShots, window.Size);
+		window.Percentage = numberOfShotsInWindow > 0 ? getPercentageValue(numberOfShotsInWindow, window.Goals) : .0;
+
+		// Just like the peak of the last 50 shots, the peak is not tracked until there were enough attempts to make it meaningful
+		if (statsData.Stats.Attempts >= std::min<int>(window.Size, RollingWindowDefs::MinAttemptsForPeak) && window.Percentage > window.PeakPercentage)
+		{
+			window.PeakPercentage = window.Percentage;
+			window.PeakShotNumber = statsData.Stats.Attempts;
+		}
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vector>
+
+#include "../DLLImportExport.h"
+#include "../Data/StatsData.h"
+
+/** Keeps the rolling windows of a StatsData object up to date.
+ *
+ * Every window keeps its own goal count, which gets adjusted by the shot entering and the shot leaving the window whenever a shot is added.
+ * This way, all windows can be updated in constant time per shot, regardless of their size. The shots themselves are stored once in
+ * PlayerStats::RecentShots, which is large enough for the largest window.
+ */
+class GOALPERCENTAGECOUNTER_IMPORT_EXPORT RollingWindowCalculator
+{
+public:
+	/** Changes the windows of the given stats to the given sizes. Windows which existed before keep their peak, new windows get their goals
+	 * counted from the recent shots. Sizes beyond RollingWindowDefs::MaxWindowSize or RollingWindowDefs::MaxNumberOfWindows are ignored.
+	 */
+	static void configureWindows(StatsData& statsData, const std::vector<int>& windowSizes);
+
+	/** Returns true if the windows of the given stats have the given sizes already. */
+	static bool hasWindowSizes(const StatsData& statsData, const std::vector<int>& windowSizes);
+
+	/** Adds a shot to the recent shots of the given stats and updates the goal count of every window. */
+	static void addShot(StatsData& statsData, bool isGoal);
+
+	/** Updates the percentage and the peak of every window. Call this after the number of attempts was updated. */
+	static void updatePercentages(StatsData& statsData);
+};
@@ -7,8 +7,8 @@
 
 const auto YThreshold = 4900.0f;
 const auto YDrawLocation = 5100.0f;
-const auto XBracketWidth = 8000 / ShotDistributionTracker::XBrackets;
-const auto ZBracketHeight = 4000 / ShotDistributionTracker::ZBrackets;
+const auto XBracketWidth = ImpactHeatmap::XBracketWidth;
+const auto ZBracketHeight = ImpactHeatmap::ZBracketHeight;
 
 
 ShotDistributionTracker::ShotDistributionTracker(std::shared_ptr<GameWrapper> gameWrapper)
@@ -31,45 +31,37 @@ void ShotDistributionTracker::onTrainingModeLoaded(TrainingEditorWrapper& traini
 {
 	_furtherWallHitsShallBeIgnored = false;
 
-	for (auto x = 0; x < XBrackets; x++)
-	{
-		for (auto z = 0; z < ZBrackets; z++)
-		{
-			_heatmapData[x][z] = .0f;
-		}
-	}
-	_maximumValue = .0f;
+	_heatmap.clear();
 	_shotLocations.clear();
 }
 
 void ShotDistributionTracker::registerImpactLocation(Vector ballLocation)
 {
 	_shotLocations.emplace_back(Vector(ballLocation.X, YDrawLocation - 10.0f, ballLocation.Z));
+	_heatmap.addImpact(ballLocation);
+}
 
-	// Get the array bracket for the X dimension
-	auto xBracket = (int)(ballLocation.X + 4000) / XBracketWidth;
-	// Get the array bracket for the Z dimension
-	auto zBracket = (int)ballLocation.Z / ZBracketHeight;
-
-	for (auto x = xBracket - 5; x < XBrackets && x <= xBracket + 5; x++)
+void ShotDistributionTracker::restoreImpacts(const StoredImpacts& impacts)
+{
+	// The stored heatmap can only be taken over if there is nothing to be merged with it. Otherwise, every impact gets added again
+	size_t numberOfLocationsInHeatmap = 0;
+	if (impacts.Heatmap && _shotLocations.empty() && impacts.NumberOfLocationsInHeatmap <= impacts.Locations.size())
 	{
-		auto xDifference = abs((float)(x - xBracket));
-		auto xMagnitude = 0.5f / pow(2.0f, xDifference); 
+		_heatmap.restore(impacts.Heatmap->getData(), impacts.Heatmap->getMaximumValue());
+		numberOfLocationsInHeatmap = impacts.NumberOfLocationsInHeatmap;
+	}
 
-		for (auto z = zBracket - 5; z < ZBrackets && z <= zBracket + 5; z++)
+	_shotLocations.reserve(_shotLocations.size() + impacts.Locations.size());
+	for (size_t index = 0; index < impacts.Locations.size(); index++)
+	{
+		const auto& location = impacts.Locations[index];
+		if (index < numberOfLocationsInHeatmap)
 		{
-			auto zDifference = abs((float)(z - zBracket));
-			auto zMagnitude = 0.5f / pow(2.0f, zDifference);
-
-			if (x >= 0 && z >= 0)
-			{
-				auto& newValue = _heatmapData[x][z];
-				newValue += (xMagnitude + zMagnitude);
-				if (newValue > _maximumValue)
-				{
-					_maximumValue = newValue;
-				}
-			}
+			_shotLocations.emplace_back(Vector(location.X, YDrawLocation - 10.0f, location.Z));
+		}
+		else
+		{
+			registerImpactLocation(location);
 		}
 	}
 }
@@ -155,11 +147,12 @@ void ShotDistributionTracker::renderShotLocations(CanvasWrapper& canvas)
 
 void ShotDistributionTracker::renderHeatMap(CanvasWrapper& canvas)
 {
+	const auto& heatmapData = _heatmap.getData();
 	for (auto x = 0; x < XBrackets; x++)
 	{
 		for (auto z = 0; z < ZBrackets; z++)
 		{
-			auto numberOfHitsInBracket = _heatmapData[x][z];
+			auto numberOfHitsInBracket = heatmapData[x][z];
 
 			// If there are zero hits, don't paint it
 			if (numberOfHitsInBracket > 0)
@@ -189,7 +182,7 @@ LinearColor ShotDistributionTracker::getHeatmapColor(float numberOfHitsInBracket
 	// 80% of max value: green + red (yellow)
 	// 100% of max value: pure red
 
-	auto percentageOfMaximum = numberOfHitsInBracket / _maximumValue;
+	auto percentageOfMaximum = numberOfHitsInBracket / _heatmap.getMaximumValue();
 
 	// Red: 0%-60% = 0, 80%-100% = 1
 	// Green: 0-20% = 0, 40-60% = 1, 80-100% = 0
@@ -5,6 +5,8 @@
 
 #include "../Core/AbstractEventReceiver.h"
 #include "../Core/IStatDisplay.h"
+#include "ImpactHeatmap.h"
+#include "../Data/StoredImpacts.h"
 
 #include <bakkesmod/wrappers/wrapperstructs.h>
 #include <bakkesmod/wrappers/GameWrapper.h>
@@ -38,9 +40,11 @@ public:
 
 	/** Increments the heat map entry at the shot location by 1 and slightly increments brackets around that location. */
 	void registerImpactLocation(Vector ballLocation);
+	/** Restores the impact locations of a stored session. The heatmap is taken over if it was stored, so only impacts which it does not contain have to be added. */
+	void restoreImpacts(const StoredImpacts& impacts);
 	
-	static const int XBrackets = 160; ///< Defines the number of brackets in X dimension. The number 8000 should be dividable by this number.
-	static const int ZBrackets = 80; ///< Defines the number of brackets in Z dimension. The number 4000 should be dividable by this number.
+	static const int XBrackets = ImpactHeatmap::XBrackets; ///< Defines the number of brackets in X dimension.
+	static const int ZBrackets = ImpactHeatmap::ZBrackets; ///< Defines the number of brackets in Z dimension.
 
 	/** Shows or hides the heat map. */
 	inline void setHeatMapVisible(bool visible) { _heatMapIsVisible = visible; }
@@ -48,9 +52,11 @@ public:
 	inline void setShotLocationsVisible(bool visible) { _shotLocationsAreVisible = visible; }
 
 	/** Retrieves the impact locations. */
-	inline std::vector<Vector> getImpactLocations() const { return _shotLocations; }
+	inline const std::vector<Vector>& getImpactLocations() const { return _shotLocations; }
 	/** Retrieves the heatmap data. */
-	inline std::array<std::array<float, ZBrackets>, XBrackets> getHeatmapData() const { return _heatmapData; }
+	inline std::array<std::array<float, ZBrackets>, XBrackets> getHeatmapData() const { return _heatmap.getData(); }
+	/** Retrieves the heatmap, e.g. for storing it along with the impact locations. */
+	inline const ImpactHeatmap& getHeatmap() const { return _heatmap; }
 
 private:
 	/** Draws the rectangle for the given cell. */
@@ -64,8 +70,7 @@ private:
 
 	std::shared_ptr<GameWrapper> _gameWrapper; ///< Used for retrieving the camera.
 
-	std::array<std::array<float, ZBrackets>, XBrackets> _heatmapData; ///< Stores the number of hits in each cell
-	float _maximumValue = 0; ///< The maximum value of all brackets
+	ImpactHeatmap _heatmap; ///< Stores the number of hits in each cell
 	bool _heatMapIsVisible = false; ///< Used for showing or hiding the heat map.
 
 	std::vector<Vector> _shotLocations; ///< Stores the locations of goals/bounces of the current training pack.
@@ -1,54 +1,87 @@
 #include <pch.h>
 #include "StatUpdater.h"
+#include "Percentage.h"
+#include "RollingWindowCalculator.h"
 
 StatUpdater::StatUpdater(
 	std::shared_ptr<ShotStats> shotStats,
 	std::shared_ptr<ShotStats> differenceStats,
 	std::shared_ptr<PluginState> pluginState,
 	std::shared_ptr<IStatReader> statReader,
-	std::shared_ptr<AllTimePeakHandler> peakHandler)
+	std::shared_ptr<AllTimePeakHandler> peakHandler,
+	std::shared_ptr<SessionPrefetchCache> prefetchCache,
+	std::shared_ptr<StatsSnapshotPublisher> snapshotPublisher)
 	: _externalShotStats(shotStats)
 	, _differenceStats(differenceStats)
 	, _pluginState(pluginState)
 	, _statReader(statReader)
 	, _peakHandler(peakHandler)
+	, _prefetchCache(prefetchCache)
+	, _snapshotPublisher(snapshotPublisher)
 {
 }
 
 void StatUpdater::processGoal()
 {
-	handleGoal(_internalShotStats.AllShotStats);
+	processOutcome(true, _pluginState->getBallSpeed());
+}
 
-	// Update per shot
-	// Check if CurrentRoundIndex has been set and if _statsDataPerShot has been initialized
-	if (0 <= _pluginState->CurrentRoundIndex && _pluginState->CurrentRoundIndex < _internalShotStats.PerShotStats.size())
+void StatUpdater::processMiss()
+{
+	processOutcome(false, .0f);
+}
+
+void StatUpdater::processOutcome(bool isGoal, float goalSpeed)
+{
+	auto record = _undoLog.getMostRecent();
+	if (!record || record->IsFinished)
 	{
-		auto&& currStatsData = _internalShotStats.PerShotStats.at(_pluginState->CurrentRoundIndex);
-		handleGoal(currStatsData);
+		// The start of the attempt was not recorded, e.g. because stats were reset during the attempt. Undoing it will only undo the outcome
+		record = &_undoLog.beginAttempt(_pluginState->CurrentRoundIndex);
+		storeStats(record->AllShotStatsAtStart, record->ShotStatsAtStart, record->ShotIndex);
 	}
+	storeStats(record->AllShotStatsBeforeOutcome, record->ShotStatsBeforeOutcome, record->ShotIndex);
+	record->IsFinished = true;
+	record->WasGoal = isGoal;
+	record->GoalSpeed = goalSpeed;
+	record->FlipResetOccurred = _flipResetOccurredInCurrentAttempt;
 
-	_statsHaveJustBeenRestored = false;
+	applyOutcome(*record);
 }
 
-void StatUpdater::processMiss()
+void StatUpdater::applyOutcome(const AttemptUndoRecord& record)
 {
-	handleMiss(_internalShotStats.AllShotStats);
+	auto shotStatsData = getShotStatsData(record.ShotIndex);
+	if (record.WasGoal)
+	{
+		handleGoal(_internalShotStats.AllShotStats, record.FlipResetOccurred);
+		if (shotStatsData)
+		{
+			handleGoal(*shotStatsData, record.FlipResetOccurred);
+		}
 
-	// Update per shot
-	// Check if CurrentRoundIndex has been set and if _statsDataPerShot has been initialized
-	if (0 <= _pluginState->CurrentRoundIndex && _pluginState->CurrentRoundIndex < _internalShotStats.PerShotStats.size())
+		// The goal speed values are only stored once per ShotStats object, so the external stats need to receive them as well, for storing them
+		_internalShotStats.insertGoalSpeed(record.ShotIndex, record.GoalSpeed);
+		_externalShotStats->insertGoalSpeed(record.ShotIndex, record.GoalSpeed);
+	}
+	else
 	{
-		auto&& currStatsData = _internalShotStats.PerShotStats.at(_pluginState->CurrentRoundIndex);
-		handleMiss(currStatsData);
+		handleMiss(_internalShotStats.AllShotStats);
+		if (shotStatsData)
+		{
+			handleMiss(*shotStatsData);
+		}
 	}
-
-	_statsHaveJustBeenRestored = false;
 }
 
 void StatUpdater::processAttempt()
 {
 	_flipResetOccurredInCurrentAttempt = false;
 
+	// Only the stats which are about to change are remembered, so this does not depend on the number of shots
+	auto& record = _undoLog.beginAttempt(_pluginState->CurrentRoundIndex);
+	storeStats(record.AllShotStatsAtStart, record.ShotStatsAtStart, record.ShotIndex);
+
 	_internalShotStats.AllShotStats.Stats.Attempts++;
 
 	// Update per shot
@@ -57,8 +90,6 @@ void StatUpdater::processAttempt()
 	{
 		_internalShotStats.PerShotStats.at(_pluginState->CurrentRoundIndex).Stats.Attempts++;
 	}
-
-	updateStatsBackup();
 }
 
 void StatUpdater::processInitialBallHit()
@@ -71,29 +102,25 @@ void StatUpdater::processInitialBallHit()
 	{
 		_internalShotStats.PerShotStats.at(_pluginState->CurrentRoundIndex).Stats.InitialHits++;
 	}
-
-	updateStatsBackup();
 }
 
 void StatUpdater::processReset(int numberOfShots)
 {
-	// Reset total stats
-	_internalShotStats.AllShotStats.Stats = PlayerStats();
-	_internalShotStats.AllShotStats.Data = CalculatedData();
+	// Reset total stats, per shot stats and goal speed values
+	_internalShotStats = ShotStats();
 	_flipResetOccurredInCurrentAttempt = false;
 
-	// Reset per shot stats
-	_internalShotStats.PerShotStats.clear();
 	for (auto index = 0; index < numberOfShots; index++)
 	{
 		_internalShotStats.PerShotStats.emplace_back();
 	}
+	configureRollingWindows(_internalShotStats);
 
 	// Replace the whole external object with our freshly reset copy
 	*_externalShotStats = _internalShotStats;
 
-	// Reset the stats backup (indirectly).
-	updateStatsBackup();
+	// Attempts of the previous stats can't be undone anymore
+	_undoLog.clear();
 
 	if (_peakHandler)
 	{
@@ -103,8 +130,11 @@ void StatUpdater::processReset(int numberOfShots)
 	_numberOfSessionsToBeSkipped = 0;
 	if (_differenceStats)
 	{
+		// Every shot has been reset, so the differences must not be updated incrementally until the compare base has been refreshed
+		*_differenceStats = retrieveSessionDiff();
 		updateCompareBase();
 	}
+	publishSnapshot();
 }
 
 void StatUpdater::updateData()
@@ -112,23 +142,45 @@ void StatUpdater::updateData()
 	// Note: This method relies on the state machine calling it at appropriate moments in time
 	//       We do not calculate everything every time, but rather specifically when the state machine deems it necessary.
 	//       As long as the state machine works correctly, it is enough to update only the current shot (and the summary object)
+	publishStats(_pluginState->CurrentRoundIndex);
+}
 
+void StatUpdater::publishStats(int shotIndex)
+{
 	_externalShotStats->AllShotStats = _internalShotStats.AllShotStats;
 	recalculatePercentages(_externalShotStats->AllShotStats, _internalShotStats.AllShotStats);
 
-	if (0 <= _pluginState->CurrentRoundIndex && _pluginState->CurrentRoundIndex < _internalShotStats.PerShotStats.size())
+	if (0 <= shotIndex && shotIndex < _internalShotStats.PerShotStats.size())
 	{
-		_externalShotStats->PerShotStats.at(_pluginState->CurrentRoundIndex) = _internalShotStats.PerShotStats.at(_pluginState->CurrentRoundIndex);
-		recalculatePercentages(_externalShotStats->PerShotStats.at(_pluginState->CurrentRoundIndex), _internalShotStats.PerShotStats.at(_pluginState->CurrentRoundIndex));
+		_externalShotStats->PerShotStats.at(shotIndex) = _internalShotStats.PerShotStats.at(shotIndex);
+		recalculatePercentages(_externalShotStats->PerShotStats.at(shotIndex), _internalShotStats.PerShotStats.at(shotIndex));
 	}
 
-	if (_differenceStats)
+	if (_differenceStats && !updateSessionDiff(shotIndex))
 	{
-		*_differenceStats = retrieveSessionDiff();
+		publishSnapshot(); // The differences of every shot have changed
+		return;
+	}
+	publishShotSnapshot(shotIndex);
+}
+
+void StatUpdater::publishSnapshot()
+{
+	if (_snapshotPublisher)
+	{
+		_snapshotPublisher->publish(*_externalShotStats, _differenceStats.get());
 	}
 }
 
-ShotStats getPreviousShotStats(std::shared_ptr<IStatReader> statReader, const std::string& trainingPackCode, bool statsAboutToBeRestored, const int numberOfSkips = 0)
+void StatUpdater::publishShotSnapshot(int shotIndex)
+{
+	if (_snapshotPublisher)
+	{
+		_snapshotPublisher->publishShot(*_externalShotStats, _differenceStats.get(), shotIndex);
+	}
+}
+
+ShotStats getPreviousShotStats(std::shared_ptr<IStatReader> statReader, const std::string& trainingPackCode, StatFieldMask fields, const int numberOfSkips = 0)
 {
 	if (trainingPackCode.empty()) { return {}; }
 
@@ -147,7 +199,7 @@ ShotStats getPreviousShotStats(std::shared_ptr<IStatReader> statReader, const st
 		}
 
 		// At this point, we have skipped enough files (if any) and have found a valid pack
-		return statReader->readStats(resourcePath, statsAboutToBeRestored);
+		return statReader->readStats(resourcePath, fields);
 	}
 
 	// At this point, no valid pack has been found, or too many packs have been skipped
@@ -156,26 +208,28 @@ ShotStats getPreviousShotStats(std::shared_ptr<IStatReader> statReader, const st
 
 void StatUpdater::restoreLastSession()
 {
-	auto stats = getPreviousShotStats(_statReader, _trainingPackCode, true);
+	// The restored stats must be in place before the next attempt gets counted, so this can't wait for a callback.
+	// The session has most likely been prefetched, though
+	auto stats = _prefetchCache ? _prefetchCache->restorePreviousSession(_trainingPackCode) : getPreviousShotStats(_statReader, _trainingPackCode, StatFieldMask::All);
 	if (!stats.hasAttempts())
 	{
 		return; // We couldn't restore the last session
 	}
 	// else: we successfully retrieved the previous session stats. Update our data structures with this information
 
-	_internalShotStats.AllShotStats = stats.AllShotStats;
-	_internalShotStats.PerShotStats = std::vector<StatsData>(stats.PerShotStats);
-	_externalShotStats->AllShotStats = stats.AllShotStats;
-	_externalShotStats->PerShotStats = std::vector<StatsData>(stats.PerShotStats);
+	// This includes the goal speed values, so goals of this session will be added to them
+	_internalShotStats = stats;
+	*_externalShotStats = std::move(stats);
 
+	// The session might have been stored with different windows, or with none at all in case of older files
+	configureRollingWindows(_internalShotStats);
 	recalculatePercentages(_externalShotStats->AllShotStats, _internalShotStats.AllShotStats);
 	for (auto index = 0; index < _externalShotStats->PerShotStats.size(); index++)
 	{
 		recalculatePercentages(_externalShotStats->PerShotStats[index], _internalShotStats.PerShotStats[index]);
 	}
-	// We successfully restored statistics from the last session. The "Toggle last attempt" feature must be disabled until a goal or a miss was recorded
-	// after restoring
-	_statsHaveJustBeenRestored = true;
+	// The attempts of the restored session were not recorded, so neither they nor anything before them can be undone or toggled
+	_undoLog.clear();
 	_numberOfSessionsToBeSkipped = 1;
 
 	// Since we restored the previous session, we must now compare against the one before that 
@@ -184,10 +238,36 @@ void StatUpdater::restoreLastSession()
 	{
 		updateCompareBase();
 	}
+	else if (_differenceStats)
+	{
+		// Every shot has changed, so updating the current one only would not be enough
+		*_differenceStats = retrieveSessionDiff();
+	}
+	publishSnapshot();
+}
+
+ShotStats readCompareBase(std::shared_ptr<IStatReader> statReader, const std::string& trainingPackCode, const int numberOfSessionsToBeSkipped)
+{
+	// Retrieve the previous shot stats, unless the current session had been restored from that file already,
+	// in which case we try retrieving the stats before that.
+	// Comparing only requires the statistics of the goal speed values rather than the values themselves
+	auto compareBase = getPreviousShotStats(statReader, trainingPackCode, StatFieldMask::DiffComparable, numberOfSessionsToBeSkipped);
+
+	if (numberOfSessionsToBeSkipped > 0 && !compareBase.hasAttempts())
+	{
+		// There seems to be at most one attempt with valid stats, and we skipped it
+		// => Try to fallback to use the session we restored from as a diff (better than nothing)
+		compareBase = getPreviousShotStats(statReader, trainingPackCode, StatFieldMask::DiffComparable, 0);
+	}
+	return compareBase;
 }
 
 void StatUpdater::updateCompareBase()
 {
+	// Any compare base which is still being loaded is outdated now.
+	// The differences to the previous compare base keep being displayed until the new one is available
+	auto requestNumber = ++_numberOfCompareBaseRequests;
+
 	if (_pluginState->StatsShallBeComparedToAllTimePeak)
 	{
 		if (!_peakHandler)
@@ -195,22 +275,47 @@ void StatUpdater::updateCompareBase()
 			return;
 		}
 
-		_compareBase = _peakHandler->getPeakStats();
+		_peakHandler->requestPeakStats([this, requestNumber](const ShotStats& peakStats) {
+			applyCompareBase(peakStats, requestNumber);
+		});
+	}
+	else if (_prefetchCache)
+	{
+		// Same as readCompareBase(), but the sessions are most likely in memory already
+		auto numberOfSessionsToBeSkipped = _numberOfSessionsToBeSkipped;
+		_prefetchCache->requestPreviousSession(_trainingPackCode, numberOfSessionsToBeSkipped, [this, requestNumber, numberOfSessionsToBeSkipped](const ShotStats& compareBase) {
+			if (numberOfSessionsToBeSkipped > 0 && !compareBase.hasAttempts())
+			{
+				_prefetchCache->requestPreviousSession(_trainingPackCode, 0, [this, requestNumber](const ShotStats& fallbackCompareBase) {
+					applyCompareBase(fallbackCompareBase, requestNumber);
+				});
+				return;
+			}
+			applyCompareBase(compareBase, requestNumber);
+		});
 	}
 	else
 	{
-		// Retrieve the previous shot stats, unless the current session had been restored from that file already,
-		// in which case we try retrieving the stats before that.
-		_compareBase = getPreviousShotStats(_statReader, _trainingPackCode, false, _numberOfSessionsToBeSkipped);
+		applyCompareBase(readCompareBase(_statReader, _trainingPackCode, _numberOfSessionsToBeSkipped), requestNumber);
+	}
+}
 
-		if (_numberOfSessionsToBeSkipped > 0 && !_compareBase.hasAttempts())
-		{
-			// There seems to be at most one attempt with valid stats, and we skipped it
-			// => Try to fallback to use the session we restored from as a diff (better than nothing)
-			_compareBase = getPreviousShotStats(_statReader, _trainingPackCode, false, 0);
-		}
+void StatUpdater::applyCompareBase(const ShotStats& compareBase, int requestNumber)
+{
+	if (requestNumber != _numberOfCompareBaseRequests)
+	{
+		return; // A different compare base was requested in the meantime
 	}
+
+	_compareBase = compareBase;
 	*_differenceStats = retrieveSessionDiff();
+	publishSnapshot();
+}
+
+void calculateDifferences(StatsData& difference, const StatsData& statsData, const StatsData& compareBase)
+{
+	difference.Data = statsData.Data.getDifferences(compareBase.Data);
+	difference.Stats = statsData.Stats.getDifferences(compareBase.Stats);
 }
 
 ShotStats StatUpdater::retrieveSessionDiff() const
@@ -231,27 +336,45 @@ ShotStats StatUpdater::retrieveSessionDiff() const
 	// At this point we have found a pack we can diff with. We abuse the ShotStats struct in order to store the differences in there
 	// since we basically need the same amount of stats.
 	ShotStats diffStats;
-	diffStats.AllShotStats.Data = _externalShotStats->AllShotStats.Data.getDifferences(_compareBase.AllShotStats.Data);
-	diffStats.AllShotStats.Stats = _externalShotStats->AllShotStats.Stats.getDifferences(_compareBase.AllShotStats.Stats);
+	calculateDifferences(diffStats.AllShotStats, _externalShotStats->AllShotStats, _compareBase.AllShotStats);
 	diffStats.AllShotStats.Stats.Attempts = 1;	// We set this so we can make use of ShotStats::hasAttempts() in order to check if this is a valid object
 												// (yeah, that's kinda hacky).
 	for (int index = 0; index < _compareBase.PerShotStats.size(); index++)
 	{
 		diffStats.PerShotStats.emplace_back();
-		diffStats.PerShotStats.back().Data = _externalShotStats->PerShotStats[index].Data.getDifferences(_compareBase.PerShotStats[index].Data);
-		diffStats.PerShotStats.back().Stats = _externalShotStats->PerShotStats[index].Stats.getDifferences(_compareBase.PerShotStats[index].Stats);
+		calculateDifferences(diffStats.PerShotStats.back(), _externalShotStats->PerShotStats[index], _compareBase.PerShotStats[index]);
 	}
 	return diffStats;
 }
 
-void StatUpdater::publishTrainingPackCode(const std::string& trainingPackCode)
+bool StatUpdater::updateSessionDiff(int shotIndex)
 {
-	_trainingPackCode = trainingPackCode;
+	if (!_differenceStats->hasAttempts() || _differenceStats->PerShotStats.size() != _externalShotStats->PerShotStats.size())
+	{
+		// There either is no compare base, or the differences do not match the current stats (yet). Either way, they need to be retrieved completely
+		*_differenceStats = retrieveSessionDiff();
+		return false;
+	}
+
+	// The differences of any other shot are still up to date
+	calculateDifferences(_differenceStats->AllShotStats, _externalShotStats->AllShotStats, _compareBase.AllShotStats);
+	_differenceStats->AllShotStats.Stats.Attempts = 1;
+	if (0 <= shotIndex && shotIndex < _differenceStats->PerShotStats.size())
+	{
+		calculateDifferences(_differenceStats->PerShotStats[shotIndex], _externalShotStats->PerShotStats[shotIndex], _compareBase.PerShotStats[shotIndex]);
+	}
+	return true;
 }
 
-double getPercentageValue(double attempts, double goals)
+void StatUpdater::publishTrainingPackCode(const std::string& trainingPackCode)
 {
-	return round((goals / attempts) * 10000.0) / 100.0;
+	_trainingPackCode = trainingPackCode;
+
+	// Previous sessions and peak stats will be required for resetting the stats, so start loading them as early as possible
+	if (_prefetchCache)
+	{
+		_prefetchCache->prefetch(trainingPackCode);
+	}
 }
 
 void StatUpdater::recalculatePercentages(StatsData& statsData, StatsData& internalStatsData)
@@ -267,17 +390,13 @@ void StatUpdater::recalculatePercentages(StatsData& statsData, StatsData& intern
 	internalStatsData.Data.SuccessPercentage = successPercentage;
 	internalStatsData.Data.InitialHitPercentage = initialHitPercentage;
 
-	// Update the percentage for the last 50 shots
-	// Ignore the event if this is a reset after a goal
-	while (internalStatsData.Stats.Last50Shots.size() > 50)
-	{
-		internalStatsData.Stats.Last50Shots.erase(internalStatsData.Stats.Last50Shots.begin());
-	}
+	// Update the percentage for the last 50 shots. The recent shots contain more than that, since they are shared with the rolling windows
 	successPercentage = .0;
-	if (!internalStatsData.Stats.Last50Shots.empty())
+	const auto& recentShots = internalStatsData.Stats.RecentShots;
+	if (!recentShots.empty())
 	{
-		auto numberOfGoals = std::count(internalStatsData.Stats.Last50Shots.begin(), internalStatsData.Stats.Last50Shots.end(), true);
-		successPercentage = getPercentageValue((double)internalStatsData.Stats.Last50Shots.size(), (double)numberOfGoals);
+		auto numberOfShots = std::min<size_t>(recentShots.size(), 50);
+		successPercentage = getPercentageValue((double)numberOfShots, (double)recentShots.numberOfGoalsInLast(numberOfShots));
 	}
 	internalStatsData.Data.Last50ShotsPercentage = successPercentage;
 
@@ -287,6 +406,7 @@ void StatUpdater::recalculatePercentages(StatsData& statsData, StatsData& intern
 		internalStatsData.Data.PeakSuccessPercentage = internalStatsData.Data.Last50ShotsPercentage;
 		internalStatsData.Data.PeakShotNumber = internalStatsData.Stats.Attempts;
 	}
+	RollingWindowCalculator::updatePercentages(internalStatsData);
 
 	// Update advanced stats
 	if (internalStatsData.Stats.Goals > 0)
@@ -304,9 +424,9 @@ void StatUpdater::recalculatePercentages(StatsData& statsData, StatsData& intern
 	statsData = internalStatsData;
 }
 
-void StatUpdater::handleGoal(StatsData& statsData)
+void StatUpdater::handleGoal(StatsData& statsData, bool flipResetOccurred)
 {
-	statsData.Stats.Last50Shots.push_back(true);
+	RollingWindowCalculator::addShot(statsData, true);
 	statsData.Stats.MissStreakCounter = 0;
 	statsData.Stats.GoalStreakCounter++;
 	statsData.Stats.Goals++;
@@ -316,9 +436,7 @@ void StatUpdater::handleGoal(StatsData& statsData)
 		statsData.Stats.LongestGoalStreak = statsData.Stats.GoalStreakCounter;
 	}
 
-	statsData.Stats.GoalSpeedStats()->insert(_pluginState->getBallSpeed());
-
-	if (_flipResetOccurredInCurrentAttempt)
+	if (flipResetOccurred)
 	{
 		statsData.Stats.FlipResetAttemptsScored++;
 	}
@@ -326,7 +444,7 @@ void StatUpdater::handleGoal(StatsData& statsData)
 
 void StatUpdater::handleMiss(StatsData& statsData)
 {
-	statsData.Stats.Last50Shots.push_back(false);
+	RollingWindowCalculator::addShot(statsData, false);
 	statsData.Stats.GoalStreakCounter = 0;
 	statsData.Stats.MissStreakCounter++;
 
@@ -336,41 +454,118 @@ void StatUpdater::handleMiss(StatsData& statsData)
 	}
 }
 
-void StatUpdater::updateStatsBackup()
+void StatUpdater::configureRollingWindows(ShotStats& shotStats) const
 {
-	_previousShotStats.AllShotStats = _internalShotStats.AllShotStats;
-	_previousShotStats.PerShotStats = std::vector<StatsData>(_internalShotStats.PerShotStats);
+	RollingWindowCalculator::configureWindows(shotStats.AllShotStats, _pluginState->RollingWindowSizes);
+	for (auto& statsData : shotStats.PerShotStats)
+	{
+		RollingWindowCalculator::configureWindows(statsData, _pluginState->RollingWindowSizes);
+	}
 }
 
-void StatUpdater::toggleLastAttempt()
+void StatUpdater::updateRollingWindows()
 {
-	if (!_internalShotStats.hasAttempts() || _internalShotStats.AllShotStats.Stats.Last50Shots.empty())
+	if (RollingWindowCalculator::hasWindowSizes(_internalShotStats.AllShotStats, _pluginState->RollingWindowSizes)) { return; }
+
+	// The stats of the undo log need the same windows, since undoing or toggling attempts continues from there
+	configureRollingWindows(_internalShotStats);
+	_undoLog.forEachStatsData([this](StatsData& statsData) {
+		RollingWindowCalculator::configureWindows(statsData, _pluginState->RollingWindowSizes);
+	});
+
+	_externalShotStats->AllShotStats = _internalShotStats.AllShotStats;
+	_externalShotStats->PerShotStats = std::vector<StatsData>(_internalShotStats.PerShotStats);
+	if (_differenceStats)
 	{
-		return; // can't toggle anything in this case
+		*_differenceStats = retrieveSessionDiff();
 	}
+	publishSnapshot();
+}
 
-	if (0 > _pluginState->CurrentRoundIndex || _pluginState->CurrentRoundIndex >= _internalShotStats.PerShotStats.size())
+StatsData* StatUpdater::getShotStatsData(int shotIndex)
+{
+	if (0 > shotIndex || shotIndex >= _internalShotStats.PerShotStats.size()) { return nullptr; }
+
+	return &_internalShotStats.PerShotStats[shotIndex];
+}
+
+void StatUpdater::storeStats(StatsData& allShotStats, StatsData& shotStats, int shotIndex)
+{
+	allShotStats = _internalShotStats.AllShotStats;
+	if (auto shotStatsData = getShotStatsData(shotIndex))
+	{
+		shotStats = *shotStatsData;
+	}
+}
+
+void StatUpdater::restoreStats(const StatsData& allShotStats, const StatsData& shotStats, int shotIndex)
+{
+	_internalShotStats.AllShotStats = allShotStats;
+	if (auto shotStatsData = getShotStatsData(shotIndex))
 	{
-		return; // something is wrong with the current round index, or we are not initialized
+		*shotStatsData = shotStats;
 	}
+}
 
-	if (_statsHaveJustBeenRestored)
+void StatUpdater::toggleLastAttempt()
+{
+	auto record = _undoLog.getMostRecent();
+	if (!record || !record->IsFinished)
 	{
-		return; // The user restored stats but didn't complete an attempt after that => there is no "last attempt" we could toggle
+		return; // There is no attempt to be toggled, or the current attempt has not been finished yet
 	}
 
-	bool lastShotWasAGoal = _internalShotStats.AllShotStats.Stats.Last50Shots.back() > 0;
-	_internalShotStats.AllShotStats = _previousShotStats.AllShotStats;
-	_internalShotStats.PerShotStats = std::vector<StatsData>(_previousShotStats.PerShotStats);
-	if (lastShotWasAGoal)
+	// Restoring the stats before the outcome keeps streaks and peaks correct
+	restoreStats(record->AllShotStatsBeforeOutcome, record->ShotStatsBeforeOutcome, record->ShotIndex);
+	if (record->WasGoal)
 	{
-		processMiss();
+		// The stats do not contain the goal speed values, so the speed of the goal needs to be removed separately
+		_internalShotStats.removeMostRecentGoalSpeed(record->ShotIndex);
+		_externalShotStats->removeMostRecentGoalSpeed(record->ShotIndex);
+		record->GoalSpeed = .0f;
 	}
 	else
 	{
-		processGoal();
+		record->GoalSpeed = _pluginState->getBallSpeed();
+	}
+	record->WasGoal = !record->WasGoal;
+	applyOutcome(*record);
+
+	// The user might have switched to a different shot in the meantime
+	publishStats(record->ShotIndex);
+}
+
+void StatUpdater::undoLastAttempt()
+{
+	auto record = _undoLog.getMostRecent();
+	if (!record || !record->IsFinished)
+	{
+		return; // The game will still report the outcome of the current attempt, so it can't be undone yet
+	}
+	_undoLog.undo();
+
+	storeStats(record->AllShotStatsAtUndo, record->ShotStatsAtUndo, record->ShotIndex);
+	if (record->WasGoal)
+	{
+		_internalShotStats.removeMostRecentGoalSpeed(record->ShotIndex);
+		_externalShotStats->removeMostRecentGoalSpeed(record->ShotIndex);
+	}
+	restoreStats(record->AllShotStatsAtStart, record->ShotStatsAtStart, record->ShotIndex);
+	publishStats(record->ShotIndex);
+}
+
+void StatUpdater::redoLastAttempt()
+{
+	auto record = _undoLog.redo();
+	if (!record) { return; }
+
+	restoreStats(record->AllShotStatsAtUndo, record->ShotStatsAtUndo, record->ShotIndex);
+	if (record->WasGoal)
+	{
+		_internalShotStats.insertGoalSpeed(record->ShotIndex, record->GoalSpeed);
+		_externalShotStats->insertGoalSpeed(record->ShotIndex, record->GoalSpeed);
 	}
-	updateData();
+	publishStats(record->ShotIndex);
 }
 
 void StatUpdater::processAirDribbleTime(float time)
@@ -385,7 +580,6 @@ void StatUpdater::processAirDribbleTime(float time)
 		handleAirDribbleTimeUpdate(currStatsData, time);
 	}
 
-	_statsHaveJustBeenRestored = false;
 }
 
 void StatUpdater::processAirDribbleTouches(int touches)
@@ -400,7 +594,6 @@ void StatUpdater::processAirDribbleTouches(int touches)
 		handleAirDribbleTouchesUpdate(currStatsData, touches);
 	}
 
-	_statsHaveJustBeenRestored = false;
 }
 
 void StatUpdater::processGroundDribbleTime(float time)
@@ -415,7 +608,6 @@ void StatUpdater::processGroundDribbleTime(float time)
 		handleGroundDribbleTimeUpdate(currStatsData, time);
 	}
 
-	_statsHaveJustBeenRestored = false;
 }
 
 void StatUpdater::processDoubleTapGoal()
@@ -430,7 +622,6 @@ void StatUpdater::processDoubleTapGoal()
 		handleDoubleTapGoalUpdate(currStatsData);
 	}
 
-	_statsHaveJustBeenRestored = false;
 }
 
 void StatUpdater::processFlipReset(int amount)
@@ -445,7 +636,6 @@ void StatUpdater::processFlipReset(int amount)
 		handleFlipResetUpdate(currStatsData, amount);
 	}
 
-	_statsHaveJustBeenRestored = false;
 }
 
 void StatUpdater::processCloseMiss()
@@ -460,7 +650,6 @@ void StatUpdater::processCloseMiss()
 		handleCloseMiss(currStatsData);
 	}
 
-	_statsHaveJustBeenRestored = false;
 }
 
 void StatUpdater::handleAirDribbleTimeUpdate(StatsData& statsData, float time)
@@ -8,7 +8,10 @@
 #include "../Core/IStatReader.h"
 #include "../Data/ShotStats.h"
 #include "../Data/PluginState.h"
+#include "../Data/StatsSnapshot.h"
 #include "AllTimePeakHandler.h"
+#include "AttemptUndoLog.h"
+#include "../Storage/SessionPrefetchCache.h"
 
 /** This class currently:
 	- updates statistics whenever they change
@@ -27,7 +30,9 @@ public:
 		std::shared_ptr<ShotStats> differenceStats,
 		std::shared_ptr<PluginState> pluginState,
 		std::shared_ptr<IStatReader> statReader,
-		std::shared_ptr<AllTimePeakHandler> peakHandler
+		std::shared_ptr<AllTimePeakHandler> peakHandler,
+		std::shared_ptr<SessionPrefetchCache> prefetchCache,
+		std::shared_ptr<StatsSnapshotPublisher> snapshotPublisher
 	);
 
 	// Inherited via IStatUpdater
@@ -41,6 +46,8 @@ public:
 
 	void publishTrainingPackCode(const std::string& trainingPackCode) override;
 	void toggleLastAttempt() override;
+	void undoLastAttempt() override;
+	void redoLastAttempt() override;
 
 	void processAirDribbleTime(float time) override;
 	void processAirDribbleTouches(int touches) override;
@@ -50,10 +57,15 @@ public:
 	void processCloseMiss() override;
 
 	void updateCompareBase() override;
+	void updateRollingWindows() override;
 
 private:
+	/** Records the outcome of the current attempt in the undo log and applies it. */
+	void processOutcome(bool isGoal, float goalSpeed);
+	/** Applies the goal or miss of the given attempt to the all shot stats and the stats of its shot. */
+	void applyOutcome(const AttemptUndoRecord& record);
 	/** Increases the goal counter and updates streaks. */
-	void handleGoal(StatsData& statsData);
+	void handleGoal(StatsData& statsData, bool flipResetOccurred);
 	/** Increases the miss counter and updates streaks. */
 	void handleMiss(StatsData& statsData);
 
@@ -66,14 +78,31 @@ private:
 
 	/** Updates percentage values. */
 	void recalculatePercentages(StatsData& statsData, StatsData& internalStatsData);
-	/** Updates the internal backup of stats. This is used for the "toggle last attempt" feature. */
-	void updateStatsBackup();
+	/** Applies the rolling window sizes of the plugin state to the all-shots and every per-shot stats object. */
+	void configureRollingWindows(ShotStats& shotStats) const;
+	/** Copies the all shot stats and the stats of the given shot to the external stats, and updates the session differences. */
+	void publishStats(int shotIndex);
+	/** Passes the external stats and the session differences to any reader outside of the game thread. */
+	void publishSnapshot();
+	/** Same as publishSnapshot(), but tells the readers that only the stats of all shots and of the given shot have changed. */
+	void publishShotSnapshot(int shotIndex);
+	/** Retrieves the internal stats of the given shot, or nullptr if the index is out of range. */
+	StatsData* getShotStatsData(int shotIndex);
+	/** Copies the internal all shot stats and the stats of the given shot into the given objects, e.g. for the undo log. */
+	void storeStats(StatsData& allShotStats, StatsData& shotStats, int shotIndex);
+	/** Replaces the internal all shot stats and the stats of the given shot by the given objects. */
+	void restoreStats(const StatsData& allShotStats, const StatsData& shotStats, int shotIndex);
 	/** Retrieves the differences between the current session and the previous one, or if stats had been restored from the previous session,
 	 * between the current one and the one before the previous one. */
 	ShotStats retrieveSessionDiff() const;
+	/** Updates the differences of the all shot stats and the given shot in place. The differences of all other shots must be up to date already.
+	 * Returns false if the differences of every shot had to be retrieved again instead.
+	 */
+	bool updateSessionDiff(int shotIndex);
+	/** Uses the given stats as compare base, unless a more recent compare base has been requested in the meantime. */
+	void applyCompareBase(const ShotStats& compareBase, int requestNumber);
 		
 	ShotStats _internalShotStats; ///< A cache of the current stats (we don't use calculated data here, though)
-	ShotStats _previousShotStats; ///< This is used in order to properly implement the "toggle last attempt" feature without messing up streaks/peaks
 	ShotStats _compareBase; ///< Session differences are compared to this object.
 	std::shared_ptr<ShotStats> _externalShotStats;	///< The current stats as seen by everything outside of this class.
 	std::shared_ptr<ShotStats> _differenceStats; ///< Stores the differences between the current and the previous session.
@@ -81,9 +110,12 @@ private:
 	std::shared_ptr<PluginState> _pluginState;	///< The current state of the plugin
 	std::shared_ptr<IStatReader> _statReader; ///< Used for restoring previous state
 	std::shared_ptr<AllTimePeakHandler> _peakHandler; ///< The handler for peak stats.
+	std::shared_ptr<SessionPrefetchCache> _prefetchCache; ///< Provides previous sessions, which are loaded in the background. May be nullptr, in which case they get read right away.
+	std::shared_ptr<StatsSnapshotPublisher> _snapshotPublisher; ///< Passes the stats to the render threads whenever they change. May be nullptr if nothing reads them.
+	int _numberOfCompareBaseRequests = 0; ///< Identifies the most recent request for a compare base, so compare bases which took longer to be loaded can be ignored.
 	std::string _trainingPackCode; ///< The code of the currently active training pack
+	AttemptUndoLog _undoLog; ///< Remembers the changes of the most recent attempts, for undoing, redoing and toggling them without messing up streaks/peaks
 
-	bool _statsHaveJustBeenRestored = false; ///< This prevents the "toggle last attempt" feature from being used after restoring the last session
 	bool _flipResetOccurredInCurrentAttempt = false; ///< This is required for detection of flip reset goals.
 
 	int _numberOfSessionsToBeSkipped = false; ///< Stores the number of sessions to be skipped when comparing to the previous session.
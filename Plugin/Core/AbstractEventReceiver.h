@@ -28,9 +28,18 @@ public:
 	/** This gets called whenever the user toggles the previous attempt between miss and goal. */
 	virtual void onTogglePreviousAttemptTriggered() { /* ignore event unless overridden. */ }
 
+	/** This gets called whenever the user undoes the most recent attempt. */
+	virtual void onUndoPreviousAttemptTriggered() { /* ignore event unless overridden. */ }
+
+	/** This gets called whenever the user redoes the most recently undone attempt. */
+	virtual void onRedoPreviousAttemptTriggered() { /* ignore event unless overridden. */ }
+
 	/** This gets called whenever the user toggles the option for comparing vs all time peak stats or the previous session. */
 	virtual void onCompareBaseToggled() { /* ignore event unless overridden. */ }
 
+	/** This gets called whenever the user changes the sizes of the rolling windows. */
+	virtual void onRollingWindowsChanged() { /* ignore event unless overridden. */ }
+
 	/** This gets called whenever the custom training mode gets loaded (also after reloading training, changing the pack etc). 
 	 * Note that this also gets called when the user leaves training, with an empty training pack code in that case.
 	 *
@@ -118,6 +118,9 @@ void CustomTrainingStateMachine::hookToEvents(const std::shared_ptr<GameWrapper>
 			processEventRoundChanged(trainingWrapper, eventReceivers);
 		}
 
+		// The session ends here => Store it in its final form before the stats get reset
+		_statWriter->compactStorage();
+
 		// Set the training pack code to empty so a click on "Restore" won't do anything
 		for (auto eventReceiver : eventReceivers)
 		{
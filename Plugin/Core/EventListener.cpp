@@ -53,6 +53,24 @@ void EventListener::registerUpdateEvents(std::shared_ptr<IStatUpdater> statUpdat
 		}
 	}, "Toggle the last attempt to be a goal or a miss", PERMISSION_ALL);
 
+	// Allow undoing and redoing the most recent attempts
+	_cvarManager->registerNotifier(TriggerNames::UndoLastAttempt, [this](const std::vector<std::string>&) {
+		if (!_gameWrapper->IsInCustomTraining()) { return; }
+
+		for (auto eventReceiver : _eventReceivers)
+		{
+			eventReceiver->onUndoPreviousAttemptTriggered();
+		}
+	}, "Undo the most recent attempt", PERMISSION_ALL);
+	_cvarManager->registerNotifier(TriggerNames::RedoLastAttempt, [this](const std::vector<std::string>&) {
+		if (!_gameWrapper->IsInCustomTraining()) { return; }
+
+		for (auto eventReceiver : _eventReceivers)
+		{
+			eventReceiver->onRedoPreviousAttemptTriggered();
+		}
+	}, "Redo the most recently undone attempt", PERMISSION_ALL);
+
 	_cvarManager->registerNotifier(TriggerNames::CompareBaseChanged, [this](const std::vector<std::string>&) {
 		if (!_gameWrapper->IsInCustomTraining()) { return; }
 
@@ -62,11 +80,23 @@ void EventListener::registerUpdateEvents(std::shared_ptr<IStatUpdater> statUpdat
 		}
 	}, "Toggle between comparing to peak stats or the previous session", PERMISSION_ALL);
 
+	_cvarManager->registerNotifier(TriggerNames::RollingWindowsChanged, [this](const std::vector<std::string>&) {
+		if (!_gameWrapper->IsInCustomTraining()) { return; }
+
+		for (auto eventReceiver : _eventReceivers)
+		{
+			eventReceiver->onRollingWindowsChanged();
+		}
+	}, "Apply changed rolling window sizes to the current statistics", PERMISSION_ALL);
+
 	// Happens when custom taining mode is loaded or restarted
 	_gameWrapper->HookEventWithCallerPost<ActorWrapper>("Function GameEvent_TrainingEditor_TA.WaitingToPlayTest.OnTrainingModeLoaded",
-		[this, statUpdater](ActorWrapper caller, void*, const std::string&) {
+		[this, statUpdater, statWriter](ActorWrapper caller, void*, const std::string&) {
 		// Note: we always need to process this event so the state machine is up to date
 
+		// A restart of the training pack ends the current session => Store it in its final form before the stats get reset
+		statWriter->compactStorage();
+
 		// Update the state machine with this event
 		if (TrainingEditorWrapper trainingWrapper(caller.memory_address);
 			!trainingWrapper.IsNull())
@@ -82,7 +112,7 @@ void EventListener::registerUpdateEvents(std::shared_ptr<IStatUpdater> statUpdat
 
 		// Reset other state variables
 		_pluginState->MenuStackSize = 0;
-		_pluginState->IsMetric = _gameWrapper->GetbMetric();
+		updateMetricSetting();
 	});
 
 	_gameWrapper->HookEvent("Function TAGame.CarComponent_Dodge_TA.EventActivateDodge",
@@ -106,7 +136,7 @@ void EventListener::registerUpdateEvents(std::shared_ptr<IStatUpdater> statUpdat
 		{
 			_pluginState->MenuStackSize--;
 		}
-		_pluginState->IsMetric = _gameWrapper->GetbMetric(); // Check for change of metric setting
+		updateMetricSetting(); // Check for change of metric setting
 	});
 }
 
@@ -141,6 +171,16 @@ void EventListener::registerRenderEvents(std::vector<std::shared_ptr<IStatDispla
 	});
 }
 
+void EventListener::updateMetricSetting()
+{
+	auto isMetric = _gameWrapper->GetbMetric();
+	if (isMetric != _pluginState->IsMetric)
+	{
+		_pluginState->IsMetric = isMetric;
+		_pluginState->SettingsVersion++;
+	}
+}
+
 void EventListener::registerGameStateEvents()
 {
 }
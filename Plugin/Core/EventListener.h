@@ -34,6 +34,8 @@ public:
 	void addEventReceiver(std::shared_ptr<AbstractEventReceiver> eventReceiver);
 	
 private:
+	/** Applies the unit setting of the game, in case it has changed. */
+	void updateMetricSetting();
 
 	std::shared_ptr<IStatReader> _statReader; ///< Allows reading statistics from previous sessions
 	std::shared_ptr<GameWrapper> _gameWrapper; ///< Provides access to anything related to Rocket League
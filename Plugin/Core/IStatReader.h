@@ -2,9 +2,13 @@
 
 #include "../DLLImportExport.h"
 #include "../Data/ShotStats.h"
+#include "StatFieldMask.h"
+#include "../Data/StoredImpacts.h"
 #include <string>
 #include <vector>
 
+#include <bakkesmod/wrappers/wrapperstructs.h>
+
 /** The public interface of classes which allow reading statistics, e.g. from the file system. */
 class GOALPERCENTAGECOUNTER_IMPORT_EXPORT IStatReader
 {
@@ -17,8 +21,8 @@ public:
 	/** Retrieves a list of available resource paths, ordered so the most recent one appears first in the vector. */
 	virtual std::vector<std::string> getAvailableResourcePaths(const std::string& trainingPackCode) = 0;
 
-	/** Reads stats from the given resource path. */
-	virtual ShotStats readStats(const std::string& resourcePath, bool statsAboutToBeRestored) = 0;
+	/** Reads stats from the given resource path. Fields which are not part of the mask may be skipped, which makes reading faster. */
+	virtual ShotStats readStats(const std::string& resourcePath, StatFieldMask fields) = 0;
 
 	/** Peeks into the number of attempts which are stored for the given resource path. */
 	virtual int peekAttemptAmount(const std::string& resourcePath) = 0;
@@ -28,4 +32,9 @@ public:
 	 * The returned object will have zero attempts if there are no peak stats for this training pack yet.
 	 */
 	virtual ShotStats readTrainingPackStatistics(const std::string& trainingPackCode) = 0;
+
+	/** Reads the impact locations which are stored for the given resource path, along with their heatmap if it was stored.
+	 * Unlike readStats(), this does not register them anywhere, so they can be read in advance and restored later on.
+	 */
+	virtual StoredImpacts readImpactLocations(const std::string& resourcePath) = 0;
 };
@@ -43,6 +43,12 @@ public:
 	 */
 	virtual void toggleLastAttempt() = 0;
 
+	/** Reverts the most recent attempt which has not been undone yet, including its goal speed. Multiple attempts can be undone in a row. Does nothing while an attempt is in progress. */
+	virtual void undoLastAttempt() = 0;
+
+	/** Reapplies the most recently undone attempt. Undone attempts can't be redone anymore once a new attempt has been started. */
+	virtual void redoLastAttempt() = 0;
+
 	/** Processes a new air dribble attempt time. */
 	virtual void processAirDribbleTime(float time) = 0;
 
@@ -63,4 +69,7 @@ public:
 
 	/** Updates the base for stat comparison. */
 	virtual void updateCompareBase() = 0;
+
+	/** Applies changed rolling window sizes to the current stats. Windows which are kept retain their peak. */
+	virtual void updateRollingWindows() = 0;
 };
\ No newline at end of file
@@ -26,6 +26,12 @@ public:
 	 */
 	virtual void writeData() = 0;
 
+	/** Brings the storage of the current session into its final, compact form. This gets called at the end of a session, e.g. when the training pack gets unloaded.
+	 *
+	 * Implementers may store intermediate results of writeData() in a cheaper but less compact way until this method is called.
+	 */
+	virtual void compactStorage() = 0;
+
 	/** Writes the given shot stats for the training pack as a whole. This could e.g. be all time peak stats. They are identified by the training pack code. */
 	virtual void writeTrainingPackStatistics(const ShotStats& shotStats, const std::string& trainingPackCode) = 0;
 };
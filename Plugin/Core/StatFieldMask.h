@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+/** Defines which parts of stored stats shall be read. Readers may skip anything which was not requested, which leaves it at its default value. */
+enum class StatFieldMask : uint32_t
+{
+	Summary = 1 << 0,				///< The stats of all shots combined.
+	PerShotStats = 1 << 1,			///< The stats of every single shot.
+	GoalSpeedStatistics = 1 << 2,	///< Min, max, median, mean and standard deviation of the goal speed, which is enough for comparing them.
+	GoalSpeedValues = 1 << 3,		///< Every single goal speed value, which is required for continuing the goal speed stats.
+	ImpactLocations = 1 << 4,		///< The impact locations, which get registered at the shot distribution tracker.
+	GoalSpeedSketch = 1 << 5,		///< Goal speed statistics in a bounded amount of memory, which can be merged with the ones of other sessions. Ignored if GoalSpeedValues are read.
+	Heatmap = 1 << 6,				///< The stored heatmap of the impact locations, so it does not have to be recreated from them. Ignored unless ImpactLocations are read.
+
+	SummaryOnly = Summary | GoalSpeedStatistics,							///< Just enough for displaying the stats of a whole session.
+	DiffComparable = Summary | PerShotStats | GoalSpeedStatistics,			///< Every field which is used when comparing the current session to another one.
+	All = Summary | PerShotStats | GoalSpeedValues | ImpactLocations | Heatmap,	///< Everything, which is required for restoring a session.
+	AllExceptImpactLocations = Summary | PerShotStats | GoalSpeedValues,	///< Everything except for the impact locations, which can be read separately.
+};
+
+inline StatFieldMask operator|(StatFieldMask left, StatFieldMask right)
+{
+	return (StatFieldMask)((uint32_t)left | (uint32_t)right);
+}
+
+/** Returns true if all of the given fields are part of the mask. */
+inline bool containsFields(StatFieldMask mask, StatFieldMask fields)
+{
+	return ((uint32_t)mask & (uint32_t)fields) == (uint32_t)fields;
+}
@@ -21,10 +21,22 @@ void StatUpdaterEventBridge::onTogglePreviousAttemptTriggered()
 {
 	_statUpdater->toggleLastAttempt();
 }
+void StatUpdaterEventBridge::onUndoPreviousAttemptTriggered()
+{
+	_statUpdater->undoLastAttempt();
+}
+void StatUpdaterEventBridge::onRedoPreviousAttemptTriggered()
+{
+	_statUpdater->redoLastAttempt();
+}
 void StatUpdaterEventBridge::onCompareBaseToggled()
 {
 	_statUpdater->updateCompareBase();
 }
+void StatUpdaterEventBridge::onRollingWindowsChanged()
+{
+	_statUpdater->updateRollingWindows();
+}
 void StatUpdaterEventBridge::onTrainingModeLoaded(TrainingEditorWrapper& trainingWrapper, TrainingEditorSaveDataWrapper* trainingData)
 {
 	(void)trainingWrapper;
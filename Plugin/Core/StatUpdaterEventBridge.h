@@ -17,7 +17,10 @@ public:
 	void onResetStatisticsTriggered() override;
 	void onRestorePreviousSessionTriggered() override;
 	void onTogglePreviousAttemptTriggered() override;
+	void onUndoPreviousAttemptTriggered() override;
+	void onRedoPreviousAttemptTriggered() override;
 	void onCompareBaseToggled() override;
+	void onRollingWindowsChanged() override;
 	void onTrainingModeLoaded(TrainingEditorWrapper& trainingWrapper, TrainingEditorSaveDataWrapper* trainingData) override;
 	void onRoundChanged(TrainingEditorWrapper& trainingWrapper) override;
 	void onAttemptStarted() override;
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <array>
+
+#include "RollingWindow.h"
+
 /**
 * Stores any kind of data which has been calculated based on the raw stats
 */
@@ -17,6 +21,7 @@ public:
 	double AverageFlipResetsPerAttempt = .0;	///< The average number of flip resets made during an attempt.
 	double FlipResetGoalPercentage = .0;		///< The percentage of attempts which included a flip reset and resulted in a goal, in relation to total goals.
 	double CloseMissPercentage = .0;			///< The percentage of attempts which almost resulted in a goal.
+	std::array<RollingWindow, RollingWindowDefs::MaxNumberOfWindows> RollingWindows{}; ///< The success rates over the most recent shots, in the configured window sizes. Unused windows come last.
 
 	/** Compares this object to other and returns the result as a new CalculatedData instance. 
 	 *  The resulting percentages will be positive if "this" is better than "other".
@@ -34,6 +39,21 @@ public:
 		diff.FlipResetGoalPercentage = FlipResetGoalPercentage - other.FlipResetGoalPercentage;
 		// We don't diff Close Miss percentage: The difference could go down by either scoring, or by missing the goal completely,
 		// so we can't tell if less close misses is better or worse
+
+		// Like the peak success percentage, only the peaks of rolling windows get compared, and only if the other stats tracked a window of the same size
+		for (size_t index = 0; index < RollingWindows.size(); index++)
+		{
+			const auto& window = RollingWindows[index];
+			for (const auto& otherWindow : other.RollingWindows)
+			{
+				if (window.Size > 0 && otherWindow.Size == window.Size)
+				{
+					diff.RollingWindows[index].Size = window.Size;
+					diff.RollingWindows[index].PeakPercentage = window.PeakPercentage - otherWindow.PeakPercentage;
+					break;
+				}
+			}
+		}
 		return diff;
 	}
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <pch.h>
 #include "GoalSpeed.h"
+#include "SketchedGoalSpeed.h"
 
 #include <algorithm>
 
@@ -8,7 +9,7 @@ void GoalSpeed::reset()
 	_mostRecentSpeed = _DEFAULT_VALUE;
 	_maxSpeed = _DEFAULT_VALUE;
 	_minSpeed = _DEFAULT_VALUE;
-	_medianSpeed.reset();
+	_sortedSpeeds.clear();
 	_meanSpeed.reset();
 	_allSpeedValues.clear();
 }
@@ -18,7 +19,7 @@ void GoalSpeed::insert(float speed, bool isMetric)
 	_allSpeedValues.emplace_back(speed);
 	float metricSpeed = convertSpeed(speed, isMetric);
 	_mostRecentSpeed = metricSpeed;
-	_medianSpeed.insert(metricSpeed);
+	_sortedSpeeds.insert(metricSpeed);
 	_meanSpeed.insert(metricSpeed);
 
 	// Should only be default value when there are 0 goals
@@ -34,6 +35,20 @@ void GoalSpeed::insert(float speed, bool isMetric)
 	}
 }
 
+void GoalSpeed::removeMostRecent()
+{
+	if (_allSpeedValues.empty()) { return; }
+
+	auto metricSpeed = _allSpeedValues.back();
+	_allSpeedValues.pop_back();
+	_sortedSpeeds.erase(metricSpeed);
+	_meanSpeed.remove(metricSpeed);
+
+	_mostRecentSpeed = _allSpeedValues.empty() ? _DEFAULT_VALUE : _allSpeedValues.back();
+	_maxSpeed = _sortedSpeeds.getMax();
+	_minSpeed = _sortedSpeeds.getMin();
+}
+
 float GoalSpeed::getMostRecent(bool isMetric) const
 {
 	if (_mostRecentSpeed == _DEFAULT_VALUE)
@@ -63,7 +78,12 @@ float GoalSpeed::getMin(bool isMetric) const
 
 float GoalSpeed::getMedian(bool isMetric) const
 {
-	return convertSpeed(_medianSpeed.getMedian(), isMetric);
+	return getPercentile(.5f, isMetric);
+}
+
+float GoalSpeed::getPercentile(float percentile, bool isMetric) const
+{
+	return convertSpeed(_sortedSpeeds.getPercentile(percentile), isMetric);
 }
 
 float GoalSpeed::getMean(bool isMetric) const
@@ -81,6 +101,15 @@ size_t GoalSpeed::getCount(bool isMetric) const
 	return convertSpeed(_meanSpeed.getCount(), isMetric);
 }
 
+void GoalSpeed::mergeInto(SketchedGoalSpeed& target) const
+{
+	// The values are stored as supplied to insert(), which is always in KPH
+	for (auto speed : _allSpeedValues)
+	{
+		target.insert(speed);
+	}
+}
+
 float GoalSpeed::convertSpeed(float metricSpeed, bool isMetric) const
 {
 	if (isMetric)
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "RunningMedian.h"
+#include "OrderStatisticTree.h"
 #include "RunningMean.h"
 #include "IGoalSpeedProvider.h"
 
@@ -15,14 +15,20 @@ public:
 
 	void reset() override;
 	void insert(float speed, bool isMetric = true) override;
+	/** Removes the most recently inserted goal speed, e.g. when an attempt was counted as a goal by mistake. */
+	void removeMostRecent();
 	float getMostRecent(bool isMetric = true) const override;
 	float getMax(bool isMetric = true) const override;
 	float getMin(bool isMetric = true) const override;
 	float getMedian(bool isMetric = true) const override;
+	float getPercentile(float percentile, bool isMetric = true) const override;
 	float getMean(bool isMetric = true) const override;
 	float getStdDev(bool isMetric = true) const override;
 	size_t getCount(bool isMetric = true) const override;
 	inline std::vector<float> getAllShotValues() const override { return _allSpeedValues; }
+	/** Provides the recorded shot values without copying them. */
+	inline const std::vector<float>& getValues() const { return _allSpeedValues; }
+	void mergeInto(SketchedGoalSpeed& target) const override;
 	
 private:
 	float convertSpeed(float metricSpeed, bool isMetric) const;
@@ -33,7 +39,7 @@ private:
 	float _mostRecentSpeed{ _DEFAULT_VALUE };	///< Most recent goal speed
 	float _maxSpeed{ _DEFAULT_VALUE };			///< Maximum goal speed
 	float _minSpeed{ _DEFAULT_VALUE };			///< Minimum goal speed
-	RunningMedian _medianSpeed;					///< Median goal speed
+	OrderStatisticTree _sortedSpeeds;			///< All goal speeds in sorted order, for the median and other percentiles
 	RunningMean _meanSpeed;						///< Mean goal speed
 	std::vector<float> _allSpeedValues;			///< Stores all goal speeds which have been recorded
 };
\ No newline at end of file
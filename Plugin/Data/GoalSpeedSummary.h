@@ -0,0 +1,34 @@
+#pragma once
+
+/** Stores the goal speed statistics of a session or a single shot in KPH, without the single goal speed values.
+ *
+ * This is a plain value, so stats can be copied without any allocation. The values themselves are stored in the goal speed arena of ShotStats.
+ */
+struct GoalSpeedSummary
+{
+	int Count = 0;			///< The number of goal speed values. Zero if only the statistics were read from a file.
+	float MostRecent = .0f;	///< The most recent goal speed.
+	float Min = .0f;		///< The minimum goal speed.
+	float Max = .0f;		///< The maximum goal speed.
+	float Median = .0f;		///< The median goal speed.
+	float Mean = .0f;		///< The mean goal speed.
+	float StdDev = .0f;		///< The sample standard deviation of the goal speed.
+
+	/** Returns the most recent goal speed in KPH if isMetric is true and MPH otherwise */
+	inline float getMostRecent(bool isMetric = true) const { return convertSpeed(MostRecent, isMetric); }
+	/** Returns the minimum goal speed in KPH if isMetric is true and MPH otherwise */
+	inline float getMin(bool isMetric = true) const { return convertSpeed(Min, isMetric); }
+	/** Returns the maximum goal speed in KPH if isMetric is true and MPH otherwise */
+	inline float getMax(bool isMetric = true) const { return convertSpeed(Max, isMetric); }
+	/** Returns the median goal speed in KPH if isMetric is true and MPH otherwise */
+	inline float getMedian(bool isMetric = true) const { return convertSpeed(Median, isMetric); }
+	/** Returns the mean goal speed in KPH if isMetric is true and MPH otherwise */
+	inline float getMean(bool isMetric = true) const { return convertSpeed(Mean, isMetric); }
+	/** Returns the standard deviation of the goal speed in KPH if isMetric is true and MPH otherwise */
+	inline float getStdDev(bool isMetric = true) const { return convertSpeed(StdDev, isMetric); }
+
+private:
+	static float constexpr _KPH_TO_MPH{ 0.6213711922f };	///< Multiply KPH by this constant to convert to MPH
+
+	static inline float convertSpeed(float metricSpeed, bool isMetric) { return isMetric ? metricSpeed : metricSpeed * _KPH_TO_MPH; }
+};
@@ -1,9 +1,12 @@
 #pragma once
 
 #include "../DLLImportExport.h"
+#include "GoalSpeedSummary.h"
 
 #include <vector>
 
+class SketchedGoalSpeed;
+
 /** Defines the interface for a class which provides goal speed statistics. It is an interface since some code paths need to fake these values. */
 class GOALPERCENTAGECOUNTER_IMPORT_EXPORT IGoalSpeedProvider
 {
@@ -25,6 +28,8 @@ public:
 	virtual float getMin(bool isMetric = true) const = 0;
 	/** Returns the median goal speed in KPH if isMetric is true and MPH otherwise */
 	virtual float getMedian(bool isMetric = true) const = 0;
+	/** Returns the given percentile (0.0 to 1.0, e.g. 0.9 for the 90th percentile) of all goal speeds in KPH if isMetric is true and MPH otherwise */
+	virtual float getPercentile(float percentile, bool isMetric = true) const = 0;
 	/** Returns the mean goal speed in KPH if isMetric is true and MPH otherwise */
 	virtual float getMean(bool isMetric = true) const = 0;
 	/** Returns the mean goal speed in KPH if isMetric is true and MPH otherwise */
@@ -33,4 +38,20 @@ public:
 	virtual size_t getCount(bool isMetric = true) const = 0;
 	/** Returns the recorded shot values as supplied to insert(). */
 	virtual std::vector<float> getAllShotValues() const = 0;
+	/** Adds the goal speeds of this provider to the given bounded statistics, e.g. for combining several sessions. */
+	virtual void mergeInto(SketchedGoalSpeed& target) const = 0;
+
+	/** Retrieves all statistics at once in KPH, for storing them along with the other stats. */
+	inline GoalSpeedSummary getSummary() const
+	{
+		GoalSpeedSummary summary;
+		summary.Count = (int)getCount();
+		summary.MostRecent = getMostRecent();
+		summary.Min = getMin();
+		summary.Max = getMax();
+		summary.Median = getMedian();
+		summary.Mean = getMean();
+		summary.StdDev = getStdDev();
+		return summary;
+	}
 };
\ No newline at end of file
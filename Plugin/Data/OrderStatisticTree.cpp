@@ -0,0 +1,211 @@
+#include <pch.h>
+#include "OrderStatisticTree.h"
+
+#include <cmath>
+
+void OrderStatisticTree::clear()
+{
+	_nodes.clear();
+	_freeNodes.clear();
+	_root = NoNode;
+}
+
+void OrderStatisticTree::insert(float value)
+{
+	if (find(value) != NoNode)
+	{
+		adjustMultiplicity(value, 1);
+		return;
+	}
+
+	// The node must be created before splitting, since creating it might reallocate the nodes
+	auto newNode = createNode(value);
+	auto [less, greater] = split(_root, value, false);
+	_root = merge(merge(less, newNode), greater);
+}
+
+bool OrderStatisticTree::erase(float value)
+{
+	auto node = find(value);
+	if (node == NoNode) { return false; }
+
+	if (_nodes[node].Multiplicity > 1)
+	{
+		adjustMultiplicity(value, -1);
+		return true;
+	}
+
+	// Cut the node out of the tree and join the remaining parts
+	auto [less, greaterOrEqual] = split(_root, value, false);
+	auto [equal, greater] = split(greaterOrEqual, value, true);
+	_freeNodes.push_back(equal);
+	_root = merge(less, greater);
+	return true;
+}
+
+float OrderStatisticTree::select(size_t rank) const
+{
+	auto node = _root;
+	while (node != NoNode)
+	{
+		const auto& current = _nodes[node];
+		auto leftCount = countOf(current.Left);
+		if (rank < leftCount)
+		{
+			node = current.Left;
+		}
+		else if (rank < (size_t)leftCount + current.Multiplicity)
+		{
+			return current.Value;
+		}
+		else
+		{
+			rank -= (size_t)leftCount + current.Multiplicity;
+			node = current.Right;
+		}
+	}
+	return .0f; // The rank is out of range
+}
+
+size_t OrderStatisticTree::countLessThan(float value) const
+{
+	size_t count = 0;
+	auto node = _root;
+	while (node != NoNode)
+	{
+		const auto& current = _nodes[node];
+		if (value <= current.Value)
+		{
+			node = current.Left;
+		}
+		else
+		{
+			count += (size_t)countOf(current.Left) + current.Multiplicity;
+			node = current.Right;
+		}
+	}
+	return count;
+}
+
+float OrderStatisticTree::getPercentile(double percentile) const
+{
+	if (empty()) { return .0f; }
+
+	percentile = std::min<double>(std::max<double>(percentile, .0), 1.0);
+	auto position = percentile * (double)(size() - 1);
+	auto lowerRank = (size_t)std::floor(position);
+	auto lowerValue = select(lowerRank);
+	auto fraction = position - (double)lowerRank;
+	if (fraction <= .0) { return lowerValue; }
+
+	auto upperValue = select(lowerRank + 1);
+	return (float)((double)lowerValue + fraction * ((double)upperValue - (double)lowerValue));
+}
+
+float OrderStatisticTree::getMin() const
+{
+	if (empty()) { return .0f; }
+
+	auto node = _root;
+	while (_nodes[node].Left != NoNode)
+	{
+		node = _nodes[node].Left;
+	}
+	return _nodes[node].Value;
+}
+
+float OrderStatisticTree::getMax() const
+{
+	if (empty()) { return .0f; }
+
+	auto node = _root;
+	while (_nodes[node].Right != NoNode)
+	{
+		node = _nodes[node].Right;
+	}
+	return _nodes[node].Value;
+}
+
+int32_t OrderStatisticTree::find(float value) const
+{
+	auto node = _root;
+	while (node != NoNode && _nodes[node].Value != value)
+	{
+		node = value < _nodes[node].Value ? _nodes[node].Left : _nodes[node].Right;
+	}
+	return node;
+}
+
+void OrderStatisticTree::adjustMultiplicity(float value, int32_t delta)
+{
+	auto node = _root;
+	while (node != NoNode)
+	{
+		auto& current = _nodes[node];
+		current.SubtreeCount += delta;
+		if (current.Value == value)
+		{
+			current.Multiplicity += delta;
+			return;
+		}
+		node = value < current.Value ? current.Left : current.Right;
+	}
+}
+
+std::pair<int32_t, int32_t> OrderStatisticTree::split(int32_t node, float value, bool inclusive)
+{
+	if (node == NoNode) { return { NoNode, NoNode }; }
+
+	auto& current = _nodes[node];
+	auto belongsToLeftTree = inclusive ? current.Value <= value : current.Value < value;
+	if (belongsToLeftTree)
+	{
+		auto [less, greater] = split(current.Right, value, inclusive);
+		_nodes[node].Right = less;
+		updateCount(node);
+		return { node, greater };
+	}
+	auto [less, greater] = split(current.Left, value, inclusive);
+	_nodes[node].Left = greater;
+	updateCount(node);
+	return { less, node };
+}
+
+int32_t OrderStatisticTree::merge(int32_t left, int32_t right)
+{
+	if (left == NoNode) { return right; }
+	if (right == NoNode) { return left; }
+
+	if (_nodes[left].Priority > _nodes[right].Priority)
+	{
+		_nodes[left].Right = merge(_nodes[left].Right, right);
+		updateCount(left);
+		return left;
+	}
+	_nodes[right].Left = merge(left, _nodes[right].Left);
+	updateCount(right);
+	return right;
+}
+
+int32_t OrderStatisticTree::createNode(float value)
+{
+	Node node{ value, nextPriority(), 1, 1, NoNode, NoNode };
+	if (!_freeNodes.empty())
+	{
+		auto index = _freeNodes.back();
+		_freeNodes.pop_back();
+		_nodes[index] = node;
+		return index;
+	}
+	_nodes.push_back(node);
+	return (int32_t)_nodes.size() - 1;
+}
+
+uint32_t OrderStatisticTree::nextPriority()
+{
+	// xorshift32
+	_randomState ^= _randomState << 13;
+	_randomState ^= _randomState >> 17;
+	_randomState ^= _randomState << 5;
+	return _randomState;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "../DLLImportExport.h"
+
+/** Stores float values in sorted order, so any value can be found by its rank, e.g. the median or the 90th percentile.
+ *
+ * This is a treap (a binary search tree which stays balanced through random node priorities), where every node stores how many values
+ * its subtree contains. Inserting, erasing and finding a value by rank all take O(log n) time. Equal values share a node, and values are
+ * stored exactly as they were inserted. Nodes are kept in a vector and reference each other by index, so copying the tree is a plain copy.
+ */
+class GOALPERCENTAGECOUNTER_IMPORT_EXPORT OrderStatisticTree
+{
+public:
+	OrderStatisticTree() = default;
+
+	/** Removes all values. */
+	void clear();
+	/** Adds a value. */
+	void insert(float value);
+	/** Removes one occurrence of the given value. Returns false if the value is not stored. */
+	bool erase(float value);
+
+	/** Retrieves the number of values, including duplicates. */
+	inline size_t size() const { return _root == NoNode ? 0 : _nodes[_root].SubtreeCount; }
+	/** Returns true if there are no values. */
+	inline bool empty() const { return _root == NoNode; }
+
+	/** Retrieves the value at the given rank, where rank 0 is the smallest value. Must not be called with a rank of size() or above. */
+	float select(size_t rank) const;
+	/** Retrieves the number of values which are less than the given value. */
+	size_t countLessThan(float value) const;
+
+	/** Retrieves the given percentile, where e.g. 0.25 is the first quartile and 0.5 the median.
+	 *
+	 * Values between two ranks are interpolated linearly, so the median of an even number of values is the mean of the two middle values.
+	 * Returns 0 if there are no values.
+	 */
+	float getPercentile(double percentile) const;
+	/** Retrieves the smallest value, or 0 if there are no values. */
+	float getMin() const;
+	/** Retrieves the largest value, or 0 if there are no values. */
+	float getMax() const;
+
+private:
+	static constexpr int32_t NoNode = -1;
+
+	struct Node
+	{
+		float Value;			///< The value of this node.
+		uint32_t Priority;		///< Parents always have a higher priority than their children.
+		uint32_t Multiplicity;	///< The number of times the value was inserted.
+		uint32_t SubtreeCount;	///< The number of values in this node and all of its children, including duplicates.
+		int32_t Left;			///< The index of the child with smaller values, or NoNode.
+		int32_t Right;			///< The index of the child with larger values, or NoNode.
+	};
+
+	inline uint32_t countOf(int32_t node) const { return node == NoNode ? 0 : _nodes[node].SubtreeCount; }
+	inline void updateCount(int32_t node) { _nodes[node].SubtreeCount = countOf(_nodes[node].Left) + _nodes[node].Multiplicity + countOf(_nodes[node].Right); }
+
+	/** Retrieves the node which stores the given value, or NoNode. */
+	int32_t find(float value) const;
+	/** Changes the multiplicity of the node with the given value and the subtree count of every node on the way to it. */
+	void adjustMultiplicity(float value, int32_t delta);
+	/** Splits the given subtree into a tree with the values less than the given value (or equal, if inclusive is set) and a tree with the rest. */
+	std::pair<int32_t, int32_t> split(int32_t node, float value, bool inclusive);
+	/** Merges two subtrees, where all values of the left tree must be smaller than the values of the right tree. Returns the new root. */
+	int32_t merge(int32_t left, int32_t right);
+	/** Creates a node for the given value, reusing the slot of an erased node if possible. */
+	int32_t createNode(float value);
+	/** Generates the priority for a new node. */
+	uint32_t nextPriority();
+
+	std::vector<Node> _nodes;			///< All nodes, including erased ones which are waiting to be reused.
+	std::vector<int32_t> _freeNodes;	///< The indices of erased nodes.
+	int32_t _root = NoNode;				///< The index of the root node.
+	uint32_t _randomState = 2463534242u;	///< The state of the xorshift generator for priorities. Fixed, so the tree shape is reproducible.
+};
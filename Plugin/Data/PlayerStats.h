@@ -1,9 +1,8 @@
 #pragma once
 
-#include <vector>
-#include <memory>
-#include "IGoalSpeedProvider.h"
-#include "GoalSpeed.h"
+#include "GoalSpeedSummary.h"
+#include "RecentShotWindow.h"
+#include "RollingWindow.h"
 
 /**
  * Stores differences of goal speed values.
@@ -19,7 +18,8 @@ public:
 };
 
 /**
-* Stores raw gathered data which does not involve calculation
+* Stores raw gathered data which does not involve calculation.
+* This is a plain value which can be copied without any allocation. The single goal speed values are stored in ShotStats.
 */
 class PlayerStats
 {
@@ -28,7 +28,7 @@ public:
 
 	int Attempts = 0;						///< Stores the number of attempts made
 	int Goals = 0;							///< Stores the number of goals shot
-	std::vector<bool> Last50Shots;			///< Stores the last 50 shots, where false means a miss and true means a goal
+	RecentShotWindow<RollingWindowDefs::MaxWindowSize> RecentShots; ///< Stores enough recent shots for the largest rolling window, where false means a miss and true means a goal
 	int GoalStreakCounter = 0;				///< Stores the amount of goals since the last miss
 	int MissStreakCounter = 0;				///< Stores the amount of misses since the last goal
 	int LongestGoalStreak = 0;				///< Stores the largest amount of consecutively scored goals
@@ -43,27 +43,18 @@ public:
 	int FlipResetAttemptsScored = 0;		///< Stores the number of attempts which included at least one flip reset and resulted in a goal
 	int CloseMisses = 0;					///< Stores the number of attempts which almost resulted in a goal.
 
-	inline void setGoalSpeedProvider(std::shared_ptr<IGoalSpeedProvider> provider) { _goalSpeedProvider = provider; } ///< Allows replacing the internal goal speed provider.
-
-	inline std::shared_ptr<IGoalSpeedProvider> GoalSpeedStats() const { return _goalSpeedProvider; } ///< Provides statistics about the goal speed
+	GoalSpeedSummary GoalSpeed;				///< Stores statistics about the goal speed. Updated by ShotStats whenever a goal speed gets added
 	GoalSpeedDiff GoalSpeedDifference;		///< This is not the best place for these kind of statistics, but it avoids heavy refactoring
 
-	// These are required for restoring goal speed values of the "all time peak stats". 
-	// This could be made less ugly by moving the GoalSpeedProvider completely out of this class, and have some other class update PlayerStats whenever goal speed values change.
-	float MinGoalSpeedFromFile = .0f;
-	float MaxGoalSpeedFromFile = .0f;
-	float MedianGoalSpeedFromFile = .0f;
-	float MeanGoalSpeedFromFile = .0f;
-
 	/** Compares the goal speed values of this object to other and returns the result as a GoalSpeedDiff instance. */
 	GoalSpeedDiff getGoalSpeedDifferences(const PlayerStats& other) const
 	{
 		GoalSpeedDiff diff;
-		diff.MinValue = _goalSpeedProvider->getMin() - other._goalSpeedProvider->getMin();
-		diff.MaxValue = _goalSpeedProvider->getMax() - other._goalSpeedProvider->getMax();
-		diff.MedianValue = _goalSpeedProvider->getMedian() - other._goalSpeedProvider->getMedian();
-		diff.MeanValue = _goalSpeedProvider->getMean() - other._goalSpeedProvider->getMean();
-		diff.StdDevValue = _goalSpeedProvider->getStdDev() - other._goalSpeedProvider->getStdDev();
+		diff.MinValue = GoalSpeed.Min - other.GoalSpeed.Min;
+		diff.MaxValue = GoalSpeed.Max - other.GoalSpeed.Max;
+		diff.MedianValue = GoalSpeed.Median - other.GoalSpeed.Median;
+		diff.MeanValue = GoalSpeed.Mean - other.GoalSpeed.Mean;
+		diff.StdDevValue = GoalSpeed.StdDev - other.GoalSpeed.StdDev;
 		return diff;
 	}
 
@@ -91,7 +82,4 @@ public:
 		// we don't compare close misses since a lower number could be better (more goals scored) or worse (missed the goal completely more often)
 		return diff;
 	}
-
-private:
-	std::shared_ptr<IGoalSpeedProvider> _goalSpeedProvider = std::make_shared<GoalSpeed>();
 };
\ No newline at end of file
@@ -2,6 +2,10 @@
 
 #include <bakkesmod/wrappers/wrapperstructs.h> // for LinearColor
 
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
 class DisplayOptions
 {
 public:
@@ -53,6 +57,9 @@ public:
 	bool CloseMissesShallBeDisplayed = false;			///< True while close misses shall appear in the stat display.
 	bool CloseMissPercentageShallBeDisplayed = false;	///< True while the percentage of close misses shall appear in the stat display.
 	bool PreviousSessionDiffShallBeDisplayed = true;	///< True while the percentage differences to the previous session shall appear.
+	bool RollingWindowsShallBeDisplayed = false;		///< True while the success rate and peak of every rolling window shall appear in the stat display.
+
+	std::vector<int> RollingWindowSizes = { 10, 25, 50, 100, 500 };	///< The number of shots in each rolling window, in display order.
 
 	/** True while initial ball hits and ball hit percentage shall appear in the stat display. 
 	 */
@@ -60,6 +67,7 @@ public:
 	int CurrentRoundIndex = -1;								///< The index of the current round, -1 when not initialized
 	int TotalRounds = -1;									///< The total number of rounds in the current training pack
 	int MenuStackSize = 0;									///< The total number of open menus (1 for the "Pause" Menu in custom training, 2 for "Settings" or "Change Mode/Match")
+	std::atomic<uint64_t> SettingsVersion{ 0 };				///< Increases whenever a setting changes, so anything derived from the settings knows when to be rebuilt. Atomic since it is read outside of the game thread
 
 	DisplayOptions AllShotsOpts{"All Shots Statistics", 5, 205, .8f, 1.6f, 1.2f }; ///< Stores the user-defined value for the overlay and text for all shots stats
 	DisplayOptions PerShotOpts{"Per Shot Statistics", 5, 520, .8f, 1.6f, 1.2f};  ///< Stores the user-defined value for the overlay and text for per round stats
@@ -0,0 +1,197 @@
+#include <pch.h>
+#include "QuantileSketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+QuantileSketch::QuantileSketch(uint32_t accuracy)
+	: _accuracy(std::max<uint32_t>(accuracy, 2))
+{
+}
+
+void QuantileSketch::clear()
+{
+	_count = 0;
+	_min = .0f;
+	_max = .0f;
+	_levels.clear();
+	_numberOfStoredValues = 0;
+	_totalCapacity = 0;
+	_promoteOddValues = false;
+}
+
+void QuantileSketch::insert(float value)
+{
+	if (_levels.empty())
+	{
+		addLevel();
+	}
+	_min = _count == 0 ? value : std::min<float>(_min, value);
+	_max = _count == 0 ? value : std::max<float>(_max, value);
+	_count++;
+
+	_levels[0].push_back(value);
+	_numberOfStoredValues++;
+	if (_numberOfStoredValues > _totalCapacity)
+	{
+		compress();
+	}
+}
+
+void QuantileSketch::merge(const QuantileSketch& other)
+{
+	if (other.empty()) { return; }
+	if (&other == this)
+	{
+		auto copy = other;
+		merge(copy);
+		return;
+	}
+
+	_min = _count == 0 ? other._min : std::min<float>(_min, other._min);
+	_max = _count == 0 ? other._max : std::max<float>(_max, other._max);
+	_count += other._count;
+
+	while (_levels.size() < other._levels.size())
+	{
+		addLevel();
+	}
+	for (size_t level = 0; level < other._levels.size(); level++)
+	{
+		_levels[level].insert(_levels[level].end(), other._levels[level].begin(), other._levels[level].end());
+	}
+	_numberOfStoredValues += other._numberOfStoredValues;
+	compress();
+}
+
+float QuantileSketch::getPercentile(double percentile) const
+{
+	if (empty()) { return .0f; }
+
+	percentile = std::min<double>(std::max<double>(percentile, .0), 1.0);
+	if (isExact())
+	{
+		// Every value is still available, so this works just like a sorted list of all values
+		auto values = _levels[0];
+		std::sort(values.begin(), values.end());
+		auto position = percentile * (double)(values.size() - 1);
+		auto lowerRank = (size_t)std::floor(position);
+		auto fraction = position - (double)lowerRank;
+		if (fraction <= .0) { return values[lowerRank]; }
+		return (float)((double)values[lowerRank] + fraction * ((double)values[lowerRank + 1] - (double)values[lowerRank]));
+	}
+
+	// The minimum and maximum are tracked separately, since compaction might have dropped them
+	if (percentile == .0) { return _min; }
+	if (percentile == 1.0) { return _max; }
+
+	std::vector<std::pair<float, uint64_t>> weightedValues;
+	weightedValues.reserve(_numberOfStoredValues);
+	for (size_t level = 0; level < _levels.size(); level++)
+	{
+		for (auto value : _levels[level])
+		{
+			weightedValues.emplace_back(value, (uint64_t)1 << level);
+		}
+	}
+	std::sort(weightedValues.begin(), weightedValues.end());
+
+	auto rank = percentile * (double)(_count - 1);
+	uint64_t cumulativeWeight = 0;
+	for (const auto& [value, weight] : weightedValues)
+	{
+		cumulativeWeight += weight;
+		if ((double)cumulativeWeight > rank)
+		{
+			return value;
+		}
+	}
+	return _max;
+}
+
+bool QuantileSketch::restore(uint64_t count, float min, float max, std::vector<std::vector<float>> levels)
+{
+	clear();
+
+	// Every value of a level represents 2^level inserted values, so the weights must add up to the count
+	if (levels.size() >= 64 || min > max) { return false; }
+	uint64_t totalWeight = 0;
+	size_t numberOfStoredValues = 0;
+	for (size_t level = 0; level < levels.size(); level++)
+	{
+		totalWeight += (uint64_t)levels[level].size() << level;
+		numberOfStoredValues += levels[level].size();
+	}
+	if (totalWeight != count) { return false; }
+	if (count == 0) { return true; }
+
+	_count = count;
+	_min = min;
+	_max = max;
+	for (size_t level = 0; level < levels.size(); level++)
+	{
+		addLevel();
+	}
+	_levels = std::move(levels);
+	_numberOfStoredValues = numberOfStoredValues;
+
+	// The sketch might have been stored with a different accuracy
+	compress();
+	return true;
+}
+
+uint32_t QuantileSketch::getCapacity(size_t level) const
+{
+	// The highest level has a capacity of _accuracy. Every level below has two thirds of the capacity of the level above, but at least 2
+	auto depth = _levels.size() - 1 - level;
+	return std::max<uint32_t>((uint32_t)std::ceil(_accuracy * std::pow(2.0 / 3.0, (double)depth)), 2);
+}
+
+void QuantileSketch::addLevel()
+{
+	_levels.emplace_back();
+	_totalCapacity = 0;
+	for (size_t level = 0; level < _levels.size(); level++)
+	{
+		_totalCapacity += getCapacity(level);
+	}
+}
+
+void QuantileSketch::compress()
+{
+	// As long as there are more values than the levels can hold, at least one level must exceed its capacity
+	while (_numberOfStoredValues > _totalCapacity)
+	{
+		for (size_t level = 0; level < _levels.size(); level++)
+		{
+			if (_levels[level].size() >= getCapacity(level))
+			{
+				compact(level);
+				break;
+			}
+		}
+	}
+}
+
+void QuantileSketch::compact(size_t level)
+{
+	if (level + 1 == _levels.size())
+	{
+		addLevel();
+	}
+	auto& values = _levels[level];
+	auto& nextLevel = _levels[level + 1];
+	std::sort(values.begin(), values.end());
+
+	// With an odd number of values, the smallest one stays at this level. Of every remaining pair, one value gets promoted with twice the weight
+	auto numberOfRemainingValues = values.size() % 2;
+	auto firstPromotedIndex = numberOfRemainingValues + (_promoteOddValues ? 1 : 0);
+	for (auto index = firstPromotedIndex; index < values.size(); index += 2)
+	{
+		nextLevel.push_back(values[index]);
+	}
+	_numberOfStoredValues -= (values.size() - numberOfRemainingValues) / 2;
+	values.resize(numberOfRemainingValues);
+	_promoteOddValues = !_promoteOddValues;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../DLLImportExport.h"
+
+/** Approximates the percentiles of an unbounded number of float values in a bounded amount of memory.
+ *
+ * This is a KLL sketch: Values are stored in levels, where every value of level h stands for 2^h inserted values. Whenever the levels
+ * exceed their capacity, the values of a level get sorted and every other value gets promoted to the next level. Lower levels have a
+ * smaller capacity than higher ones, so the sketch stores at most about three times the accuracy parameter, no matter how many values
+ * were inserted. Percentiles are exact as long as no values had to be promoted. Afterwards, the rank of a percentile is typically off
+ * by less than one percent of the number of values for the default accuracy.
+ *
+ * Sketches of different sessions can be merged, and the result is just as accurate as a sketch of all of their values.
+ * Compaction is deterministic, so the same values inserted in the same order always produce the same sketch.
+ */
+class GOALPERCENTAGECOUNTER_IMPORT_EXPORT QuantileSketch
+{
+public:
+	static constexpr uint32_t DefaultAccuracy = 200;
+
+	/** Creates an empty sketch. Higher accuracy values require more memory. */
+	explicit QuantileSketch(uint32_t accuracy = DefaultAccuracy);
+
+	/** Removes all values. */
+	void clear();
+	/** Adds a value. */
+	void insert(float value);
+	/** Adds all values of the other sketch. */
+	void merge(const QuantileSketch& other);
+
+	/** Retrieves the number of inserted values. */
+	inline uint64_t getCount() const { return _count; }
+	/** Returns true if no values were inserted. */
+	inline bool empty() const { return _count == 0; }
+	/** Returns true if every inserted value is still stored, in which case all percentiles are exact. */
+	inline bool isExact() const { return _levels.size() <= 1; }
+	/** Retrieves the smallest inserted value, or 0 if there are no values. */
+	inline float getMin() const { return _min; }
+	/** Retrieves the largest inserted value, or 0 if there are no values. */
+	inline float getMax() const { return _max; }
+
+	/** Retrieves the given percentile, where e.g. 0.25 is the first quartile and 0.5 the median. Returns 0 if there are no values.
+	 *
+	 * As long as the sketch is exact, values between two ranks are interpolated linearly, just like OrderStatisticTree::getPercentile() does.
+	 */
+	float getPercentile(double percentile) const;
+
+	/** Retrieves the stored values of each level, for serializing them. */
+	inline const std::vector<std::vector<float>>& getLevels() const { return _levels; }
+	/** Retrieves the number of values which are currently stored in all levels. */
+	inline size_t getNumberOfStoredValues() const { return _numberOfStoredValues; }
+
+	/** Replaces the content of this sketch by previously serialized values. Returns false, and leaves the sketch empty, if the values are inconsistent. */
+	bool restore(uint64_t count, float min, float max, std::vector<std::vector<float>> levels);
+
+private:
+	/** Retrieves the maximum number of values of the given level, for the current number of levels. */
+	uint32_t getCapacity(size_t level) const;
+	/** Adds an empty level on top of the existing ones and updates the capacity of all levels. */
+	void addLevel();
+	/** Promotes values until the levels do not exceed their capacity anymore. */
+	void compress();
+	/** Sorts the given level and promotes every other value to the next level. */
+	void compact(size_t level);
+
+	uint32_t _accuracy;						///< The capacity of the highest level. Lower levels have a smaller capacity.
+	uint64_t _count = 0;					///< The number of inserted values.
+	float _min = .0f;						///< The smallest inserted value.
+	float _max = .0f;						///< The largest inserted value.
+	std::vector<std::vector<float>> _levels;	///< The stored values of each level. A value of level h represents 2^h inserted values.
+	size_t _numberOfStoredValues = 0;		///< The number of values in all levels.
+	size_t _totalCapacity = 0;				///< The sum of the capacity of all levels. Values get promoted as soon as there are more values than this.
+	bool _promoteOddValues = false;			///< Alternates between promoting the values at even and odd positions, so compaction does not drift into one direction.
+};
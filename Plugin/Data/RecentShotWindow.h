@@ -0,0 +1,194 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+
+/**
+ * Stores the outcome of the most recent shots in a ring buffer of bits, where a set bit means a goal.
+ *
+ * Once the window is full, adding a shot replaces the oldest one. The number of goals is tracked while shots are added,
+ * so the success percentage of the window can be retrieved without counting. Shots are indexed from oldest to most recent.
+ */
+template<size_t Capacity>
+class RecentShotWindow
+{
+	static_assert(Capacity > 0, "The window must be able to hold at least one shot");
+
+public:
+	static constexpr size_t BitsPerWord = 64;											///< The number of shots in a packed word.
+	static constexpr size_t NumberOfWords = (Capacity + BitsPerWord - 1) / BitsPerWord;	///< The number of packed words a full window needs.
+
+	RecentShotWindow() = default;
+	/** Creates a window containing the given shots, oldest first. */
+	RecentShotWindow(std::initializer_list<bool> shots)
+	{
+		for (auto isGoal : shots)
+		{
+			push_back(isGoal);
+		}
+	}
+
+	/** Adds the outcome of a shot. The oldest shot gets dropped if the window is full already. */
+	void push_back(bool isGoal)
+	{
+		if (_size == Capacity)
+		{
+			if (getBit(_oldestPosition)) { _numberOfGoals--; }
+			setBit(_oldestPosition, isGoal);
+			_oldestPosition = (_oldestPosition + 1) % Capacity;
+		}
+		else
+		{
+			setBit((_oldestPosition + _size) % Capacity, isGoal);
+			_size++;
+		}
+
+		if (isGoal) { _numberOfGoals++; }
+	}
+
+	/** Removes all shots. */
+	void clear()
+	{
+		_bits.fill(0);
+		_oldestPosition = 0;
+		_size = 0;
+		_numberOfGoals = 0;
+	}
+
+	/** Retrieves the number of shots in the window. */
+	inline size_t size() const { return _size; }
+	/** Returns true if there are no shots in the window. */
+	inline bool empty() const { return _size == 0; }
+	/** Retrieves the maximum number of shots in the window. */
+	static constexpr size_t capacity() { return Capacity; }
+
+	/** Returns true if the shot at the given index was a goal, where index 0 is the oldest shot. */
+	inline bool operator[](size_t index) const { return getBit((_oldestPosition + index) % Capacity); }
+	/** Returns true if the most recent shot was a goal. Must not be called for an empty window. */
+	inline bool back() const { return (*this)[_size - 1]; }
+
+	/** Retrieves the number of goals in the window. */
+	inline size_t numberOfGoals() const { return _numberOfGoals; }
+
+	/** Retrieves the number of goals among the given number of most recent shots. */
+	size_t numberOfGoalsInLast(size_t numberOfShots) const
+	{
+		if (numberOfShots >= _size) { return _numberOfGoals; }
+
+		// The shots might wrap around the end of the buffer, in which case they are split into two ranges
+		auto firstPosition = _oldestPosition + _size - numberOfShots;
+		if (firstPosition >= Capacity)
+		{
+			return countGoals(firstPosition - Capacity, firstPosition - Capacity + numberOfShots);
+		}
+		auto endPosition = firstPosition + numberOfShots;
+		if (endPosition <= Capacity)
+		{
+			return countGoals(firstPosition, endPosition);
+		}
+		return countGoals(firstPosition, Capacity) + countGoals(0, endPosition - Capacity);
+	}
+
+	/** Converts the shots to a string, where '1' is a goal and '0' a miss, starting with the oldest shot. */
+	std::string toString() const
+	{
+		std::string result(_size, '0');
+		for (size_t index = 0; index < _size; index++)
+		{
+			if ((*this)[index]) { result[index] = '1'; }
+		}
+		return result;
+	}
+
+	/** Creates a window from a string as created by toString(). Any character other than '1' is treated as a miss. */
+	static RecentShotWindow fromString(std::string_view shots)
+	{
+		RecentShotWindow window;
+		for (auto character : shots)
+		{
+			window.push_back(character == '1');
+		}
+		return window;
+	}
+
+	/** Packs shots into a word for storing them, where bit n is the shot at index firstIndex + wordIndex * 64 + n. Bits beyond the last shot are zero.
+	 *
+	 * Unlike the internal buffer, this does not depend on where the ring buffer currently starts.
+	 */
+	uint64_t getPackedWord(size_t wordIndex, size_t firstIndex = 0) const
+	{
+		uint64_t word = 0;
+		auto beginIndex = firstIndex + wordIndex * BitsPerWord;
+		for (size_t bitIndex = 0; bitIndex < BitsPerWord && beginIndex + bitIndex < _size; bitIndex++)
+		{
+			if ((*this)[beginIndex + bitIndex])
+			{
+				word |= (uint64_t)1 << bitIndex;
+			}
+		}
+		return word;
+	}
+
+	/** Adds the given number of shots (at most 64) from a word which was created by getPackedWord(), starting with bit 0. */
+	void pushPackedWord(uint64_t word, size_t numberOfShots)
+	{
+		for (size_t bitIndex = 0; bitIndex < numberOfShots && bitIndex < BitsPerWord; bitIndex++)
+		{
+			push_back(((word >> bitIndex) & 1) != 0);
+		}
+	}
+
+	/** Returns true if both windows contain the same shots in the same order. */
+	bool operator==(const RecentShotWindow& other) const
+	{
+		if (_size != other._size || _numberOfGoals != other._numberOfGoals) { return false; }
+
+		for (size_t index = 0; index < _size; index++)
+		{
+			if ((*this)[index] != other[index]) { return false; }
+		}
+		return true;
+	}
+	inline bool operator!=(const RecentShotWindow& other) const { return !(*this == other); }
+
+private:
+	inline bool getBit(size_t position) const
+	{
+		return ((_bits[position / BitsPerWord] >> (position % BitsPerWord)) & 1) != 0;
+	}
+
+	inline void setBit(size_t position, bool value)
+	{
+		auto mask = (uint64_t)1 << (position % BitsPerWord);
+		auto& word = _bits[position / BitsPerWord];
+		word = value ? (word | mask) : (word & ~mask);
+	}
+
+	/** Counts the goals in the given range of buffer positions, one word at a time. */
+	size_t countGoals(size_t beginPosition, size_t endPosition) const
+	{
+		size_t numberOfGoals = 0;
+		while (beginPosition < endPosition)
+		{
+			auto bitIndex = beginPosition % BitsPerWord;
+			auto numberOfBits = BitsPerWord - bitIndex;
+			if (numberOfBits > endPosition - beginPosition)
+			{
+				numberOfBits = endPosition - beginPosition;
+			}
+			auto mask = numberOfBits == BitsPerWord ? ~(uint64_t)0 : (((uint64_t)1 << numberOfBits) - 1) << bitIndex;
+			numberOfGoals += std::bitset<BitsPerWord>(_bits[beginPosition / BitsPerWord] & mask).count();
+			beginPosition += numberOfBits;
+		}
+		return numberOfGoals;
+	}
+
+	std::array<uint64_t, NumberOfWords> _bits{};	///< The shots, where _oldestPosition is the bit position of the oldest one.
+	size_t _oldestPosition = 0;						///< The bit position of the oldest shot.
+	size_t _size = 0;								///< The number of shots in the window.
+	size_t _numberOfGoals = 0;						///< The number of set bits.
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Stores the success rate within a window over the most recent shots, e.g. the last 10 shots.
+ *
+ * This is trivially copyable on purpose, since it is part of CalculatedData, which gets written to the attempt journal as raw bytes.
+ */
+struct RollingWindow
+{
+	int32_t Size = 0;				///< The maximum number of shots in the window. Zero if the window is not in use.
+	int32_t Goals = 0;				///< The number of goals among the shots in the window. This gets updated with every shot rather than counted.
+	double Percentage = .0;			///< The percentage of goals among the shots in the window.
+	double PeakPercentage = .0;		///< The highest percentage the window has reached, once it contained enough shots.
+	int32_t PeakShotNumber = 0;		///< The attempt at which the peak occurred.
+};
+
+/** Defines the limits of rolling windows. */
+class RollingWindowDefs
+{
+public:
+	static constexpr int MaxWindowSize = 500;			///< The maximum number of shots in a single window. This many recent shots are kept for every StatsData.
+	static constexpr int MaxNumberOfWindows = 5;		///< The maximum number of windows which can be tracked at the same time.
+	static constexpr int MinAttemptsForPeak = 20;		///< Windows larger than this only track a peak after this many attempts, like the peak of the last 50 shots.
+};
@@ -1,7 +1,20 @@
 #include <pch.h>
+#include <algorithm>
 #include <cmath>
 #include "RunningMean.h"
 
+RunningMean::RunningMean(size_t count, float mean, float variance)
+	: _count(count)
+	, _mean(count > 0 ? mean : 0.0f)
+{
+	if (_count >= 2)
+	{
+		_variance = variance;
+		_populationVariance = variance * (_count - 1) / _count;
+		_stdDev = std::sqrt(_variance);
+	}
+}
+
 void RunningMean::reset()
 {
 	_count = 0;
@@ -27,6 +40,44 @@ void RunningMean::insert(float value)
 	}
 }
 
+void RunningMean::merge(const RunningMean& other)
+{
+	if (other._count == 0) { return; }
+	if (_count == 0)
+	{
+		*this = other;
+		return;
+	}
+
+	auto count = _count + other._count;
+	float delta = other._mean - _mean;
+	float M2 = (_populationVariance * _count) + (other._populationVariance * other._count) + (delta * delta * _count * other._count / count);
+	_mean += delta * other._count / count;
+	_count = count;
+	_populationVariance = M2 / _count;
+	_variance = M2 / (_count - 1);
+	_stdDev = std::sqrt(_variance);
+}
+
+void RunningMean::remove(float value)
+{
+	if (_count <= 1)
+	{
+		reset();
+		return;
+	}
+
+	float M2 = _populationVariance * _count;
+	float previousMean = (_mean * _count - value) / (_count - 1);
+	M2 -= (value - previousMean) * (value - _mean);
+	--_count;
+	_mean = previousMean;
+
+	_populationVariance = _count >= 2 ? std::max<float>(M2, .0f) / _count : 0.0f;
+	_variance = _count >= 2 ? std::max<float>(M2, .0f) / (_count - 1) : 0.0f;
+	_stdDev = std::sqrt(_variance);
+}
+
 float RunningMean::getMean() const
 {
 	return _mean;
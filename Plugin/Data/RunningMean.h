@@ -4,12 +4,19 @@ class RunningMean
 {
 public:
 	RunningMean() = default;
+	/** Restores a running mean from statistics which were calculated before, where variance is the sample variance. */
+	RunningMean(size_t count, float mean, float variance);
 
 	/** Resets the mean and count to 0 */
 	void reset();
 	/** New value is added to update the mean, variance, and standard deviation.
 	Algorithm details can be found at https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Welford's_online_algorithm */
 	void insert(float value);
+	/** Combines the values of the other running mean with this one, as if they had been inserted here.
+	Algorithm details can be found at https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Parallel_algorithm */
+	void merge(const RunningMean& other);
+	/** Removes a value which has been inserted before, by reverting the update of insert(). */
+	void remove(float value);
 	/** Returns the current mean */
 	float getMean() const;
 	/** Returns the current sample variance */
@@ -0,0 +1,68 @@
+#include <pch.h>
+#include "ShotStats.h"
+
+#include <algorithm>
+
+namespace
+{
+	size_t toArenaIndex(int shotIndex)
+	{
+		return shotIndex < 0 ? 0 : (size_t)shotIndex + 1;
+	}
+}
+
+void ShotStats::insertGoalSpeed(int shotIndex, float speed)
+{
+	getGoalSpeedValues(-1).insert(speed);
+	updateGoalSpeedSummary(-1);
+	if (shotIndex >= 0 && (size_t)shotIndex < PerShotStats.size())
+	{
+		getGoalSpeedValues(shotIndex).insert(speed);
+		updateGoalSpeedSummary(shotIndex);
+	}
+}
+
+void ShotStats::removeMostRecentGoalSpeed(int shotIndex)
+{
+	getGoalSpeedValues(-1).removeMostRecent();
+	updateGoalSpeedSummary(-1);
+	if (shotIndex >= 0 && (size_t)shotIndex < PerShotStats.size())
+	{
+		getGoalSpeedValues(shotIndex).removeMostRecent();
+		updateGoalSpeedSummary(shotIndex);
+	}
+}
+
+GoalSpeed& ShotStats::getGoalSpeedValues(int shotIndex)
+{
+	// The arena grows for all shots at once, so references to entries stay valid as long as no shots get added
+	auto arenaIndex = toArenaIndex(shotIndex);
+	if (_goalSpeedArena.size() <= arenaIndex)
+	{
+		_goalSpeedArena.resize(std::max<size_t>(arenaIndex, PerShotStats.size()) + 1);
+	}
+	return _goalSpeedArena[arenaIndex];
+}
+
+const GoalSpeed& ShotStats::getGoalSpeedValues(int shotIndex) const
+{
+	static const GoalSpeed NoValues;
+
+	auto arenaIndex = toArenaIndex(shotIndex);
+	return arenaIndex < _goalSpeedArena.size() ? _goalSpeedArena[arenaIndex] : NoValues;
+}
+
+void ShotStats::updateGoalSpeedSummary(int shotIndex)
+{
+	auto statsData = getStatsData(shotIndex);
+	if (statsData)
+	{
+		statsData->Stats.GoalSpeed = getGoalSpeedValues(shotIndex).getSummary();
+	}
+}
+
+StatsData* ShotStats::getStatsData(int shotIndex)
+{
+	if (shotIndex < 0) { return &AllShotStats; }
+	return (size_t)shotIndex < PerShotStats.size() ? &PerShotStats[shotIndex] : nullptr;
+}
@@ -3,14 +3,37 @@
 #include <vector>
 
 #include "StatsData.h"
+#include "GoalSpeed.h"
+#include "SketchedGoalSpeed.h"
 
-class ShotStats
+#include "../DLLImportExport.h"
+
+class GOALPERCENTAGECOUNTER_IMPORT_EXPORT ShotStats
 {
 public:
 	ShotStats() = default;
 
 	StatsData AllShotStats;								///< Statistics for all shots
 	std::vector<StatsData> PerShotStats;	///< Statistics for each shot individually
+	SketchedGoalSpeed GoalSpeedSketch;		///< Bounded goal speed statistics for all shots. Only filled when reading with StatFieldMask::GoalSpeedSketch.
 
 	inline bool hasAttempts() const { return AllShotStats.Stats.Attempts > 0; }
+
+	/** Adds a goal speed to the statistics of all shots and, if shotIndex is valid, of the given shot, and updates their goal speed summary. */
+	void insertGoalSpeed(int shotIndex, float speed);
+	/** Removes the most recent goal speed of all shots and, if shotIndex is valid, of the given shot, e.g. when a goal was toggled to a miss. */
+	void removeMostRecentGoalSpeed(int shotIndex);
+
+	/** Provides the goal speed values of the given shot, or of all shots if shotIndex is negative. The entries of all shots get created on demand. */
+	GoalSpeed& getGoalSpeedValues(int shotIndex);
+	/** Provides the goal speed values of the given shot, or of all shots if shotIndex is negative. Returns empty values if none were stored. */
+	const GoalSpeed& getGoalSpeedValues(int shotIndex) const;
+	/** Copies the statistics of the stored goal speed values into the goal speed summary of the given shot, or of all shots if shotIndex is negative. */
+	void updateGoalSpeedSummary(int shotIndex);
+
+private:
+	/** Retrieves the stats of the given shot, or of all shots if shotIndex is negative. Returns nullptr for shots which do not exist. */
+	StatsData* getStatsData(int shotIndex);
+
+	std::vector<GoalSpeed> _goalSpeedArena;	///< The goal speed values of all shots at index 0, and of shot n at index n + 1. Grows on demand, so adding shots does not allocate.
 };
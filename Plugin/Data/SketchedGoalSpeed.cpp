@@ -0,0 +1,92 @@
+#include <pch.h>
+#include "SketchedGoalSpeed.h"
+
+#include <utility>
+
+SketchedGoalSpeed::SketchedGoalSpeed(QuantileSketch sketch, RunningMean meanSpeed, float mostRecentSpeed)
+	: _mostRecentSpeed(mostRecentSpeed)
+	, _sketch(std::move(sketch))
+	, _meanSpeed(meanSpeed)
+{
+}
+
+void SketchedGoalSpeed::reset()
+{
+	_mostRecentSpeed = .0f;
+	_sketch.clear();
+	_meanSpeed.reset();
+}
+
+void SketchedGoalSpeed::insert(float speed, bool isMetric)
+{
+	float metricSpeed = isMetric ? speed : speed / _KPH_TO_MPH;
+	_mostRecentSpeed = metricSpeed;
+	_sketch.insert(metricSpeed);
+	_meanSpeed.insert(metricSpeed);
+}
+
+float SketchedGoalSpeed::getMostRecent(bool isMetric) const
+{
+	return convertSpeed(_mostRecentSpeed, isMetric);
+}
+
+float SketchedGoalSpeed::getMax(bool isMetric) const
+{
+	return convertSpeed(_sketch.getMax(), isMetric);
+}
+
+float SketchedGoalSpeed::getMin(bool isMetric) const
+{
+	return convertSpeed(_sketch.getMin(), isMetric);
+}
+
+float SketchedGoalSpeed::getMedian(bool isMetric) const
+{
+	return getPercentile(.5f, isMetric);
+}
+
+float SketchedGoalSpeed::getPercentile(float percentile, bool isMetric) const
+{
+	return convertSpeed(_sketch.getPercentile(percentile), isMetric);
+}
+
+float SketchedGoalSpeed::getMean(bool isMetric) const
+{
+	return convertSpeed(_meanSpeed.getMean(), isMetric);
+}
+
+float SketchedGoalSpeed::getStdDev(bool isMetric) const
+{
+	return convertSpeed(_meanSpeed.getStdDev(), isMetric);
+}
+
+size_t SketchedGoalSpeed::getCount(bool isMetric) const
+{
+	return (size_t)_sketch.getCount();
+}
+
+void SketchedGoalSpeed::mergeInto(SketchedGoalSpeed& target) const
+{
+	target.merge(*this);
+}
+
+void SketchedGoalSpeed::merge(const SketchedGoalSpeed& other)
+{
+	if (other._sketch.empty()) { return; }
+
+	_mostRecentSpeed = other._mostRecentSpeed;
+	_sketch.merge(other._sketch);
+	_meanSpeed.merge(other._meanSpeed);
+}
+
+float SketchedGoalSpeed::convertSpeed(float metricSpeed, bool isMetric) const
+{
+	if (isMetric)
+	{
+		return metricSpeed;
+	}
+	else
+	{
+		return metricSpeed * _KPH_TO_MPH;
+	}
+}
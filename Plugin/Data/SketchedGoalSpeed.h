@@ -0,0 +1,50 @@
+#pragma once
+
+#include "QuantileSketch.h"
+#include "RunningMean.h"
+#include "IGoalSpeedProvider.h"
+
+#include "../DLLImportExport.h"
+
+/** Provides goal speed statistics in a bounded amount of memory, for any number of goals, e.g. of all sessions of a training pack.
+ *
+ * Min, max, mean and standard deviation are exact. The median and other percentiles are approximated by a QuantileSketch once there are
+ * too many goals for storing all of them. The single goal speed values are not kept, so getAllShotValues() is not supported.
+ */
+class GOALPERCENTAGECOUNTER_IMPORT_EXPORT SketchedGoalSpeed : public IGoalSpeedProvider
+{
+public:
+	SketchedGoalSpeed() = default;
+	/** Restores goal speed statistics which were stored before. */
+	SketchedGoalSpeed(QuantileSketch sketch, RunningMean meanSpeed, float mostRecentSpeed);
+
+	void reset() override;
+	void insert(float speed, bool isMetric = true) override;
+	float getMostRecent(bool isMetric = true) const override;
+	float getMax(bool isMetric = true) const override;
+	float getMin(bool isMetric = true) const override;
+	float getMedian(bool isMetric = true) const override;
+	float getPercentile(float percentile, bool isMetric = true) const override;
+	float getMean(bool isMetric = true) const override;
+	float getStdDev(bool isMetric = true) const override;
+	size_t getCount(bool isMetric = true) const override;
+	inline std::vector<float> getAllShotValues() const override { return std::vector<float>(); } // Not supported
+	void mergeInto(SketchedGoalSpeed& target) const override;
+
+	/** Adds the goals of the other statistics to these ones. The most recent goal speed of the other statistics becomes the most recent one. */
+	void merge(const SketchedGoalSpeed& other);
+
+	/** Provides the percentile approximation in metric units, for serializing it. */
+	inline const QuantileSketch& getSketch() const { return _sketch; }
+	/** Provides the mean and variance in metric units, for serializing them. */
+	inline const RunningMean& getRunningMean() const { return _meanSpeed; }
+
+private:
+	float convertSpeed(float metricSpeed, bool isMetric) const;
+
+	static float constexpr _KPH_TO_MPH{ 0.6213711922f };	///< Multiply KPH by this constant to convert to MPH
+
+	float _mostRecentSpeed{ .0f };	///< Most recent goal speed
+	QuantileSketch _sketch;			///< Min, max and percentiles of all goal speeds
+	RunningMean _meanSpeed;			///< Mean goal speed
+};
@@ -3,6 +3,8 @@
 #include "PlayerStats.h"
 #include "CalculatedData.h"
 
+#include <type_traits>
+
 class StatsData
 {
 public:
@@ -16,3 +18,5 @@ public:
 	PlayerStats Stats;		///< Statistics about the player
 	CalculatedData Data;	///< Calculated data based on PlayerStats
 };
+
+static_assert(std::is_trivially_copyable_v<StatsData>, "StatsData must stay a plain value so stats can be copied without allocating");
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include <pch.h>
+#include "StatsSnapshot.h"
+
+std::shared_ptr<TripleBuffer<StatsSnapshot>> StatsSnapshotPublisher::addReader()
+{
+	_readerBuffers.push_back(std::make_shared<TripleBuffer<StatsSnapshot>>());
+	return _readerBuffers.back();
+}
+
+void copySnapshotData(StatsSnapshotData& snapshotData, const ShotStats& stats)
+{
+	// Assigning the vector keeps its capacity, so this does not allocate unless the number of shots increases
+	snapshotData.AllShotStats = stats.AllShotStats;
+	snapshotData.PerShotStats.assign(stats.PerShotStats.begin(), stats.PerShotStats.end());
+}
+
+void StatsSnapshotPublisher::publish(const ShotStats& stats, const ShotStats* differenceStats)
+{
+	_version++;
+	_shotVersions.assign(stats.PerShotStats.size(), _version);
+	publishToReaders(stats, differenceStats);
+}
+
+void StatsSnapshotPublisher::publishShot(const ShotStats& stats, const ShotStats* differenceStats, int shotIndex)
+{
+	_version++;
+	if (_shotVersions.size() != stats.PerShotStats.size())
+	{
+		// The number of shots only changes on a reset, which publishes every shot anyway. Nothing can be reused in that case
+		_shotVersions.assign(stats.PerShotStats.size(), _version);
+	}
+	else if (0 <= shotIndex && shotIndex < (int)_shotVersions.size())
+	{
+		_shotVersions[shotIndex] = _version;
+	}
+	publishToReaders(stats, differenceStats);
+}
+
+void StatsSnapshotPublisher::publishToReaders(const ShotStats& stats, const ShotStats* differenceStats)
+{
+	for (const auto& readerBuffer : _readerBuffers)
+	{
+		auto& snapshot = readerBuffer->getWriteBuffer();
+		snapshot.Version = _version;
+		snapshot.ShotVersions.assign(_shotVersions.begin(), _shotVersions.end());
+		copySnapshotData(snapshot.Stats, stats);
+		if (differenceStats)
+		{
+			copySnapshotData(snapshot.Differences, *differenceStats);
+		}
+		else
+		{
+			snapshot.Differences.AllShotStats = StatsData();
+			snapshot.Differences.PerShotStats.clear();
+		}
+		readerBuffer->publish();
+	}
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../DLLImportExport.h"
+#include "ShotStats.h"
+#include "StatsData.h"
+#include "TripleBuffer.h"
+
+/** The stats of all shots and of each shot, without any goal speed values. */
+struct StatsSnapshotData
+{
+	StatsData AllShotStats;					///< The stats of all shots.
+	std::vector<StatsData> PerShotStats;	///< The stats of each shot.
+
+	/** Returns true if at least one attempt has been made. */
+	inline bool hasAttempts() const { return AllShotStats.Stats.Attempts > 0; }
+};
+
+/** A consistent copy of the current stats and their differences to the compare base, for threads which must not access the stats directly. */
+struct StatsSnapshot
+{
+	uint64_t Version = 0;				///< Increases with every published snapshot. Zero means nothing has been published yet.
+	StatsSnapshotData Stats;			///< The current stats.
+	StatsSnapshotData Differences;		///< The differences between the current stats and the compare base. Has no attempts if there is no compare base.
+	std::vector<uint64_t> ShotVersions;	///< The version of the snapshot in which the stats or differences of each shot have changed last.
+};
+
+/** Provides every reader of stats, like the overlay or the summary window, with its own buffer of snapshots, and fills them whenever the stats change.
+ *
+ * Readers call readLatest() on their buffer once per frame and get the most recent snapshot without ever waiting for the game thread.
+ */
+class GOALPERCENTAGECOUNTER_IMPORT_EXPORT StatsSnapshotPublisher
+{
+public:
+	/** Creates a buffer for a new reader, which receives every snapshot published from now on. Must be called from the game thread. */
+	std::shared_ptr<TripleBuffer<StatsSnapshot>> addReader();
+
+	/** Copies the given stats into a new snapshot and passes it to every reader, assuming that every shot has changed. Must be called from the game thread. */
+	void publish(const ShotStats& stats, const ShotStats* differenceStats);
+	/** Same as publish(), but only the stats of all shots and the stats of the given shot have changed since the previous snapshot.
+	 * No single shot has changed if the index is out of range.
+	 */
+	void publishShot(const ShotStats& stats, const ShotStats* differenceStats, int shotIndex);
+
+	/** Retrieves the version of the most recently published snapshot. */
+	inline uint64_t getVersion() const { return _version; }
+
+private:
+	/** Passes a snapshot of the given stats with the current versions to every reader. */
+	void publishToReaders(const ShotStats& stats, const ShotStats* differenceStats);
+
+	std::vector<std::shared_ptr<TripleBuffer<StatsSnapshot>>> _readerBuffers;	///< The buffers of all readers.
+	uint64_t _version = 0;					///< The version of the most recently published snapshot.
+	std::vector<uint64_t> _shotVersions;	///< The version in which each shot has changed last.
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <bakkesmod/wrappers/wrapperstructs.h>
+
+#include "../Calculation/ImpactHeatmap.h"
+
+/** The impact locations of a session as they were read from storage, along with the heatmap which was stored for them. */
+struct StoredImpacts
+{
+	std::vector<Vector> Locations;						///< The impact locations in the order they happened.
+	std::shared_ptr<const ImpactHeatmap> Heatmap;		///< The heatmap of the first NumberOfLocationsInHeatmap locations. nullptr if it has to be recreated from the locations.
+	size_t NumberOfLocationsInHeatmap = 0;				///< Any location after these, e.g. from the journal, still has to be added to the heatmap.
+};
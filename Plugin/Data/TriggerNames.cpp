@@ -5,6 +5,9 @@
 const char* TriggerNames::ResetStatistics = "customtrainingstatistics_reset_statistics";
 const char* TriggerNames::RestoreStatistics = "customtrainingstatistics_restore_statistics";
 const char* TriggerNames::ToggleLastAttempt = "customtrainingstatistics_toggle_last_attempt";
+const char* TriggerNames::UndoLastAttempt = "customtrainingstatistics_undo_last_attempt";
+const char* TriggerNames::RedoLastAttempt = "customtrainingstatistics_redo_last_attempt";
 const char* TriggerNames::ToggleHeatmapDisplay = "customtrainingstatistics_toggle_heatmap";
 const char* TriggerNames::ToggleImpactLocationDisplay = "customtrainingstatistics_toggle_impact_location";
-const char* TriggerNames::CompareBaseChanged = "customtrainingstatistics_compare_base_changed";
\ No newline at end of file
+const char* TriggerNames::CompareBaseChanged = "customtrainingstatistics_compare_base_changed";
+const char* TriggerNames::RollingWindowsChanged = "customtrainingstatistics_rolling_windows_changed";
\ No newline at end of file
@@ -9,7 +9,10 @@ public:
 	static const char* ResetStatistics;
 	static const char* RestoreStatistics;
 	static const char* ToggleLastAttempt;
+	static const char* UndoLastAttempt;
+	static const char* RedoLastAttempt;
 	static const char* ToggleHeatmapDisplay;
 	static const char* ToggleImpactLocationDisplay;
 	static const char* CompareBaseChanged;
+	static const char* RollingWindowsChanged;
 };
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Passes values from one writer thread to one reader thread without locking either of them.
+ *
+ * There are three buffers: One which is being written, one which is being read, and one which holds the most recently published value.
+ * Publishing and reading swap the respective buffer with the published one, so neither side ever waits for the other, and the reader always sees a
+ * value which has been published completely. Values which get published while the reader does not read are skipped.
+ *
+ * The buffers get reused, so the writer should assign the whole value every time, which allows e.g. vectors to keep their capacity.
+ */
+template<typename T>
+class TripleBuffer
+{
+public:
+	/** Provides the buffer which the next published value shall be written to. Its content is outdated. Must only be called by the writer. */
+	T& getWriteBuffer() { return _buffers[_writeIndex]; }
+
+	/** Makes the content of the write buffer available to the reader. Must only be called by the writer. */
+	void publish()
+	{
+		auto previousIndex = _publishedIndex.exchange(_writeIndex | NewValueFlag, std::memory_order_acq_rel);
+		_writeIndex = previousIndex & IndexMask;
+	}
+
+	/** Provides the most recently published value. The reference stays valid until the next call. Must only be called by the reader. */
+	const T& readLatest()
+	{
+		if ((_publishedIndex.load(std::memory_order_relaxed) & NewValueFlag) != 0)
+		{
+			auto previousIndex = _publishedIndex.exchange(_readIndex, std::memory_order_acq_rel);
+			_readIndex = previousIndex & IndexMask;
+		}
+		return _buffers[_readIndex];
+	}
+
+private:
+	static constexpr uint8_t IndexMask = 0x3;
+	static constexpr uint8_t NewValueFlag = 0x4;
+
+	std::array<T, 3> _buffers;						///< The buffers which are owned by the writer, the reader, and the publishing mechanism, respectively.
+	std::atomic<uint8_t> _publishedIndex{ 1 };		///< The index of the published buffer. NewValueFlag is set until the reader picks it up.
+	uint8_t _writeIndex = 0;						///< The index of the buffer which is owned by the writer.
+	uint8_t _readIndex = 2;							///< The index of the buffer which is owned by the reader.
+};
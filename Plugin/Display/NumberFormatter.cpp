@@ -0,0 +1,61 @@
+#include <pch.h>
+#include "NumberFormatter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <locale>
+#include <stdexcept>
+
+// Asks the OS locale for its decimal separator. Falls back to '.' if the OS locale is not available
+char getSystemDecimalSeparator()
+{
+	try
+	{
+		return std::use_facet<std::numpunct<char>>(std::locale("")).decimal_point();
+	}
+	catch (const std::runtime_error&)
+	{
+		return '.';
+	}
+}
+
+NumberFormatter::NumberFormatter(char decimalSeparator)
+	: _decimalSeparator(decimalSeparator)
+{
+}
+
+const NumberFormatter& NumberFormatter::getSystemFormatter()
+{
+	static const NumberFormatter systemFormatter(getSystemDecimalSeparator());
+	return systemFormatter;
+}
+
+std::string NumberFormatter::formatFixed(double value, int precision) const
+{
+	// fmt does not depend on the global locale, so the separator just has to be replaced
+	auto text = fmt::format("{:.{}f}", value, std::max<int>(precision, 0));
+	if (_decimalSeparator != '.')
+	{
+		std::replace(text.begin(), text.end(), '.', _decimalSeparator);
+	}
+	return text;
+}
+
+FormattedDifference NumberFormatter::formatDifference(double value, int precision) const
+{
+	precision = std::max<int>(precision, 0);
+
+	// Round first so the sign and the color of the difference always match the digits which are displayed. This also turns -0.001 into 0
+	auto factor = std::pow(10.0, (double)precision);
+	auto roundedValue = std::round(value * factor) / factor;
+	if (roundedValue == .0)
+	{
+		roundedValue = .0; // Drops the sign of -0.0
+	}
+
+	FormattedDifference difference;
+	difference.Value = roundedValue;
+	difference.IsNegative = roundedValue < .0;
+	difference.Text = (difference.IsNegative ? "" : "+") + formatFixed(roundedValue, precision);
+	return difference;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+
+#include "../DLLImportExport.h"
+
+/** A number which has been formatted for being displayed as a difference, e.g. "+1.25". */
+struct FormattedDifference
+{
+	std::string Text;		///< The formatted number, always including its sign.
+	double Value = .0;		///< The number after rounding it to the displayed precision, so it matches Text.
+	bool IsNegative = false;	///< True if the displayed number is below zero. A rounded zero never counts as negative.
+};
+
+/** Formats numbers for being displayed, using the decimal separator of the OS locale (some regions, especially in europe write 3,47 instead of 3.47).
+ *
+ * The locale only gets queried when the formatter is created, so formatting neither reads nor changes the global locale.
+ */
+class GOALPERCENTAGECOUNTER_IMPORT_EXPORT NumberFormatter
+{
+public:
+	/** Creates a formatter which uses the given decimal separator. */
+	explicit NumberFormatter(char decimalSeparator = '.');
+
+	/** Retrieves a formatter for the number format of the OS. It gets created on first use. */
+	static const NumberFormatter& getSystemFormatter();
+
+	/** Converts e.g. 12.7531 into "12.75" for a precision of 2. */
+	std::string formatFixed(double value, int precision = 2) const;
+	/** Converts e.g. 1.2531 into "+1.25" and -3 into "-3", and provides the displayed number as well. */
+	FormattedDifference formatDifference(double value, int precision = 2) const;
+
+private:
+	char _decimalSeparator; ///< Replaces the '.' which fmt always uses.
+};
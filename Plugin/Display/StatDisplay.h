@@ -1,21 +1,40 @@
 #pragma once
 
-#include <optional>
-
 #include "../Core/IStatDisplay.h"
-#include "../Data/ShotStats.h"
 #include "../Data/StatsData.h"
+#include "../Data/StatsSnapshot.h"
 #include "../Data/PluginState.h"
 #include "../Settings/SettingsDefinition.h"
+#include "StatRowPlan.h"
 
-/** Defines parts of what shall be displyed in a single line in the stat display. */
-struct SingleStatStrings
+/** A single line of the stat display, including where and how it shall be drawn. */
+struct StatDisplayRow
 {
-public:
-	std::string Label;
-	std::string Value;
-	std::string Unit;
-	std::optional<std::string> DiffValue;	
+	SingleStatStrings Strings;
+	Vector2F LabelPosition{ .0f, .0f };
+	Vector2F ValuePosition{ .0f, .0f };
+	Vector2F UnitPosition{ .0f, .0f };
+	Vector2F DiffPosition{ .0f, .0f };
+	LinearColor DiffColor{ .0f, .0f, .0f, .0f };
+};
+
+/** Everything which is required for drawing one overlay. It only gets rebuilt when the stats, the settings, or the current shot change,
+ * so drawing an unchanged overlay does not need to format, allocate or lock anything.
+ */
+struct StatDisplayModel
+{
+	bool IsValid = false;				///< False until the model has been built for the first time.
+	uint64_t StatsVersion = 0;			///< The version of the snapshot the model was built from.
+	uint64_t SettingsVersion = 0;		///< The version of the plugin settings the model was built with.
+	uint64_t StatsOrderVersion = 0;		///< The version of the stat order the model was built with.
+	int RoundIndex = -1;				///< The shot the model was built for, or -1 for the stats of all shots.
+
+	Vector2F PanelPosition{ .0f, .0f };
+	Vector2F PanelSize{ .0f, .0f };
+	Vector2F TitlePosition{ .0f, .0f };
+	std::vector<StatDisplayRow> Rows;
+	bool BrandingShallBeDrawn = false;
+	Vector2F BrandingPosition{ .0f, .0f };
 };
 
 /** Implements a simple stat display which draws text on a half-transparent background frame (configurable). */
@@ -24,30 +43,27 @@ class StatDisplay : public IStatDisplay
 public:
 	/** Creates a new object which is able to display statistics to the user. */
 	StatDisplay(
-		const std::shared_ptr<const ShotStats> shotStats,
-		const std::shared_ptr<const ShotStats> diffStats,
+		const std::shared_ptr<TripleBuffer<StatsSnapshot>> snapshots,
 		const std::shared_ptr<const PluginState> pluginState
 	);
 
 	// Inherited via IStatDisplay
 	void renderOneFrame(CanvasWrapper& canvas) override;
 
-	/** Builds a list of stats to be rendered, based on the current plugin state.
-	 *
-	 * \param		statsData		the object providing the stats which can possibly be rendered. Intentional copy due to waiting for a mutex.
-	 * \returns		A list of SingleStatStrings, consisting of a label, value, and unit string. These will be displayed in three columns.
-	 */
-	static std::list<SingleStatStrings> GetStatsToBeRendered(StatsData statsData, const std::shared_ptr<const PluginState> pluginState, const StatsData* const diffData = nullptr);
-
 private:
-	void drawCenter(CanvasWrapper& canvas, const DisplayOptions& displayOpts, int rowNumber, const std::string& label) const;
-	void renderStatsData(CanvasWrapper& canvas, const DisplayOptions& opts, const StatsData& statsData, const StatsData* const diffData, bool brandingShallBeDrawn);
-	void renderAllShotStats(CanvasWrapper& canvas);
-	void renderPerShotStats(CanvasWrapper& canvas);
+	/** Rebuilds the given model, unless it has been built for the same stats, settings and shot already. */
+	void updateModel(StatDisplayModel& model, const StatsSnapshot& snapshot, int roundIndex) const;
+	/** Formats the given stats and calculates the geometry of the overlay. */
+	void buildModel(StatDisplayModel& model, const DisplayOptions& opts, const StatsData& statsData, const StatsData* const diffData, bool brandingShallBeDrawn) const;
+	/** Draws a previously built model. */
+	void drawModel(CanvasWrapper& canvas, const DisplayOptions& opts, const StatDisplayModel& model) const;
+	void renderAllShotStats(CanvasWrapper& canvas, const StatsSnapshot& snapshot);
+	void renderPerShotStats(CanvasWrapper& canvas, const StatsSnapshot& snapshot);
 
-	const std::shared_ptr<const ShotStats> _shotStats;		///< Statistics and data for shots taken in custom training.
-	const std::shared_ptr<const ShotStats> _diffStats;		///< The difference statistics with the previous session, if available.
+	const std::shared_ptr<TripleBuffer<StatsSnapshot>> _snapshots;	///< Provides the statistics for shots taken in custom training, and the differences with the previous session, if available.
 	const std::shared_ptr<const PluginState> _pluginState;	///< The state of the plugin.
-	float _displayWidth{ 230.0f };
+	StatRowPlan _rowPlan;				///< The stats to be displayed, in display order.
+	StatDisplayModel _allShotsModel;	///< The cached overlay of the stats of all shots.
+	StatDisplayModel _perShotModel;		///< The cached overlay of the stats of the current shot.
 };
 
@@ -0,0 +1,408 @@
+#include <pch.h>
+#include "StatRowPlan.h"
+#include "NumberFormatter.h"
+#include "../Settings/SettingsDefinition.h"
+
+// Converts e.g. 12.7531 into "12.75". It is recomended to do rounding before calling this
+std::string to_percentage_string(double value)
+{
+	return NumberFormatter::getSystemFormatter().formatFixed(value, 2);
+}
+
+std::string to_float_string(float value, int precision = 2)
+{
+	return NumberFormatter::getSystemFormatter().formatFixed(value, precision);
+}
+
+// Stores the formatted difference together with its value, so neither the overlay nor the summary have to parse it again
+void setDiffValue(SingleStatStrings& statStrings, double value, int precision)
+{
+	auto difference = NumberFormatter::getSystemFormatter().formatDifference(value, precision);
+	statStrings.DiffValue = std::move(difference.Text);
+	statStrings.DiffNumber = difference.Value;
+	statStrings.DiffIsNegative = difference.IsNegative;
+}
+
+void set_diff_percentage(SingleStatStrings& statStrings, double value)
+{
+	setDiffValue(statStrings, value, 2);
+}
+
+void set_diff_value(SingleStatStrings& statStrings, int value)
+{
+	setDiffValue(statStrings, (double)value, 0);
+}
+void set_diff_value(SingleStatStrings& statStrings, float value)
+{
+	setDiffValue(statStrings, (double)value, 2);
+}
+
+void addAttempts(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Attempts:", std::to_string(statsData.Stats.Attempts), "" });
+}
+void addGoals(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Goals:", std::to_string(statsData.Stats.Goals), "" });
+}
+void addInitialBallHits(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Initial Hits:", std::to_string(statsData.Stats.InitialHits), "" });
+}
+void addCurrentGoalStreak(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Current Goal Streak:", std::to_string(statsData.Stats.GoalStreakCounter), "" });
+}
+void addCurrentMissStreak(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Current Miss Streak:", std::to_string(statsData.Stats.MissStreakCounter), "" });
+}
+void addLongestGoalStreak(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Longest Goal Streak:", std::to_string(statsData.Stats.LongestGoalStreak), "" });
+	if (diffData)
+	{
+		set_diff_value(statList.back(), diffData->Stats.LongestGoalStreak);
+	}
+}
+void addLongestMissStreak(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Longest Miss Streak:", std::to_string(statsData.Stats.LongestMissStreak), "" });
+	if (diffData)
+	{
+		set_diff_value(statList.back(), diffData->Stats.LongestMissStreak);
+	}
+}
+void addAirDribbleTouches(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Max. Air Dribbles:", std::to_string(statsData.Stats.MaxAirDribbleTouches), "" });
+	if (diffData)
+	{
+		set_diff_value(statList.back(), diffData->Stats.MaxAirDribbleTouches);
+	}
+}
+void addAirDribbleTime(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Max. ADribble Time:", to_float_string(statsData.Stats.MaxAirDribbleTime), "" });
+	if (diffData)
+	{
+		set_diff_value(statList.back(), diffData->Stats.MaxAirDribbleTime);
+	}
+}
+void addGroundDribbleTime(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Max. GDribble Time:", to_float_string(statsData.Stats.MaxGroundDribbleTime), "" });
+	if (diffData)
+	{
+		set_diff_value(statList.back(), diffData->Stats.MaxGroundDribbleTime);
+	}
+}
+void addTotalFlipResets(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Total Flip Resets:", std::to_string(statsData.Stats.TotalFlipResets), "" });
+}
+void addMaxFlipResets(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Max. GDribble Time:", to_float_string(statsData.Stats.MaxGroundDribbleTime), "" });
+	if (diffData)
+	{
+		set_diff_value(statList.back(), diffData->Stats.MaxGroundDribbleTime);
+	}
+}
+void addDoubleTapGoals(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Double Tap Goals:", std::to_string(statsData.Stats.DoubleTapGoals), "" });
+	if (diffData)
+	{
+		set_diff_value(statList.back(), diffData->Stats.DoubleTapGoals);
+	}
+}
+void addCloseMisses(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Close Misses:", std::to_string(statsData.Stats.CloseMisses), "" });
+}
+void addTotalSuccessRate(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Total Success Rate:", to_percentage_string(statsData.Data.SuccessPercentage), "%" });
+	if (diffData)
+	{
+		set_diff_percentage(statList.back(), diffData->Data.SuccessPercentage);
+	}
+}
+void addInitialHitRate(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Initial Hit Rate:", to_percentage_string(statsData.Data.InitialHitPercentage), "%" });
+	if (diffData)
+	{
+		set_diff_percentage(statList.back(), diffData->Data.InitialHitPercentage);
+	}
+}
+void addLastNShotPercentage(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Last 50 Shots", to_percentage_string(statsData.Data.Last50ShotsPercentage), "%" });
+}
+void addPeakSuccessRate(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Peak Success Rate:", to_percentage_string(statsData.Data.PeakSuccessPercentage), "%" });
+	if (diffData)
+	{
+		set_diff_percentage(statList.back(), diffData->Data.PeakSuccessPercentage);
+	}
+}
+void addPeakAtShotNumber(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Peak At Shot#:", std::to_string(statsData.Data.PeakShotNumber), "" });
+}
+
+void addLatestGoalSpeed(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Latest Goal Speed:", to_float_string(statsData.Stats.GoalSpeed.getMostRecent(options.IsMetric)), options.SpeedUnits });
+}
+void addMinimumGoalSpeed(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Min Goal Speed:", to_float_string(statsData.Stats.GoalSpeed.getMin(options.IsMetric)), options.SpeedUnits });
+	if (diffData)
+	{
+		set_diff_value(statList.back(), diffData->Stats.GoalSpeedDifference.MinValue);
+	}
+}
+void addMedianGoalSpeed(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Median Goal Speed:", to_float_string(statsData.Stats.GoalSpeed.getMedian(options.IsMetric)), options.SpeedUnits });
+	if (diffData)
+	{
+		set_diff_value(statList.back(), diffData->Stats.GoalSpeedDifference.MedianValue);
+	}
+}
+void addMaximumGoalSpeed(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Max Goal Speed:", to_float_string(statsData.Stats.GoalSpeed.getMax(options.IsMetric)), options.SpeedUnits });
+	if (diffData)
+	{
+		set_diff_value(statList.back(), diffData->Stats.GoalSpeedDifference.MaxValue);
+	}
+}
+void addMeanGoalSpeed(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Mean Goal Speed:", to_float_string(statsData.Stats.GoalSpeed.getMean(options.IsMetric)), options.SpeedUnits });
+	if (diffData)
+	{
+		set_diff_value(statList.back(), diffData->Stats.GoalSpeedDifference.MeanValue);
+	}
+}
+void addStdDevGoalSpeed(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Std Dev Goal Speed:", to_float_string(statsData.Stats.GoalSpeed.getStdDev(options.IsMetric)), options.SpeedUnits });
+}
+void addFlipResetsPerAttempt(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "FResets/Attempt:", to_percentage_string(statsData.Data.AverageFlipResetsPerAttempt), "%" });
+	if (diffData)
+	{
+		set_diff_percentage(statList.back(), diffData->Data.AverageFlipResetsPerAttempt);
+	}
+}
+void addFlipResetPercentage(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "FReset Goal Rate:", to_percentage_string(statsData.Data.FlipResetGoalPercentage), "%" });
+	if (diffData)
+	{
+		set_diff_percentage(statList.back(), diffData->Data.FlipResetGoalPercentage);
+	}
+}
+void addDoubleTapPercentage(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Dbl Tap Goal Rate:", to_percentage_string(statsData.Data.DoubleTapGoalPercentage), "%" });
+	if (diffData)
+	{
+		set_diff_percentage(statList.back(), diffData->Data.DoubleTapGoalPercentage);
+	}
+}
+void addCloseMissRate(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	statList.emplace_back(SingleStatStrings{ "Close Miss Rate:", to_percentage_string(statsData.Data.CloseMissPercentage), "%" });
+}
+void addRollingWindows(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options)
+{
+	for (auto index = 0; index < (int)statsData.Data.RollingWindows.size(); index++)
+	{
+		const auto& window = statsData.Data.RollingWindows[index];
+		if (window.Size <= 0) { break; }
+
+		auto windowSize = std::to_string(window.Size);
+		statList.emplace_back(SingleStatStrings{ "Last " + windowSize + " Shots:", to_percentage_string(window.Percentage), "%" });
+		statList.emplace_back(SingleStatStrings{ "Peak Last " + windowSize + ":", to_percentage_string(window.PeakPercentage), "%" });
+
+		// There is nothing to compare to if the compare base did not have this window
+		if (diffData && diffData->Data.RollingWindows[index].Size == window.Size)
+		{
+			set_diff_percentage(statList.back(), diffData->Data.RollingWindows[index].PeakPercentage);
+		}
+	}
+}
+
+bool StatRowPlan::update(const PluginState& pluginState)
+{
+	// Settings change rarely, so usually there is nothing to do but comparing the versions
+	auto settingsVersion = pluginState.SettingsVersion.load();
+	auto statsOrderVersion = GoalPercentageCounterSettings::getStatOrderVersion();
+	if (_isValid && _settingsVersion == settingsVersion && _statsOrderVersion == statsOrderVersion)
+	{
+		return false;
+	}
+	_settingsVersion = settingsVersion;
+
+	// Most settings do not affect the stat display
+	auto visibilityMask = getStatVisibilityMask(pluginState);
+	if (_isValid && _visibilityMask == visibilityMask && _statsOrderVersion == statsOrderVersion)
+	{
+		return false;
+	}
+
+	// The order can't change while it is being used, even if a new one gets published in the meantime
+	auto statOrder = GoalPercentageCounterSettings::getStatOrder();
+	_statsOrderVersion = statOrder->Version;
+	rebuild(visibilityMask, statOrder->Names);
+	return true;
+}
+
+void StatRowPlan::rebuild(StatVisibilityMask visibilityMask, const std::vector<std::string>& orderedStats)
+{
+	_isValid = true;
+	_version++;
+	_visibilityMask = visibilityMask;
+	_formatOptions.IsMetric = containsFlags(visibilityMask, StatVisibilityMask::MetricUnits);
+	_formatOptions.SpeedUnits = _formatOptions.IsMetric ? "km/h" : "mph";
+
+	_entries.clear();
+	auto addEntry = [this, visibilityMask](StatVisibilityMask flag, StatRowId id, StatRowFormatter format) {
+		if (containsFlags(visibilityMask, flag))
+		{
+			_entries.push_back(StatRowPlanEntry{ id, format });
+		}
+	};
+	for (const auto& setting : orderedStats)
+	{
+		if (setting == GoalPercentageCounterSettings::DisplayAttemptsAndGoalsDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::AttemptsAndGoals, StatRowId::Attempts, addAttempts);
+			addEntry(StatVisibilityMask::AttemptsAndGoals, StatRowId::Goals, addGoals);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayInitialBallHitsDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::InitialBallHits, StatRowId::InitialBallHits, addInitialBallHits);
+			addEntry(StatVisibilityMask::InitialBallHits, StatRowId::InitialHitRate, addInitialHitRate);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayCurrentStreaksDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::CurrentStreaks, StatRowId::CurrentGoalStreak, addCurrentGoalStreak);
+			addEntry(StatVisibilityMask::CurrentStreaks, StatRowId::CurrentMissStreak, addCurrentMissStreak);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayLongestStreaksDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::LongestStreaks, StatRowId::LongestGoalStreak, addLongestGoalStreak);
+			addEntry(StatVisibilityMask::LongestStreaks, StatRowId::LongestMissStreak, addLongestMissStreak);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayAirDribbleTouchesDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::AirDribbleTouches, StatRowId::AirDribbleTouches, addAirDribbleTouches);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayAirDribbleTimeDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::AirDribbleTime, StatRowId::AirDribbleTime, addAirDribbleTime);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayGroundDribbleDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::GroundDribbleTime, StatRowId::GroundDribbleTime, addGroundDribbleTime);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayTotalFlipResetsDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::TotalFlipResets, StatRowId::TotalFlipResets, addTotalFlipResets);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayMaxFlipResetsDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::GroundDribbleTime, StatRowId::MaxFlipResets, addMaxFlipResets);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayDoubleTapGoalsDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::DoubleTapGoals, StatRowId::DoubleTapGoals, addDoubleTapGoals);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayCloseMissesDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::CloseMisses, StatRowId::CloseMisses, addCloseMisses);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayTotalSuccessRateDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::TotalSuccessRate, StatRowId::TotalSuccessRate, addTotalSuccessRate);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayLastNShotPercentageDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::LastNShotPercentage, StatRowId::LastNShotPercentage, addLastNShotPercentage);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayPeakInfoDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::PeakInfo, StatRowId::PeakSuccessRate, addPeakSuccessRate);
+			addEntry(StatVisibilityMask::PeakInfo, StatRowId::PeakAtShotNumber, addPeakAtShotNumber);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayMostRecentGoalSpeedDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::MostRecentGoalSpeed, StatRowId::LatestGoalSpeed, addLatestGoalSpeed);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayMinGoalSpeedDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::MinGoalSpeed, StatRowId::MinimumGoalSpeed, addMinimumGoalSpeed);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayMedianGoalSpeedDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::MedianGoalSpeed, StatRowId::MedianGoalSpeed, addMedianGoalSpeed);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayMaxGoalSpeedDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::MaxGoalSpeed, StatRowId::MaximumGoalSpeed, addMaximumGoalSpeed);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayMeanGoalSpeedDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::MeanGoalSpeed, StatRowId::MeanGoalSpeed, addMeanGoalSpeed);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayStdDevGoalSpeedDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::StdDevGoalSpeed, StatRowId::StdDevGoalSpeed, addStdDevGoalSpeed);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayFlipResetsPerAttemptDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::FlipResetsPerAttempt, StatRowId::FlipResetsPerAttempt, addFlipResetsPerAttempt);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayFlipResetPercentageDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::FlipResetPercentage, StatRowId::FlipResetPercentage, addFlipResetPercentage);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayDoubleTapPercentageDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::DoubleTapPercentage, StatRowId::DoubleTapPercentage, addDoubleTapPercentage);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayCloseMissPercentageDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::CloseMissPercentage, StatRowId::CloseMissRate, addCloseMissRate);
+		}
+		else if (setting == GoalPercentageCounterSettings::DisplayRollingWindowsDef.DisplayText)
+		{
+			addEntry(StatVisibilityMask::RollingWindows, StatRowId::RollingWindows, addRollingWindows);
+		}
+	}
+}
+
+std::vector<SingleStatStrings> StatRowPlan::formatRows(const StatsData& statsData, const StatsData* const diffData) const
+{
+	std::vector<SingleStatStrings> statNamesAndValues;
+	statNamesAndValues.reserve(_entries.size() + 1);
+	for (const auto& entry : _entries)
+	{
+		entry.Format(statNamesAndValues, statsData, diffData, _formatOptions);
+	}
+
+	if (statNamesAndValues.empty())
+	{
+		statNamesAndValues.emplace_back(SingleStatStrings{ "What did you expect?", "  ;-)", "" });
+	}
+	return statNamesAndValues;
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../DLLImportExport.h"
+#include "../Data/StatsData.h"
+#include "../Data/PluginState.h"
+#include "StatVisibilityMask.h"
+
+/** Defines parts of what shall be displyed in a single line in the stat display. */
+struct SingleStatStrings
+{
+public:
+	std::string Label;
+	std::string Value;
+	std::string Unit;
+	std::optional<std::string> DiffValue;
+	double DiffNumber = .0;			///< The displayed difference as a number, so it does not have to be parsed again. Only valid if DiffValue is set.
+	bool DiffIsNegative = false;	///< True if the difference is displayed as a decline. Only valid if DiffValue is set.
+};
+
+/** Identifies the stats which can be displayed. Most of them are displayed in a single row, rolling windows use two rows per window. */
+enum class StatRowId : uint8_t
+{
+	Attempts,
+	Goals,
+	InitialBallHits,
+	InitialHitRate,
+	CurrentGoalStreak,
+	CurrentMissStreak,
+	LongestGoalStreak,
+	LongestMissStreak,
+	AirDribbleTouches,
+	AirDribbleTime,
+	GroundDribbleTime,
+	TotalFlipResets,
+	MaxFlipResets,
+	DoubleTapGoals,
+	CloseMisses,
+	TotalSuccessRate,
+	LastNShotPercentage,
+	PeakSuccessRate,
+	PeakAtShotNumber,
+	LatestGoalSpeed,
+	MinimumGoalSpeed,
+	MedianGoalSpeed,
+	MaximumGoalSpeed,
+	MeanGoalSpeed,
+	StdDevGoalSpeed,
+	FlipResetsPerAttempt,
+	FlipResetPercentage,
+	DoubleTapPercentage,
+	CloseMissRate,
+	RollingWindows,
+};
+
+/** Settings which change how stats are formatted, but not which stats are displayed. */
+struct StatRowFormatOptions
+{
+	bool IsMetric = true;
+	std::string SpeedUnits = "km/h";
+};
+
+/** Appends the row(s) of a single stat to the list. diffData is nullptr if there is nothing to compare to. */
+using StatRowFormatter = void(*)(std::vector<SingleStatStrings>& statList, const StatsData& statsData, const StatsData* const diffData, const StatRowFormatOptions& options);
+
+/** A single stat of the plan, and the function which formats it. */
+struct StatRowPlanEntry
+{
+	StatRowId Id;
+	StatRowFormatter Format;
+};
+
+/** Stores which stats shall be displayed, in display order.
+ *
+ * The plan only gets rebuilt when a display setting or the stat order changes. Formatting stats just walks the plan, so it neither needs to
+ * compare the names of the ordered stats nor check the display flags of every stat.
+ */
+class GOALPERCENTAGECOUNTER_IMPORT_EXPORT StatRowPlan
+{
+public:
+	/** Rebuilds the plan if the display flags or the stat order have changed since the last update. Returns true if the plan has been rebuilt. */
+	bool update(const PluginState& pluginState);
+	/** Rebuilds the plan for the given flags and stat order, where the stat order contains the display texts of the display settings. */
+	void rebuild(StatVisibilityMask visibilityMask, const std::vector<std::string>& orderedStats);
+
+	/** Formats every stat of the plan. Provides a placeholder row if there is nothing to be displayed. */
+	std::vector<SingleStatStrings> formatRows(const StatsData& statsData, const StatsData* const diffData = nullptr) const;
+
+	/** Retrieves the stats which shall be displayed, in display order. */
+	inline const std::vector<StatRowPlanEntry>& getEntries() const { return _entries; }
+	/** Retrieves the display flags the plan was built for. */
+	inline StatVisibilityMask getVisibilityMask() const { return _visibilityMask; }
+	/** Retrieves a number which increases whenever the plan gets rebuilt, so anything formatted with the plan knows when it is outdated. */
+	inline uint64_t getVersion() const { return _version; }
+
+private:
+	bool _isValid = false;											///< False until the plan has been built for the first time.
+	uint64_t _version = 0;											///< Increases with every rebuild.
+	uint64_t _settingsVersion = 0;									///< The version of the plugin settings which were checked last.
+	uint64_t _statsOrderVersion = 0;								///< The version of the stat order the plan was built for.
+	StatVisibilityMask _visibilityMask = StatVisibilityMask::None;	///< The display flags the plan was built for.
+	StatRowFormatOptions _formatOptions;							///< Derived from the display flags.
+	std::vector<StatRowPlanEntry> _entries;							///< The stats to be displayed, in display order.
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../Data/PluginState.h"
+
+/** Packs the flags of PluginState which decide which stats appear in the stat display, so they can be compared all at once. */
+enum class StatVisibilityMask : uint32_t
+{
+	None = 0,
+	AttemptsAndGoals = 1 << 0,			///< Attempts and goals.
+	InitialBallHits = 1 << 1,			///< Initial ball hits and the initial hit rate.
+	CurrentStreaks = 1 << 2,			///< The current goal and miss streaks.
+	LongestStreaks = 1 << 3,			///< The longest goal and miss streaks.
+	TotalSuccessRate = 1 << 4,			///< The total success rate.
+	PeakInfo = 1 << 5,					///< The peak success rate and the shot it was reached at.
+	LastNShotPercentage = 1 << 6,		///< The success rate of the last 50 shots.
+	MostRecentGoalSpeed = 1 << 7,		///< The speed of the latest goal.
+	MinGoalSpeed = 1 << 8,				///< The minimum goal speed.
+	MedianGoalSpeed = 1 << 9,			///< The median goal speed.
+	MaxGoalSpeed = 1 << 10,			///< The maximum goal speed.
+	MeanGoalSpeed = 1 << 11,			///< The mean goal speed.
+	StdDevGoalSpeed = 1 << 12,			///< The standard deviation of the goal speed.
+	AirDribbleTouches = 1 << 13,		///< The maximum number of air dribble touches.
+	AirDribbleTime = 1 << 14,			///< The maximum air dribble time.
+	GroundDribbleTime = 1 << 15,		///< The maximum ground dribble time.
+	DoubleTapGoals = 1 << 16,			///< The number of double tap goals.
+	DoubleTapPercentage = 1 << 17,		///< The double tap goal rate.
+	MaxFlipResets = 1 << 18,			///< The maximum number of flip resets in one attempt.
+	TotalFlipResets = 1 << 19,			///< The total number of flip resets.
+	FlipResetsPerAttempt = 1 << 20,	///< The average number of flip resets per attempt.
+	FlipResetPercentage = 1 << 21,		///< The flip reset goal rate.
+	CloseMisses = 1 << 22,				///< The number of close misses.
+	CloseMissPercentage = 1 << 23,		///< The close miss rate.
+	RollingWindows = 1 << 24,			///< The success rate and peak of every rolling window.
+	MetricUnits = 1 << 25,				///< Not a visibility flag, but speeds are formatted in km/h rather than mph.
+
+	GoalSpeed = MostRecentGoalSpeed | MinGoalSpeed | MedianGoalSpeed | MaxGoalSpeed | MeanGoalSpeed,	///< The goal speed stats which make the stat display wider.
+};
+
+inline StatVisibilityMask operator|(StatVisibilityMask left, StatVisibilityMask right)
+{
+	return (StatVisibilityMask)((uint32_t)left | (uint32_t)right);
+}
+
+/** Returns true if all of the given flags are part of the mask. */
+inline bool containsFlags(StatVisibilityMask mask, StatVisibilityMask flags)
+{
+	return ((uint32_t)mask & (uint32_t)flags) == (uint32_t)flags;
+}
+
+/** Returns true if at least one of the given flags is part of the mask. */
+inline bool containsAnyFlag(StatVisibilityMask mask, StatVisibilityMask flags)
+{
+	return ((uint32_t)mask & (uint32_t)flags) != 0;
+}
+
+/** Collects the display flags of the given plugin state. */
+inline StatVisibilityMask getStatVisibilityMask(const PluginState& pluginState)
+{
+	auto mask = StatVisibilityMask::None;
+	auto addFlag = [&mask](bool isSet, StatVisibilityMask flag) { if (isSet) { mask = mask | flag; } };
+	addFlag(pluginState.AttemptsAndGoalsShallBeDisplayed, StatVisibilityMask::AttemptsAndGoals);
+	addFlag(pluginState.InitialBallHitsShallBeDisplayed, StatVisibilityMask::InitialBallHits);
+	addFlag(pluginState.CurrentStreaksShallBeDisplayed, StatVisibilityMask::CurrentStreaks);
+	addFlag(pluginState.LongestStreaksShallBeDisplayed, StatVisibilityMask::LongestStreaks);
+	addFlag(pluginState.TotalSuccessRateShallBeDisplayed, StatVisibilityMask::TotalSuccessRate);
+	addFlag(pluginState.PeakInfoShallBeDisplayed, StatVisibilityMask::PeakInfo);
+	addFlag(pluginState.LastNShotPercentageShallBeDisplayed, StatVisibilityMask::LastNShotPercentage);
+	addFlag(pluginState.MostRecentGoalSpeedShallBeDisplayed, StatVisibilityMask::MostRecentGoalSpeed);
+	addFlag(pluginState.MinGoalSpeedShallBeDisplayed, StatVisibilityMask::MinGoalSpeed);
+	addFlag(pluginState.MedianGoalSpeedShallBeDisplayed, StatVisibilityMask::MedianGoalSpeed);
+	addFlag(pluginState.MaxGoalSpeedShallBeDisplayed, StatVisibilityMask::MaxGoalSpeed);
+	addFlag(pluginState.MeanGoalSpeedShallBeDisplayed, StatVisibilityMask::MeanGoalSpeed);
+	addFlag(pluginState.StdDevGoalSpeedShallBeDisplayed, StatVisibilityMask::StdDevGoalSpeed);
+	addFlag(pluginState.AirDribbleTouchesShallBeDisplayed, StatVisibilityMask::AirDribbleTouches);
+	addFlag(pluginState.AirDribbleTimeShallBeDisplayed, StatVisibilityMask::AirDribbleTime);
+	addFlag(pluginState.GroundDribbleTimeShallBeDisplayed, StatVisibilityMask::GroundDribbleTime);
+	addFlag(pluginState.DoubleTapGoalsShallBeDisplayed, StatVisibilityMask::DoubleTapGoals);
+	addFlag(pluginState.DoubleTapPercentageShallBeDisplayed, StatVisibilityMask::DoubleTapPercentage);
+	addFlag(pluginState.MaxFlipResetsShallBeDisplayed, StatVisibilityMask::MaxFlipResets);
+	addFlag(pluginState.TotalFlipResetsShallBeDisplayed, StatVisibilityMask::TotalFlipResets);
+	addFlag(pluginState.FlipResetsPerAttemptShallBeDisplayed, StatVisibilityMask::FlipResetsPerAttempt);
+	addFlag(pluginState.FlipResetPercentageShallBeDisplayed, StatVisibilityMask::FlipResetPercentage);
+	addFlag(pluginState.CloseMissesShallBeDisplayed, StatVisibilityMask::CloseMisses);
+	addFlag(pluginState.CloseMissPercentageShallBeDisplayed, StatVisibilityMask::CloseMissPercentage);
+	addFlag(pluginState.RollingWindowsShallBeDisplayed, StatVisibilityMask::RollingWindows);
+	addFlag(pluginState.IsMetric, StatVisibilityMask::MetricUnits);
+	return mask;
+}
@@ -39,15 +39,29 @@ void GoalPercentageCounter::onLoad()
 
 	auto differenceData = std::make_shared<ShotStats>(); // will store the difference between the previous session and the current one
 
+	// The summary page and the overlay receive copies of the stats, since the summary page gets rendered on a different thread
+	auto snapshotPublisher = std::make_shared<StatsSnapshotPublisher>();
+	auto overlaySnapshots = snapshotPublisher->addReader();
+
 	// Initialize the stats summary page
-	initSummaryUi(cvarManager, _shotStats, differenceData, _pluginState);
+	initSummaryUi(cvarManager, snapshotPublisher->addReader(), _pluginState);
 
 	// Create handler classes
 	auto shotDistributionTracker = std::make_shared<ShotDistributionTracker>(gameWrapper);
-	auto statReader = std::make_shared<StatFileReader>(gameWrapper, shotDistributionTracker);
-	auto statWriter = std::make_shared<StatFileWriter>(gameWrapper, _shotStats, shotDistributionTracker);
-	auto peakHandler = std::make_shared<AllTimePeakHandler>(statReader, statWriter, _pluginState, _shotStats);
-	auto statUpdater = std::make_shared<StatUpdater>(_shotStats, differenceData, _pluginState, statReader, peakHandler);
+	// File access happens in the background so writing a long session or reading a previous one does not cause a hitch.
+	// Results of reads get passed back to the game thread
+	_storageWorker = std::make_shared<StorageWorker>([this](std::function<void()> callback) {
+		gameWrapper->Execute([callback](const GameWrapper*) {
+			callback();
+		});
+	});
+	auto sessionIndex = std::make_shared<SessionIndex>(); // shared by reader and writer so the writer can keep it up to date
+	auto statReader = std::make_shared<StatFileReader>(gameWrapper, shotDistributionTracker, sessionIndex);
+	auto prefetchCache = std::make_shared<SessionPrefetchCache>(statReader, shotDistributionTracker, _storageWorker);
+	auto statWriter = std::make_shared<StatFileWriter>(gameWrapper, _shotStats, shotDistributionTracker, sessionIndex, _storageWorker, prefetchCache);
+	_statWriter = statWriter;
+	auto peakHandler = std::make_shared<AllTimePeakHandler>(statReader, statWriter, _pluginState, _shotStats, prefetchCache);
+	auto statUpdater = std::make_shared<StatUpdater>(_shotStats, differenceData, _pluginState, statReader, peakHandler, prefetchCache, snapshotPublisher);
 
 
 	// Set up event registration
@@ -88,7 +102,7 @@ void GoalPercentageCounter::onLoad()
 
 
 	// Enable rendering of output
-	auto statDisplay = std::make_shared<StatDisplay>(_shotStats, differenceData, _pluginState);
+	auto statDisplay = std::make_shared<StatDisplay>(overlaySnapshots, _pluginState);
 	_eventListener->registerRenderEvents({ statDisplay, shotDistributionTracker });
 
 	cvarManager->log("Loaded GoalPercentageCounter plugin");
@@ -97,5 +111,18 @@ void GoalPercentageCounter::onLoad()
 void GoalPercentageCounter::onUnload()
 {
 	_eventListener.reset(); // Stop listening to events before destroying anything else
+	if (_statWriter)
+	{
+		// Unloading the plugin ends the current session
+		_statWriter->compactStorage();
+	}
+	if (_storageWorker)
+	{
+		// Everything which was queued must be on disk before the plugin is gone. Pending read callbacks get discarded.
+		// This must happen before the writer gets destroyed, since its pending writes still refer to it
+		_storageWorker->shutdown();
+		_storageWorker.reset();
+	}
+	_statWriter.reset();
 	cvarManager->log("Unloaded GoalPercentageCounter plugin");
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "Data/ShotStats.h"
 #include "Data/PluginState.h"
 #include "Core/EventListener.h"
+#include "Storage/StorageWorker.h"
 
 constexpr auto plugin_version = stringify(VERSION_MAJOR) "." stringify(VERSION_MINOR) "." stringify(VERSION_PATCH) "." stringify(VERSION_BUILD);
 
@@ -26,5 +27,7 @@ private:
 	std::shared_ptr<ShotStats> _shotStats = std::make_shared<ShotStats>();
 	std::shared_ptr<PluginState> _pluginState = std::make_shared<PluginState>();
 	std::shared_ptr<EventListener> _eventListener;
+	std::shared_ptr<IStatWriter> _statWriter;
+	std::shared_ptr<StorageWorker> _storageWorker; ///< Reads and writes stat files in the background
 };
 
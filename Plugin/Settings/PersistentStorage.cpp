@@ -1,6 +1,7 @@
 #include <pch.h>
 #include "PersistentStorage.h"
 #include <fstream>
+#include <string_view>
 #include "SettingsDefinition.h"
 
 PersistentStorage::PersistentStorage(
@@ -9,6 +10,7 @@ PersistentStorage::PersistentStorage(
 	const bool auto_write, 
 	bool auto_load) :
 	cv_(plugin->cvarManager),
+	gw_(plugin->gameWrapper),
 	storage_file_(GetStorageFilePath(plugin->gameWrapper, storage_file_name)),
 	auto_write_(auto_write)
 
@@ -29,19 +31,47 @@ PersistentStorage::PersistentStorage(
 
 PersistentStorage::~PersistentStorage()
 {
+	// Scheduled writes must not access this object anymore. Any change they would have written gets written now
+	alive_token_.reset();
+	write_pending_ = false;
 	WritePersistentStorage();
 }
 
 void PersistentStorage::WritePersistentStorage()
 {
+	fmt::memory_buffer content;
+	for (const auto& [cvar, cvar_cache_item] : cvar_cache_)
+	{
+		fmt::format_to(content, "{} \"{}\" //{}\n", cvar, cvar_cache_item.value, cvar_cache_item.description);
+	}
+
+	// Changing a value back and forth, or writing the config without changing anything, does not require touching the file
+	std::string_view contentView(content.data(), content.size());
+	if (contentView == last_written_content_) { return; }
+
 	std::ofstream out(storage_file_);
 	//LOG("PersistentStorage: Writing to file");
-	for (const auto& [cvar, cvar_cache_item] : cvar_cache_)
+	out.write(content.data(), (std::streamsize)content.size());
+	if (out)
 	{
-		out << fmt::format("{} \"{}\" //{}\n", cvar, cvar_cache_item.value, cvar_cache_item.description);
+		last_written_content_.assign(contentView);
 	}
 }
 
+void PersistentStorage::ScheduleWrite()
+{
+	if (write_pending_.exchange(true)) { return; } // The scheduled write will include the latest change
+
+	std::weak_ptr<bool> aliveToken = alive_token_;
+	gw_->SetTimeout([this, aliveToken](...)
+	{
+		if (aliveToken.expired()) { return; }
+
+		write_pending_ = false;
+		WritePersistentStorage();
+	}, write_delay_seconds_);
+}
+
 void PersistentStorage::Load()
 {
 	cv_->log("PersistentStorage: Loading the persistent storage cfg");
@@ -52,16 +82,16 @@ void PersistentStorage::Load()
 	if (auto settingsOrderCvar = cv_->getCvar(GoalPercentageCounterSettings::OrderedStatsCVarName))
 	{
 		auto potentialSettingsOrder = string_to_vector(settingsOrderCvar.getStringValue());
-		std::scoped_lock lock(GoalPercentageCounterSettings::OrderedStatsMutex);
-		if (potentialSettingsOrder.size() == GoalPercentageCounterSettings::OrderedStatsNames.size())
+		auto currentOrder = GoalPercentageCounterSettings::getStatOrder();
+		if (potentialSettingsOrder.size() == currentOrder->Names.size())
 		{
 			// The stats are valid and may be applied
-			GoalPercentageCounterSettings::OrderedStatsNames = potentialSettingsOrder;
+			GoalPercentageCounterSettings::setStatOrder(std::move(potentialSettingsOrder));
 		}
 		else
 		{
 			// The stats are from an older version or empty => apply current defaults
-			settingsOrderCvar.setValue(vector_to_string(GoalPercentageCounterSettings::OrderedStatsNames));
+			settingsOrderCvar.setValue(vector_to_string(currentOrder->Names));
 			cv_->log("PersistentStorage: Could not restore stat order, applying default.");
 		}
 	}
@@ -132,7 +162,7 @@ void PersistentStorage::OnPersistentCvarChanged(const std::string& old, CVarWrap
 	// If you Write to file before the file has been loaded. You will loose the data there.
 	if (auto_write_ && loaded_)
 	{
-		WritePersistentStorage();
+		ScheduleWrite();
 	}
 }
 
@@ -1,7 +1,9 @@
 // https://bakkesmodwiki.github.io/code_snippets/persistent_storage/
 #pragma once
+#include <atomic>
 #include <filesystem>
 #include <map>
+#include <memory>
 #include <string>
 
 #include <bakkesmod/plugin/bakkesmodplugin.h>
@@ -32,10 +34,15 @@ public:
     ~PersistentStorage();
 
     /// <summary>
-    /// Writes the cvar values to disk
+    /// Writes the cvar values to disk, unless the file already contains exactly these values
     /// </summary>
     void WritePersistentStorage();
 
+    /// <summary>
+    /// Writes the cvar values to disk after a short delay. Any change within that delay gets written along with the first one.
+    /// </summary>
+    void ScheduleWrite();
+
     /// <summary>
     /// Loads the cvar values from disk
     /// </summary>
@@ -89,10 +96,15 @@ public:
     }
 
 private:
+    static constexpr float write_delay_seconds_ = 1.0f;             ///< Dragging a slider changes its cvar many times per second, but the file only gets written once per delay
     std::shared_ptr<CVarManagerWrapper> cv_;
+    std::shared_ptr<GameWrapper> gw_;
     std::filesystem::path storage_file_{ "" };
     bool auto_write_ = false;
     bool loaded_ = false;
+    std::atomic<bool> write_pending_{ false };                      ///< True while a write has been scheduled, but not been done yet
+    std::string last_written_content_;                              ///< The content of the file after the most recent write
+    std::shared_ptr<bool> alive_token_ = std::make_shared<bool>();  ///< Lets scheduled writes detect that the storage has been destroyed in the meantime
 
     struct CvarCacheItem
     {
@@ -14,7 +14,7 @@ void PluginSettingsUI::initPluginSettingsUi(std::function<void(const std::string
 
 	// Initialize the static list of all settings now
 	// TODO: Figure out a way to store and restore this order
-	GoalPercentageCounterSettings::OrderedStatsNames = {
+	GoalPercentageCounterSettings::setStatOrder({
 		GoalPercentageCounterSettings::DisplayAttemptsAndGoalsDef.DisplayText,
 		GoalPercentageCounterSettings::DisplayInitialBallHitsDef.DisplayText,
 		GoalPercentageCounterSettings::DisplayCurrentStreaksDef.DisplayText,
@@ -38,8 +38,9 @@ void PluginSettingsUI::initPluginSettingsUi(std::function<void(const std::string
 		GoalPercentageCounterSettings::DisplayFlipResetsPerAttemptDef.DisplayText,
 		GoalPercentageCounterSettings::DisplayFlipResetPercentageDef.DisplayText,
 		GoalPercentageCounterSettings::DisplayCloseMissesDef.DisplayText,
-		GoalPercentageCounterSettings::DisplayCloseMissPercentageDef.DisplayText
-	};
+		GoalPercentageCounterSettings::DisplayCloseMissPercentageDef.DisplayText,
+		GoalPercentageCounterSettings::DisplayRollingWindowsDef.DisplayText
+	});
 }
 
 std::string PluginSettingsUI::GetPluginName()
@@ -108,6 +109,24 @@ void PluginSettingsUI::createColorEdit(const SettingsDefinition& settingsDefinit
 	}
 }
 
+void PluginSettingsUI::createTextInput(const SettingsDefinition& settingsDefinition)
+{
+	auto cvar = _cvarManager->getCvar(settingsDefinition.VariableName);
+	if (!cvar) { return; }
+
+	char buffer[256] = {};
+	auto currentValue = cvar.getStringValue();
+	currentValue.copy(buffer, sizeof(buffer) - 1);
+	if (ImGui::InputText(settingsDefinition.DisplayText.c_str(), buffer, sizeof(buffer), ImGuiInputTextFlags_EnterReturnsTrue))
+	{
+		cvar.setValue(std::string(buffer));
+	}
+	if (ImGui::IsItemHovered() && !settingsDefinition.ToolTipText.empty())
+	{
+		ImGui::SetTooltip(settingsDefinition.ToolTipText.c_str());
+	}
+}
+
 void PluginSettingsUI::createDropdownMenu(const SettingsDefinition& settingsDefinition, const char* items[], int numItems)
 {
 	auto cvar = _cvarManager->getCvar(settingsDefinition.VariableName);
@@ -258,27 +277,39 @@ void PluginSettingsUI::RenderSettings()
 
 		ImGui::Separator();
 
+		ImGui::Text("Rolling Windows");
+		ImGui::Text("Shows the success rate within several windows over your most recent shots at the same time, e.g. the last 10 and the last 100 shots.");
+		ImGui::Text("Every window tracks its own peak. Windows of more than 20 shots track their peak only after 20 attempts.");
+
+		createCheckbox(GoalPercentageCounterSettings::DisplayRollingWindowsDef);
+		createTextInput(GoalPercentageCounterSettings::RollingWindowSizesDef);
+
+		ImGui::Separator();
+
 	}
 	if (ImGui::CollapsingHeader("Stat Order"))
 	{
-		std::scoped_lock lock(GoalPercentageCounterSettings::OrderedStatsMutex);
-		for (int n = 0; n < (int)GoalPercentageCounterSettings::OrderedStatsNames.size(); n++)
+		// The order stays the same for the whole frame. Moving an item publishes a new order, which gets displayed from the next frame on
+		auto statOrder = GoalPercentageCounterSettings::getStatOrder();
+		const auto& orderedStats = statOrder->Names;
+		for (int n = 0; n < (int)orderedStats.size(); n++)
 		{
-			auto item = GoalPercentageCounterSettings::OrderedStatsNames[n];
+			const auto& item = orderedStats[n];
 			ImGui::Selectable(item.c_str());
 
 			if (ImGui::IsItemActive() && !ImGui::IsItemHovered())
 			{
 				auto n_next = n + (ImGui::GetMouseDragDelta(0).y < 0.f ? -1 : 1);
-				if (n_next >= 0 && n_next < GoalPercentageCounterSettings::OrderedStatsNames.size())
+				if (n_next >= 0 && n_next < orderedStats.size())
 				{
-					GoalPercentageCounterSettings::OrderedStatsNames[n] = GoalPercentageCounterSettings::OrderedStatsNames[n_next];
-					GoalPercentageCounterSettings::OrderedStatsNames[n_next] = item;
+					auto newOrder = orderedStats;
+					std::swap(newOrder[n], newOrder[n_next]);
 					ImGui::ResetMouseDragDelta();
 
 					// Store the new order so it gets restored when starting the game again
 					_cvarManager->getCvar(GoalPercentageCounterSettings::OrderedStatsCVarName)
-						.setValue(vector_to_string(GoalPercentageCounterSettings::OrderedStatsNames));
+						.setValue(vector_to_string(newOrder));
+					GoalPercentageCounterSettings::setStatOrder(std::move(newOrder));
 				}
 			}
 		}
@@ -34,6 +34,8 @@ private:
 	void createFloatSlider(const SettingsDefinition& settingsDefinition);
 	/** Creates a control which allows configuring the color. */
 	void createColorEdit(const SettingsDefinition& settingsDefinition);
+	/** Creates a text input, which changes the value only once the user presses Enter. */
+	void createTextInput(const SettingsDefinition& settingsDefinition);
 	/** Creates a dropdown menu. */
 	void createDropdownMenu(const SettingsDefinition& settingsDefinition, const char* items[], int numItmes);
 
@@ -1,5 +1,9 @@
 #include <pch.h>
 #include "SettingsDefinition.h"
+#include "../Data/RollingWindow.h"
+
+#include <algorithm>
+#include <charconv>
 
 const SettingsDefinition GoalPercentageCounterSettings::StatsShallBeDisplayedDef = {
 	"customtrainingstatistics_enable_stat_display",
@@ -255,6 +259,22 @@ const SettingsDefinition GoalPercentageCounterSettings::DisplayCloseMissPercenta
 	1.0f,
 	"0.0f"
 };
+const SettingsDefinition GoalPercentageCounterSettings::DisplayRollingWindowsDef = {
+	"customtrainingstatistics_display_rolling_windows",
+	"Rolling Windows",
+	"Toggle display of the success rate and peak success rate within each rolling window.",
+	.0f,
+	1.0f,
+	"0.0f"
+};
+const SettingsDefinition GoalPercentageCounterSettings::RollingWindowSizesDef = {
+	"customtrainingstatistics_rolling_window_sizes",
+	"Rolling Window Sizes",
+	"A comma separated list of up to five window sizes between 1 and 500 shots, e.g. 10,25,50,100,500. Press Enter to apply.",
+	{},
+	{},
+	"10,25,50,100,500"
+};
 
 
 const SettingsDefinition GoalPercentageCounterSettings::AllShotXPositionDef = {
@@ -373,10 +393,34 @@ const char* GoalPercentageCounterSettings::KeybindingsArray[] = { "None","F1","F
 
 
 // This is initialized later on in order to make sure every setting has been initialized
-std::vector<std::string> GoalPercentageCounterSettings::OrderedStatsNames;
-std::mutex GoalPercentageCounterSettings::OrderedStatsMutex;
+std::shared_ptr<const StatOrder> GoalPercentageCounterSettings::_statOrder = std::make_shared<const StatOrder>();
+std::atomic<uint64_t> GoalPercentageCounterSettings::_statOrderVersion{ 0 };
+std::mutex GoalPercentageCounterSettings::_statOrderWriteMutex;
 const std::string GoalPercentageCounterSettings::OrderedStatsCVarName = "customtrainingstatistics_stats_order";
 
+std::shared_ptr<const StatOrder> GoalPercentageCounterSettings::getStatOrder()
+{
+	return std::atomic_load(&_statOrder);
+}
+
+uint64_t GoalPercentageCounterSettings::getStatOrderVersion()
+{
+	return _statOrderVersion.load();
+}
+
+void GoalPercentageCounterSettings::setStatOrder(std::vector<std::string> names)
+{
+	std::scoped_lock lock(_statOrderWriteMutex);
+	auto newOrder = std::make_shared<StatOrder>();
+	newOrder->Version = getStatOrder()->Version + 1;
+	newOrder->Names = std::move(names);
+
+	// The order must be published before its version, so anyone who sees the new version also gets the new order
+	auto version = newOrder->Version;
+	std::atomic_store(&_statOrder, std::shared_ptr<const StatOrder>(std::move(newOrder)));
+	_statOrderVersion.store(version);
+}
+
 
 std::string vector_to_string(const std::vector<std::string>& values)
 {
@@ -414,4 +458,39 @@ std::vector<std::string> string_to_vector(const std::string& vectorAsString)
 		}
 	}
 	return result;
+}
+std::vector<int> string_to_window_sizes(const std::string& windowSizesAsString)
+{
+	std::vector<int> windowSizes;
+	size_t offset = 0;
+	while (offset <= windowSizesAsString.size())
+	{
+		auto separatorPos = windowSizesAsString.find(',', offset);
+		if (separatorPos == std::string::npos) { separatorPos = windowSizesAsString.size(); }
+
+		// Surrounding spaces are allowed, anything else invalidates the entry
+		auto begin = windowSizesAsString.find_first_not_of(' ', offset);
+		auto end = windowSizesAsString.find_last_not_of(' ', separatorPos - 1);
+		int windowSize = 0;
+		if (begin < separatorPos && end != std::string::npos && end >= begin)
+		{
+			auto first = windowSizesAsString.data() + begin;
+			auto last = windowSizesAsString.data() + end + 1;
+			if (auto [ptr, errorCode] = std::from_chars(first, last, windowSize);
+				errorCode == std::errc() && ptr == last &&
+				windowSize > 0 && windowSize <= RollingWindowDefs::MaxWindowSize &&
+				std::find(windowSizes.begin(), windowSizes.end(), windowSize) == windowSizes.end())
+			{
+				windowSizes.push_back(windowSize);
+			}
+		}
+		offset = separatorPos + 1;
+	}
+
+	std::sort(windowSizes.begin(), windowSizes.end());
+	if (windowSizes.size() > (size_t)RollingWindowDefs::MaxNumberOfWindows)
+	{
+		windowSizes.resize(RollingWindowDefs::MaxNumberOfWindows);
+	}
+	return windowSizes;
 }
\ No newline at end of file
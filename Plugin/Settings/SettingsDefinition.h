@@ -1,8 +1,13 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <optional>
 #include <sstream>
+#include <vector>
 
 /** Defines parameters related to a user configurable setting. */
 class SettingsDefinition
@@ -16,6 +21,13 @@ public:
 	std::string DefaultValue;			///< The default value (should always be provided)
 };
 
+/** A display order of the stats. It never changes once it has been published, so readers can keep using it without locking anything. */
+struct StatOrder
+{
+	uint64_t Version = 0;				///< Increases with every published order. Zero means no order has been published yet.
+	std::vector<std::string> Names;		///< The display texts of the display settings, in display order.
+};
+
 /** Defines settings which are available for this plugin. */
 class GoalPercentageCounterSettings
 {
@@ -53,6 +65,8 @@ public:
 	static const SettingsDefinition DisplayFlipResetPercentageDef;	///< Definitions for the flag which toggles display of flip reset goal percentage.
 	static const SettingsDefinition DisplayCloseMissesDef;			///< Definitions for the flag which toggles display of close misses.
 	static const SettingsDefinition DisplayCloseMissPercentageDef;	///< Definitions for the flag which toggles display of close miss percentage.
+	static const SettingsDefinition DisplayRollingWindowsDef;		///< Definitions for the flag which toggles display of the rolling windows.
+	static const SettingsDefinition RollingWindowSizesDef;			///< Definitions for the comma separated list of rolling window sizes.
 
 	static const SettingsDefinition AllShotXPositionDef;	///< Definitions for the X position of the all shot overlay
 	static const SettingsDefinition AllShotYPositionDef;	///< Definitions for the Y position of the all shot overlay
@@ -75,11 +89,23 @@ public:
 	static const char* KeybindingsArray[];								///< List of possible keybindings
 
 
-	static std::vector<std::string> OrderedStatsNames; ///< Contains all settings in display order
-	static std::mutex OrderedStatsMutex; ///< Required for thread safety
 	static const std::string OrderedStatsCVarName; ///< Name of the CVar for storing the display order
+
+	/** Retrieves the current display order of the stats. Never returns nullptr and may be called from any thread. */
+	static std::shared_ptr<const StatOrder> getStatOrder();
+	/** Retrieves the version of the current display order, which is cheaper than retrieving the order itself. */
+	static uint64_t getStatOrderVersion();
+	/** Publishes a new display order. Readers keep the previous order until they retrieve the order again. */
+	static void setStatOrder(std::vector<std::string> names);
+
+private:
+	static std::shared_ptr<const StatOrder> _statOrder;		///< The current display order. Only accessed through std::atomic_load() and std::atomic_store().
+	static std::atomic<uint64_t> _statOrderVersion;			///< A copy of the version of the current display order.
+	static std::mutex _statOrderWriteMutex;					///< Makes sure versions increase in the order of publishing. Readers never lock it.
 };
 
 
 std::string vector_to_string(const std::vector<std::string>& values);
-std::vector<std::string> string_to_vector(const std::string& vectorAsString);
\ No newline at end of file
+std::vector<std::string> string_to_vector(const std::string& vectorAsString);
+/** Converts a comma separated list like "10,25,50" to window sizes. Invalid and duplicate sizes are skipped, and the result is sorted. */
+std::vector<int> string_to_window_sizes(const std::string& windowSizesAsString);
\ No newline at end of file
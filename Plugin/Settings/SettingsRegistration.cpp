@@ -7,14 +7,16 @@
 
 // These macros just remove the syntactic overhead of extremely similar lambda function definitions
 // If you are a lowlevel template expert and you know a better solution, feel free to propose a pull request ;-)
-#define SET_BOOL_VALUE_FUNC(propertyName) [pluginState](bool value) { pluginState->propertyName = value; }
-#define SET_INT_VALUE_FUNC(propertyName) [pluginState](int value) { pluginState->propertyName = value; }
-#define SET_FLOAT_VALUE_FUNC(propertyName) [pluginState](float value) { pluginState->propertyName = value; }
+// Every setter increases the settings version, so cached display data gets rebuilt
+#define SET_BOOL_VALUE_FUNC(propertyName) [pluginState](bool value) { pluginState->propertyName = value; pluginState->SettingsVersion++; }
+#define SET_INT_VALUE_FUNC(propertyName) [pluginState](int value) { pluginState->propertyName = value; pluginState->SettingsVersion++; }
+#define SET_FLOAT_VALUE_FUNC(propertyName) [pluginState](float value) { pluginState->propertyName = value; pluginState->SettingsVersion++; }
 #define SET_COLOR_VALUE_FUNC(propertyName) [pluginState](const LinearColor& value) { \
 	pluginState->propertyName.R = value.R * 255.0f; \
 	pluginState->propertyName.G = value.G * 255.0f; \
 	pluginState->propertyName.B = value.B * 255.0f; \
 	pluginState->propertyName.A = value.A * 255.0f; \
+	pluginState->SettingsVersion++; \
 	}
 
 bool indexIsValid(const std::string& indexString, int& outVar)
@@ -73,6 +75,7 @@ void SettingsRegistration::registerCVars(
 	registerCheckboxSetting(persistentStorage, GoalPercentageCounterSettings::RecordingIconShallBeDisplayedDef, SET_BOOL_VALUE_FUNC(RecordingIconShallBeDisplayed));
 	registerCheckboxSetting(persistentStorage, GoalPercentageCounterSettings::StatsShallBeComparedToAllTimePeakDef, [pluginState, sendNotifierFunc](bool newValue) {
 		pluginState->StatsShallBeComparedToAllTimePeak = newValue;
+		pluginState->SettingsVersion++;
 		// Send a trigger so the compare base is getting updated in the StatUpdater
 		sendNotifierFunc(TriggerNames::CompareBaseChanged);
 	});
@@ -101,6 +104,13 @@ void SettingsRegistration::registerCVars(
 	registerCheckboxSetting(persistentStorage, GoalPercentageCounterSettings::DisplayFlipResetPercentageDef, SET_BOOL_VALUE_FUNC(FlipResetPercentageShallBeDisplayed));
 	registerCheckboxSetting(persistentStorage, GoalPercentageCounterSettings::DisplayCloseMissesDef, SET_BOOL_VALUE_FUNC(CloseMissesShallBeDisplayed));
 	registerCheckboxSetting(persistentStorage, GoalPercentageCounterSettings::DisplayCloseMissPercentageDef, SET_BOOL_VALUE_FUNC(CloseMissPercentageShallBeDisplayed));
+	registerCheckboxSetting(persistentStorage, GoalPercentageCounterSettings::DisplayRollingWindowsDef, SET_BOOL_VALUE_FUNC(RollingWindowsShallBeDisplayed));
+	registerTextSetting(persistentStorage, GoalPercentageCounterSettings::RollingWindowSizesDef, [pluginState, sendNotifierFunc](const std::string& value) {
+		pluginState->RollingWindowSizes = string_to_window_sizes(value);
+		pluginState->SettingsVersion++;
+		// Send a trigger so the windows of the current session are getting updated in the StatUpdater
+		sendNotifierFunc(TriggerNames::RollingWindowsChanged);
+	});
 
 	registerCheckboxSetting(persistentStorage, GoalPercentageCounterSettings::DisplayAllShotStats, SET_BOOL_VALUE_FUNC(AllShotStatsShallBeDisplayed));
 	registerIntSliderSetting(persistentStorage, GoalPercentageCounterSettings::AllShotXPositionDef, SET_INT_VALUE_FUNC(AllShotsOpts.OverlayXPosition));
@@ -109,6 +119,7 @@ void SettingsRegistration::registerCVars(
 		pluginState->AllShotsOpts.TextSizeFactor = value;
 		pluginState->AllShotsOpts.TextWidthFactor = 2.0f * value;
 		pluginState->AllShotsOpts.TextHeightFactor = 1.5f * value;
+		pluginState->SettingsVersion++;
 		});
 
 	registerCheckboxSetting(persistentStorage, GoalPercentageCounterSettings::DisplayPerShotStats, SET_BOOL_VALUE_FUNC(PerShotStatsShallBeDisplayed));
@@ -118,6 +129,7 @@ void SettingsRegistration::registerCVars(
 		pluginState->PerShotOpts.TextSizeFactor = value;
 		pluginState->PerShotOpts.TextWidthFactor = 2.0f * value;
 		pluginState->PerShotOpts.TextHeightFactor = 1.5f * value;
+		pluginState->SettingsVersion++;
 		});
 
 	registerColorEditSetting(persistentStorage, GoalPercentageCounterSettings::PanelColorDef, SET_COLOR_VALUE_FUNC(PanelColor));
@@ -145,14 +157,11 @@ void SettingsRegistration::registerCVars(
 		handleBindingChange(cvarManager, oldValue, cvar, std::string{ TriggerNames::ToggleImpactLocationDisplay } + ";");
 	});
 
-	{
-		std::scoped_lock lock(GoalPercentageCounterSettings::OrderedStatsMutex);
-		persistentStorage->RegisterPersistentCvar(
-			GoalPercentageCounterSettings::OrderedStatsCVarName,
-			vector_to_string(GoalPercentageCounterSettings::OrderedStatsNames),
-			"The order of stats"
-		);
-	}
+	persistentStorage->RegisterPersistentCvar(
+		GoalPercentageCounterSettings::OrderedStatsCVarName,
+		vector_to_string(GoalPercentageCounterSettings::getStatOrder()->Names),
+		"The order of stats"
+	);
 }
 
 #undef SET_BOOL_VALUE_FUNC
@@ -193,6 +202,11 @@ void SettingsRegistration::registerColorEditSetting(std::shared_ptr<PersistentSt
 	registerCVar(persistentStorage, settingsDefinition).addOnValueChanged([setValueFunc](const std::string&, CVarWrapper cvar) { setValueFunc(cvar.getColorValue()); });
 }
 
+void SettingsRegistration::registerTextSetting(std::shared_ptr<PersistentStorage> persistentStorage, const SettingsDefinition& settingsDefinition, std::function<void(const std::string&)> setValueFunc)
+{
+	registerCVar(persistentStorage, settingsDefinition).addOnValueChanged([setValueFunc](const std::string&, CVarWrapper cvar) { setValueFunc(cvar.getStringValue()); });
+}
+
 void SettingsRegistration::registerDropdownMenuSetting(std::shared_ptr<PersistentStorage> persistentStorage, const SettingsDefinition& settingsDefinition, std::function<void(const std::string&, CVarWrapper)> handleDropdown)
 {
 	registerCVar(persistentStorage, settingsDefinition).addOnValueChanged([handleDropdown](const std::string& oldValue, CVarWrapper cvar) { handleDropdown(oldValue, cvar); });
@@ -24,6 +24,8 @@ private:
 	static void registerFloatSliderSetting(std::shared_ptr<PersistentStorage> persistentStorage, const SettingsDefinition& settingsDefinition, std::function<void(float)> setValueFunc);
 	/** Registers a variable for a color value. */
 	static void registerColorEditSetting(std::shared_ptr<PersistentStorage> persistentStorage, const SettingsDefinition& settingsDefinition, std::function<void(const LinearColor&)> setValueFunc);
+	/** Registers a variable for a text input. */
+	static void registerTextSetting(std::shared_ptr<PersistentStorage> persistentStorage, const SettingsDefinition& settingsDefinition, std::function<void(const std::string&)> setValueFunc);
 	/** Registers a variable for a drop down menu. */
 	static void registerDropdownMenuSetting(std::shared_ptr<PersistentStorage> persistentStorage, const SettingsDefinition& settingsDefinition, std::function<void(const std::string&, CVarWrapper)> handleDropdown);
 
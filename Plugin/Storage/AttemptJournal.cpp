@@ -0,0 +1,206 @@
+#include <pch.h>
+#include "AttemptJournal.h"
+#include "StatFileDefs.h"
+
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable_v<AttemptJournalRecord>, "Journal records are written and read as raw bytes");
+
+const uint32_t JournalMagic = 0x4A435047; // "GPCJ"
+
+/** Every journal starts with this header. Journals with a different record size were written by a different version of the plugin and are ignored. */
+struct AttemptJournalHeader
+{
+	uint32_t Magic;
+	uint32_t RecordSize;
+};
+
+// FNV-1a hash over everything but the checksum itself
+uint32_t calculateChecksum(const AttemptJournalRecord& record)
+{
+	auto bytes = reinterpret_cast<const unsigned char*>(&record);
+	uint32_t hash = 2166136261u;
+	for (size_t index = 0; index < offsetof(AttemptJournalRecord, Checksum); index++)
+	{
+		hash ^= bytes[index];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+AttemptJournalStats toJournalStats(const StatsData& statsData)
+{
+	AttemptJournalStats journalStats;
+	journalStats.Attempts = statsData.Stats.Attempts;
+	journalStats.Goals = statsData.Stats.Goals;
+	journalStats.InitialHits = statsData.Stats.InitialHits;
+	journalStats.GoalStreakCounter = statsData.Stats.GoalStreakCounter;
+	journalStats.MissStreakCounter = statsData.Stats.MissStreakCounter;
+	journalStats.LongestGoalStreak = statsData.Stats.LongestGoalStreak;
+	journalStats.LongestMissStreak = statsData.Stats.LongestMissStreak;
+	journalStats.MaxAirDribbleTouches = statsData.Stats.MaxAirDribbleTouches;
+	journalStats.DoubleTapGoals = statsData.Stats.DoubleTapGoals;
+	journalStats.TotalFlipResets = statsData.Stats.TotalFlipResets;
+	journalStats.MaxFlipResets = statsData.Stats.MaxFlipResets;
+	journalStats.FlipResetAttemptsScored = statsData.Stats.FlipResetAttemptsScored;
+	journalStats.CloseMisses = statsData.Stats.CloseMisses;
+	journalStats.MaxAirDribbleTime = statsData.Stats.MaxAirDribbleTime;
+	journalStats.MaxGroundDribbleTime = statsData.Stats.MaxGroundDribbleTime;
+
+	// Store the shots rather than the ring buffer, so the record does not depend on how RecentShotWindow is implemented
+	const auto& recentShots = statsData.Stats.RecentShots;
+	journalStats.NumberOfRecentShots = (uint32_t)recentShots.size();
+	for (size_t wordIndex = 0; wordIndex < recentShots.NumberOfWords; wordIndex++)
+	{
+		journalStats.RecentShots[wordIndex] = recentShots.getPackedWord(wordIndex);
+	}
+	journalStats.Data = statsData.Data;
+	return journalStats;
+}
+
+void applyJournalStats(const AttemptJournalStats& journalStats, StatsData& statsData)
+{
+	statsData.Stats.Attempts = journalStats.Attempts;
+	statsData.Stats.Goals = journalStats.Goals;
+	statsData.Stats.InitialHits = journalStats.InitialHits;
+	statsData.Stats.GoalStreakCounter = journalStats.GoalStreakCounter;
+	statsData.Stats.MissStreakCounter = journalStats.MissStreakCounter;
+	statsData.Stats.LongestGoalStreak = journalStats.LongestGoalStreak;
+	statsData.Stats.LongestMissStreak = journalStats.LongestMissStreak;
+	statsData.Stats.MaxAirDribbleTouches = journalStats.MaxAirDribbleTouches;
+	statsData.Stats.DoubleTapGoals = journalStats.DoubleTapGoals;
+	statsData.Stats.TotalFlipResets = journalStats.TotalFlipResets;
+	statsData.Stats.MaxFlipResets = journalStats.MaxFlipResets;
+	statsData.Stats.FlipResetAttemptsScored = journalStats.FlipResetAttemptsScored;
+	statsData.Stats.CloseMisses = journalStats.CloseMisses;
+	statsData.Stats.MaxAirDribbleTime = journalStats.MaxAirDribbleTime;
+	statsData.Stats.MaxGroundDribbleTime = journalStats.MaxGroundDribbleTime;
+
+	auto& recentShots = statsData.Stats.RecentShots;
+	recentShots.clear();
+	for (size_t wordIndex = 0; wordIndex < recentShots.NumberOfWords; wordIndex++)
+	{
+		auto firstShotIndex = wordIndex * recentShots.BitsPerWord;
+		if (firstShotIndex >= journalStats.NumberOfRecentShots) { break; }
+
+		recentShots.pushPackedWord(journalStats.RecentShots[wordIndex], journalStats.NumberOfRecentShots - firstShotIndex);
+	}
+	statsData.Data = journalStats.Data;
+}
+
+std::filesystem::path AttemptJournal::getJournalPath(const std::filesystem::path& sessionFilePath)
+{
+	auto journalPath = sessionFilePath;
+	return journalPath.replace_extension(StatFileDefs::JournalFileExtension);
+}
+
+AttemptJournalRecord AttemptJournal::createRecord(const ShotStats& stats, int shotIndex, bool goalSpeedWasAdded, const std::vector<Vector>& newImpactLocations)
+{
+	// Clear the padding bytes as well so they don't end up as random data in the file
+	AttemptJournalRecord record;
+	std::memset(&record, 0, sizeof(record));
+
+	record.NumberOfShots = (int32_t)stats.PerShotStats.size();
+	record.ShotIndex = shotIndex;
+	record.Summary = toJournalStats(stats.AllShotStats);
+	record.Shot = toJournalStats(stats.PerShotStats.at(shotIndex));
+
+	record.HasGoalSpeed = goalSpeedWasAdded ? 1 : 0;
+	record.GoalSpeed = goalSpeedWasAdded ? stats.AllShotStats.Stats.GoalSpeed.MostRecent : .0f;
+
+	record.NumberOfImpactLocations = (int32_t)std::min<size_t>(newImpactLocations.size(), AttemptJournalRecord::MaxImpactLocations);
+	for (int index = 0; index < record.NumberOfImpactLocations; index++)
+	{
+		record.ImpactLocations[index] = newImpactLocations[index];
+	}
+
+	record.Checksum = calculateChecksum(record);
+	return record;
+}
+
+bool AttemptJournal::applyRecord(const AttemptJournalRecord& record, ShotStats& stats, std::vector<Vector>* impactLocations)
+{
+	// Records which are already part of the stats, or which belong to a different state of the session (e.g. before a reset) are ignored
+	if (record.NumberOfShots != (int32_t)stats.PerShotStats.size() ||
+		record.ShotIndex < 0 || record.ShotIndex >= record.NumberOfShots ||
+		record.Summary.Attempts != stats.AllShotStats.Stats.Attempts + 1)
+	{
+		return false;
+	}
+
+	auto& shotStats = stats.PerShotStats[record.ShotIndex];
+	applyJournalStats(record.Summary, stats.AllShotStats);
+	applyJournalStats(record.Shot, shotStats);
+
+	if (record.HasGoalSpeed != 0)
+	{
+		stats.insertGoalSpeed(record.ShotIndex, record.GoalSpeed);
+	}
+
+	if (impactLocations)
+	{
+		for (int index = 0; index < record.NumberOfImpactLocations && index < AttemptJournalRecord::MaxImpactLocations; index++)
+		{
+			impactLocations->push_back(record.ImpactLocations[index]);
+		}
+	}
+	return true;
+}
+
+bool AttemptJournal::appendRecord(const std::filesystem::path& journalPath, const AttemptJournalRecord& record)
+{
+	std::error_code errorCode;
+	auto journalIsEmpty = !std::filesystem::exists(journalPath, errorCode) || std::filesystem::file_size(journalPath, errorCode) == 0;
+
+	std::ofstream journalStream(journalPath, std::ios::out | std::ios::binary | std::ios::app);
+	if (journalStream.fail()) { return false; }
+
+	if (journalIsEmpty)
+	{
+		AttemptJournalHeader header = { JournalMagic, (uint32_t)sizeof(AttemptJournalRecord) };
+		journalStream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	}
+	journalStream.write(reinterpret_cast<const char*>(&record), sizeof(record));
+
+	// Make sure the record is on disk before the next attempt starts
+	journalStream.flush();
+	return !journalStream.fail();
+}
+
+std::vector<AttemptJournalRecord> AttemptJournal::readRecords(const std::filesystem::path& journalPath)
+{
+	std::vector<AttemptJournalRecord> records;
+
+	std::ifstream journalStream(journalPath, std::ios::in | std::ios::binary);
+	if (journalStream.fail()) { return records; }
+
+	AttemptJournalHeader header;
+	if (!journalStream.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+		header.Magic != JournalMagic ||
+		header.RecordSize != sizeof(AttemptJournalRecord))
+	{
+		return records;
+	}
+
+	AttemptJournalRecord record;
+	while (journalStream.read(reinterpret_cast<char*>(&record), sizeof(record)))
+	{
+		if (record.Checksum != calculateChecksum(record))
+		{
+			// The plugin or the game must have crashed while writing this record
+			break;
+		}
+		records.push_back(record);
+	}
+	// Else: The last record might have been written partially, which is ignored just like a corrupt one
+
+	return records;
+}
+
+void AttemptJournal::removeJournal(const std::filesystem::path& journalPath)
+{
+	std::error_code errorCode;
+	std::filesystem::remove(journalPath, errorCode);
+}
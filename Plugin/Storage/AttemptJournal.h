@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include <bakkesmod/wrappers/wrapperstructs.h>
+
+#include "../DLLImportExport.h"
+#include "../Data/ShotStats.h"
+
+/** Stores the absolute values of a StatsData object at the time an attempt was finished. Goal speed values are not part of this since they
+ * can only be appended, which is done through AttemptJournalRecord::GoalSpeed.
+ */
+struct AttemptJournalStats
+{
+	int32_t Attempts;
+	int32_t Goals;
+	int32_t InitialHits;
+	int32_t GoalStreakCounter;
+	int32_t MissStreakCounter;
+	int32_t LongestGoalStreak;
+	int32_t LongestMissStreak;
+	int32_t MaxAirDribbleTouches;
+	int32_t DoubleTapGoals;
+	int32_t TotalFlipResets;
+	int32_t MaxFlipResets;
+	int32_t FlipResetAttemptsScored;
+	int32_t CloseMisses;
+	float MaxAirDribbleTime;
+	float MaxGroundDribbleTime;
+	uint32_t NumberOfRecentShots;
+	uint64_t RecentShots[decltype(PlayerStats::RecentShots)::NumberOfWords];	///< The recent shots as packed by RecentShotWindow::getPackedWord(), oldest first.
+	CalculatedData Data;
+};
+
+/** A single, fixed size entry of the attempt journal. It describes the state of the summary and the affected shot after an attempt was finished. */
+struct AttemptJournalRecord
+{
+	static const int MaxImpactLocations = 4; ///< More impact locations than this require a full snapshot of the session.
+
+	int32_t NumberOfShots;
+	int32_t ShotIndex;
+	AttemptJournalStats Summary;
+	AttemptJournalStats Shot;
+	int32_t HasGoalSpeed;			///< 1 if GoalSpeed was inserted into the goal speed stats of both the summary and the shot.
+	float GoalSpeed;
+	int32_t NumberOfImpactLocations;
+	Vector ImpactLocations[MaxImpactLocations];
+	uint32_t Checksum;				///< Allows detecting records which were only partially written.
+};
+
+/** Reads and writes the per-session attempt journal.
+ *
+ * Rewriting the whole session file after every attempt gets more expensive the longer a session lasts. Instead, each finished attempt
+ * is appended as a small record to a journal next to the session file. The session file itself only gets rewritten from time to time,
+ * e.g. at the end of a session. A session can always be restored by reading the session file and replaying the journal records which
+ * continue it.
+ */
+class GOALPERCENTAGECOUNTER_IMPORT_EXPORT AttemptJournal
+{
+public:
+	/** Retrieves the path of the journal which belongs to the given session file. */
+	static std::filesystem::path getJournalPath(const std::filesystem::path& sessionFilePath);
+
+	/** Creates a record for an attempt which was finished on the given shot.
+	 *
+	 * \param	stats						The stats after the attempt was finished.
+	 * \param	shotIndex					The index of the shot the attempt was made on.
+	 * \param	goalSpeedWasAdded			True if the attempt added a goal speed value to the summary and the shot.
+	 * \param	newImpactLocations			The impact locations which were added during the attempt. Must not exceed MaxImpactLocations.
+	 */
+	static AttemptJournalRecord createRecord(const ShotStats& stats, int shotIndex, bool goalSpeedWasAdded, const std::vector<Vector>& newImpactLocations);
+
+	/** Applies the record to the given stats, if it continues them, i.e. if it describes the attempt right after the last one in the stats.
+	 *
+	 * \param	impactLocations		Receives the impact locations of the record. May be nullptr if they are not of interest.
+	 * \returns	True if the record was applied.
+	 */
+	static bool applyRecord(const AttemptJournalRecord& record, ShotStats& stats, std::vector<Vector>* impactLocations);
+
+	/** Appends the record to the journal at the given path. Creates the journal if necessary. */
+	static bool appendRecord(const std::filesystem::path& journalPath, const AttemptJournalRecord& record);
+
+	/** Reads all complete and intact records from the given journal. Reading stops at the first record which was not written completely. */
+	static std::vector<AttemptJournalRecord> readRecords(const std::filesystem::path& journalPath);
+
+	/** Removes the journal at the given path, if it exists. */
+	static void removeJournal(const std::filesystem::path& journalPath);
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+
+/** Reads values from a block of memory, e.g. a memory mapped file, without ever reading beyond its end.
+ *
+ * Values are copied with memcpy, so the memory does not need to be aligned. Any read which would exceed the block fails and returns false.
+ */
+class BinaryCursor
+{
+public:
+	BinaryCursor(const char* data, size_t size)
+		: _data(data)
+		, _size(size)
+	{
+	}
+
+	/** Reads a trivially copyable value and advances the cursor. */
+	template<typename T>
+	bool read(T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read from memory");
+		if (remaining() < sizeof(T)) { return false; }
+
+		std::memcpy(&value, _data + _offset, sizeof(T));
+		_offset += sizeof(T);
+		return true;
+	}
+
+	/** Skips the given amount of bytes. */
+	inline bool skip(size_t numberOfBytes)
+	{
+		if (remaining() < numberOfBytes) { return false; }
+		_offset += numberOfBytes;
+		return true;
+	}
+
+	/** Creates a cursor for the next numberOfBytes bytes and advances this cursor beyond them.
+	 * The returned cursor will be empty if there are less bytes available.
+	 */
+	inline BinaryCursor split(size_t numberOfBytes)
+	{
+		if (remaining() < numberOfBytes) { return BinaryCursor(nullptr, 0); }
+
+		BinaryCursor cursor(_data + _offset, numberOfBytes);
+		_offset += numberOfBytes;
+		return cursor;
+	}
+
+	/** Returns the amount of bytes which have not been read yet. */
+	inline size_t remaining() const { return _size - _offset; }
+
+private:
+	const char* _data;		///< The start of the memory block.
+	size_t _size;			///< The size of the memory block.
+	size_t _offset = 0;		///< The position of the next read, relative to _data.
+};
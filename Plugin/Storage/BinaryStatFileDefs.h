@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+
+/** Defines the layout of binary stat files, which are used from version 2.0 on.
+ *
+ * A binary stat file consists of
+ * - a header: magic number, major and minor version (uint16 each), number of shots, size of a record in bytes, number of sections (uint32 each),
+ * - a table of fixed-width records: one for the summary, followed by one for each shot,
+ * - a list of sections: section ID and length of the content in bytes (uint32 each), followed by the content.
+ *
+ * Readers ignore bytes at the end of a record and skip sections they don't know, so both can be extended without breaking older readers.
+ * Readers therefore accept any minor version. Only a change of the major version breaks compatibility.
+ * All values are stored in little endian byte order.
+ */
+class BinaryStatFileDefs
+{
+public:
+	static constexpr uint32_t Magic = 0x53435047; ///< The characters "GPCS" when stored in little endian byte order.
+	static constexpr uint16_t MajorVersion = 2;
+	static constexpr uint16_t MinorVersion = 3;
+
+	/** Identifies the sections which follow the record table. */
+	enum class SectionId : uint32_t
+	{
+		ImpactLocations = 1,	///< The impact locations of the session: The number of locations, followed by X, Y and Z (float) of each location.
+		GoalSpeedValues = 2,	///< For the summary and then each shot: The number of goal speed values, followed by the values (float).
+		/** Since 2.1. For the summary and then each shot: The number of recent shots, followed by as many uint64 as required for storing
+		 * one bit per shot, where bit 0 of the first value is the oldest shot. This replaces the recent shots which are stored in the record.
+		 */
+		RecentShots = 3,
+		/** Since 2.1. For the summary and then each shot: The number of rolling windows, followed by Size, Goals (int32 each),
+		 * Percentage, PeakPercentage (double each) and PeakShotNumber (int32) of each window.
+		 */
+		RollingWindows = 4,
+		/** Since 2.2. For the summary (2.2 also wrote one for each shot, which readers ignore): The number of goal speed values (uint32), the most recent value, min, max, mean and
+		 * sample variance (float each), and the number of levels of the QuantileSketch (uint32), followed by the number of values (uint32)
+		 * and the values (float) of each level. This allows reading bounded goal speed statistics without reading all goal speed values,
+		 * so it is written before the goal speed values.
+		 */
+		GoalSpeedSketches = 5,
+		/** Since 2.3. The heatmap of the impact locations, so it does not have to be recreated from them: The number of impact locations it
+		 * contains (uint32), the maximum value (float), and the number of X and Z brackets (uint32 each). For each X bracket, this is followed
+		 * by the first Z bracket and the number of Z brackets (uint16 each) which span all values other than zero, and those values (float).
+		 * Written after the impact locations, and ignored if the number of brackets or locations does not match.
+		 */
+		Heatmap = 6
+	};
+};
@@ -0,0 +1,241 @@
+#include <pch.h>
+#include "BinaryStatFileSerializer.h"
+#include "../Data/SketchedGoalSpeed.h"
+
+#include <algorithm>
+
+std::string_view BinaryStatFileSerializer::serialize(const ShotStats& stats, const std::vector<Vector>* impactLocations, const ImpactHeatmap* heatmap)
+{
+	_buffer.clear();
+	if (!impactLocations)
+	{
+		heatmap = nullptr; // The heatmap is only useful for restoring the impact locations
+	}
+
+	// Header. The record size gets updated once the first record was written
+	append(BinaryStatFileDefs::Magic);
+	append(BinaryStatFileDefs::MajorVersion);
+	append(BinaryStatFileDefs::MinorVersion);
+	append((uint32_t)stats.PerShotStats.size());
+	auto recordSizePosition = _buffer.size();
+	append((uint32_t)0);
+	append((uint32_t)(4 + (impactLocations ? 1 : 0) + (heatmap ? 1 : 0))); // Number of sections
+
+	// Record table
+	auto recordStartPosition = _buffer.size();
+	appendRecord(stats.AllShotStats);
+	overwrite(recordSizePosition, (uint32_t)(_buffer.size() - recordStartPosition));
+	for (const auto& shotStats : stats.PerShotStats)
+	{
+		appendRecord(shotStats);
+	}
+
+	// Sections
+	if (impactLocations)
+	{
+		// Shot locations are only available once for the session rather than for every shot. They are also not tracked for the all time peak stats.
+		appendImpactLocationSection(*impactLocations);
+	}
+	if (heatmap)
+	{
+		appendHeatmapSection(*heatmap, impactLocations->size());
+	}
+	appendGoalSpeedSketchSection(stats);
+	appendGoalSpeedSection(stats);
+	appendRecentShotSection(stats);
+	appendRollingWindowSection(stats);
+
+	return std::string_view(_buffer.data(), _buffer.size());
+}
+
+void BinaryStatFileSerializer::appendRecord(const StatsData& statsData)
+{
+	// Note: The order of the fields must match StatFileReader::readBinaryRecord(). New fields must be appended at the end.
+
+	// Player Stats
+	append((int32_t)statsData.Stats.Attempts);
+	append((int32_t)statsData.Stats.Goals);
+	append((int32_t)statsData.Stats.InitialHits);
+	append((int32_t)statsData.Stats.GoalStreakCounter);
+	append((int32_t)statsData.Stats.MissStreakCounter);
+	append((int32_t)statsData.Stats.LongestGoalStreak);
+	append((int32_t)statsData.Stats.LongestMissStreak);
+	append((int32_t)statsData.Stats.MaxAirDribbleTouches);
+	append((int32_t)statsData.Stats.DoubleTapGoals);
+	append((int32_t)statsData.Stats.MaxFlipResets);
+	append((int32_t)statsData.Stats.TotalFlipResets);
+	append((int32_t)statsData.Stats.FlipResetAttemptsScored);
+	append((int32_t)statsData.Stats.CloseMisses);
+	append(statsData.Stats.MaxAirDribbleTime);
+	append(statsData.Stats.MaxGroundDribbleTime);
+
+	// The last 64 shots, stored as bits where bit 0 is the oldest shot. Version 2.1 stores all recent shots in a section,
+	// but this is still written so version 2.0 readers can restore the last 50 shots
+	const auto& recentShots = statsData.Stats.RecentShots;
+	auto firstShotIndex = recentShots.size() > 64 ? recentShots.size() - 64 : 0;
+	append((uint32_t)(recentShots.size() - firstShotIndex));
+	append(recentShots.getPackedWord(0, firstShotIndex));
+
+	// Goal speed. Allows reading the statistics without the goal speed section, and stores the all time peak stats which don't have any values
+	const auto& goalSpeed = statsData.Stats.GoalSpeed;
+	append(goalSpeed.MostRecent);
+	append(goalSpeed.Max);
+	append(goalSpeed.Min);
+	append(goalSpeed.Median);
+	append(goalSpeed.Mean);
+
+	// Calculated stats
+	append(statsData.Data.SuccessPercentage);
+	append(statsData.Data.PeakSuccessPercentage);
+	append((int32_t)statsData.Data.PeakShotNumber);
+	append(statsData.Data.Last50ShotsPercentage);
+	append(statsData.Data.InitialHitPercentage);
+	append(statsData.Data.DoubleTapGoalPercentage);
+	append(statsData.Data.AverageFlipResetsPerAttempt);
+	append(statsData.Data.FlipResetGoalPercentage);
+	append(statsData.Data.CloseMissPercentage);
+}
+
+void BinaryStatFileSerializer::appendImpactLocationSection(const std::vector<Vector>& impactLocations)
+{
+	auto lengthPosition = beginSection(BinaryStatFileDefs::SectionId::ImpactLocations);
+	append((uint32_t)impactLocations.size());
+	for (const auto& impactLocation : impactLocations)
+	{
+		append(impactLocation.X);
+		append(impactLocation.Y);
+		append(impactLocation.Z);
+	}
+	finishSection(lengthPosition);
+}
+
+void BinaryStatFileSerializer::appendHeatmapSection(const ImpactHeatmap& heatmap, size_t numberOfImpactLocations)
+{
+	auto lengthPosition = beginSection(BinaryStatFileDefs::SectionId::Heatmap);
+	append((uint32_t)numberOfImpactLocations);
+	append(heatmap.getMaximumValue());
+	append((uint32_t)ImpactHeatmap::XBrackets);
+	append((uint32_t)ImpactHeatmap::ZBrackets);
+
+	// Impacts only cover a few brackets around them, so only the part of each row which is not zero gets stored
+	for (const auto& row : heatmap.getData())
+	{
+		auto firstValue = std::find_if(row.begin(), row.end(), [](float value) { return value != .0f; });
+		auto lastValue = std::find_if(row.rbegin(), row.rend(), [](float value) { return value != .0f; }).base();
+		auto firstIndex = (uint16_t)(firstValue - row.begin());
+		auto numberOfValues = firstValue < lastValue ? (uint16_t)(lastValue - firstValue) : (uint16_t)0;
+		append(firstIndex);
+		append(numberOfValues);
+		auto bytes = reinterpret_cast<const char*>(row.data() + firstIndex);
+		_buffer.insert(_buffer.end(), bytes, bytes + numberOfValues * sizeof(float));
+	}
+
+	finishSection(lengthPosition);
+}
+
+void BinaryStatFileSerializer::appendGoalSpeedSketchSection(const ShotStats& stats)
+{
+	auto lengthPosition = beginSection(BinaryStatFileDefs::SectionId::GoalSpeedSketches);
+
+	// Sketches are meant for combining the goal speed of several sessions, which is only done for the summary
+	SketchedGoalSpeed goalSpeed;
+	stats.getGoalSpeedValues(-1).mergeInto(goalSpeed);
+
+	const auto& sketch = goalSpeed.getSketch();
+	append((uint32_t)sketch.getCount());
+	append(goalSpeed.getMostRecent());
+	append(sketch.getMin());
+	append(sketch.getMax());
+	append(goalSpeed.getRunningMean().getMean());
+	append(goalSpeed.getRunningMean().getVariance());
+	append((uint32_t)sketch.getLevels().size());
+	for (const auto& levelValues : sketch.getLevels())
+	{
+		append((uint32_t)levelValues.size());
+		auto bytes = reinterpret_cast<const char*>(levelValues.data());
+		_buffer.insert(_buffer.end(), bytes, bytes + levelValues.size() * sizeof(float));
+	}
+
+	finishSection(lengthPosition);
+}
+
+void BinaryStatFileSerializer::appendGoalSpeedSection(const ShotStats& stats)
+{
+	auto lengthPosition = beginSection(BinaryStatFileDefs::SectionId::GoalSpeedValues);
+
+	auto appendGoalSpeedValues = [this](const GoalSpeed& goalSpeed) {
+		const auto& goalSpeedValues = goalSpeed.getValues();
+		append((uint32_t)goalSpeedValues.size());
+		auto bytes = reinterpret_cast<const char*>(goalSpeedValues.data());
+		_buffer.insert(_buffer.end(), bytes, bytes + goalSpeedValues.size() * sizeof(float));
+	};
+	// The values of the all shot stats come first, followed by the values of each shot
+	for (auto shotIndex = -1; shotIndex < (int)stats.PerShotStats.size(); shotIndex++)
+	{
+		appendGoalSpeedValues(stats.getGoalSpeedValues(shotIndex));
+	}
+
+	finishSection(lengthPosition);
+}
+
+void BinaryStatFileSerializer::appendRecentShotSection(const ShotStats& stats)
+{
+	auto lengthPosition = beginSection(BinaryStatFileDefs::SectionId::RecentShots);
+
+	auto appendRecentShots = [this](const StatsData& statsData) {
+		const auto& recentShots = statsData.Stats.RecentShots;
+		append((uint32_t)recentShots.size());
+		for (size_t wordIndex = 0; wordIndex * recentShots.BitsPerWord < recentShots.size(); wordIndex++)
+		{
+			append(recentShots.getPackedWord(wordIndex));
+		}
+	};
+	appendRecentShots(stats.AllShotStats);
+	for (const auto& shotStats : stats.PerShotStats)
+	{
+		appendRecentShots(shotStats);
+	}
+
+	finishSection(lengthPosition);
+}
+
+void BinaryStatFileSerializer::appendRollingWindowSection(const ShotStats& stats)
+{
+	auto lengthPosition = beginSection(BinaryStatFileDefs::SectionId::RollingWindows);
+
+	auto appendRollingWindows = [this](const StatsData& statsData) {
+		const auto& rollingWindows = statsData.Data.RollingWindows;
+		auto numberOfWindows = std::count_if(rollingWindows.begin(), rollingWindows.end(), [](const RollingWindow& window) { return window.Size > 0; });
+		append((uint32_t)numberOfWindows);
+		for (auto index = 0; index < numberOfWindows; index++)
+		{
+			const auto& window = rollingWindows[index];
+			append(window.Size);
+			append(window.Goals);
+			append(window.Percentage);
+			append(window.PeakPercentage);
+			append(window.PeakShotNumber);
+		}
+	};
+	appendRollingWindows(stats.AllShotStats);
+	for (const auto& shotStats : stats.PerShotStats)
+	{
+		appendRollingWindows(shotStats);
+	}
+
+	finishSection(lengthPosition);
+}
+
+size_t BinaryStatFileSerializer::beginSection(BinaryStatFileDefs::SectionId sectionId)
+{
+	append((uint32_t)sectionId);
+	auto lengthPosition = _buffer.size();
+	append((uint32_t)0);
+	return lengthPosition;
+}
+
+void BinaryStatFileSerializer::finishSection(size_t lengthPosition)
+{
+	auto sectionLength = _buffer.size() - lengthPosition - sizeof(uint32_t);
+	overwrite(lengthPosition, (uint32_t)sectionLength);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include <bakkesmod/wrappers/wrapperstructs.h>
+
+#include "../DLLImportExport.h"
+#include "../Data/ShotStats.h"
+#include "../Calculation/ImpactHeatmap.h"
+#include "BinaryStatFileDefs.h"
+
+/** Converts ShotStats objects into the binary format defined by BinaryStatFileDefs.
+ *
+ * Just like StatFileSerializer, the whole file gets created in a single memory buffer which is reused between calls.
+ */
+class GOALPERCENTAGECOUNTER_IMPORT_EXPORT BinaryStatFileSerializer
+{
+public:
+	BinaryStatFileSerializer() = default;
+
+	/** Converts the given stats and returns a view on the result. The view stays valid until serialize() gets called again.
+	 *
+	 * \param	stats				The stats to be converted.
+	 * \param	impactLocations		The impact locations of the session, or nullptr if they shall not be stored.
+	 * \param	heatmap				The heatmap of the impact locations, or nullptr if it shall not be stored. Ignored if impactLocations is nullptr.
+	 */
+	std::string_view serialize(const ShotStats& stats, const std::vector<Vector>* impactLocations, const ImpactHeatmap* heatmap = nullptr);
+
+private:
+	void appendRecord(const StatsData& statsData);
+	void appendImpactLocationSection(const std::vector<Vector>& impactLocations);
+	void appendHeatmapSection(const ImpactHeatmap& heatmap, size_t numberOfImpactLocations);
+	void appendGoalSpeedSketchSection(const ShotStats& stats);
+	void appendGoalSpeedSection(const ShotStats& stats);
+	void appendRecentShotSection(const ShotStats& stats);
+	void appendRollingWindowSection(const ShotStats& stats);
+
+	/** Appends a section header with an unknown length and returns the position of the length, so it can be updated by finishSection(). */
+	size_t beginSection(BinaryStatFileDefs::SectionId sectionId);
+	void finishSection(size_t lengthPosition);
+
+	/** Appends the raw bytes of the given value. */
+	template<typename T>
+	void append(T value)
+	{
+		auto bytes = reinterpret_cast<const char*>(&value);
+		_buffer.insert(_buffer.end(), bytes, bytes + sizeof(T));
+	}
+	/** Overwrites the raw bytes at the given position with the given value. */
+	template<typename T>
+	void overwrite(size_t position, T value)
+	{
+		std::memcpy(_buffer.data() + position, &value, sizeof(T));
+	}
+
+	std::vector<char> _buffer; ///< Stores the file content. Reused in order to avoid reallocating it for every write.
+};
@@ -0,0 +1,50 @@
+#include <pch.h>
+#include "MemoryMappedFile.h"
+
+MemoryMappedFile::MemoryMappedFile(const std::filesystem::path& filePath)
+{
+	// Don't share write access: The writer truncates files in place, which would change the mapped content while we decode it.
+	// Opening the file for writing fails instead while it is mapped, and the writer retries with its next write.
+	auto fileHandle = CreateFileW(
+		filePath.c_str(),
+		GENERIC_READ,
+		FILE_SHARE_READ | FILE_SHARE_DELETE,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+		nullptr
+	);
+	if (fileHandle == INVALID_HANDLE_VALUE) { return; }
+	_fileHandle = fileHandle;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart <= 0)
+	{
+		return; // Empty files can't be mapped, and there is nothing to read anyway
+	}
+
+	_mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!_mappingHandle) { return; }
+
+	auto view = MapViewOfFile(_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if (!view) { return; }
+
+	_data = static_cast<const char*>(view);
+	_size = (size_t)fileSize.QuadPart;
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+	if (_data)
+	{
+		UnmapViewOfFile(_data);
+	}
+	if (_mappingHandle)
+	{
+		CloseHandle(_mappingHandle);
+	}
+	if (_fileHandle)
+	{
+		CloseHandle(_fileHandle);
+	}
+}
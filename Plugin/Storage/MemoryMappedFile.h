@@ -0,0 +1,31 @@
+#pragma once
+
+#include <filesystem>
+
+/** Maps a file into memory for read-only access. The file stays mapped until the object gets destroyed.
+ *
+ * This allows decoding a file directly from the OS page cache, without copying it into a buffer first.
+ */
+class MemoryMappedFile
+{
+public:
+	/** Maps the file at the given path. Check isOpen() for whether or not this succeeded. Empty files can't be mapped. */
+	explicit MemoryMappedFile(const std::filesystem::path& filePath);
+	~MemoryMappedFile();
+
+	MemoryMappedFile(const MemoryMappedFile&) = delete;
+	MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+	/** Returns true if the file was mapped successfully. */
+	inline bool isOpen() const { return _data != nullptr; }
+	/** Retrieves the start of the file content. */
+	inline const char* data() const { return _data; }
+	/** Retrieves the size of the file content in bytes. */
+	inline size_t size() const { return _size; }
+
+private:
+	void* _fileHandle = nullptr;		///< The handle of the opened file. Stored as void* so Windows.h doesn't need to be included here.
+	void* _mappingHandle = nullptr;		///< The handle of the file mapping object.
+	const char* _data = nullptr;		///< The start of the mapped view.
+	size_t _size = 0;					///< The size of the mapped view.
+};
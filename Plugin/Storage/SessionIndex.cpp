@@ -0,0 +1,265 @@
+#include <pch.h>
+#include "SessionIndex.h"
+#include "StatFileDefs.h"
+
+#include <charconv>
+#include <fstream>
+#include <map>
+
+const std::string ManifestVersion = "1";
+
+// Retrieves the last write time of the given session or its journal, whichever is newer, as a plain number
+int64_t getSessionWriteTime(const std::filesystem::path& sessionFilePath)
+{
+	std::error_code errorCode;
+	auto lastWriteTime = std::filesystem::last_write_time(sessionFilePath, errorCode);
+	auto journalWriteTime = std::filesystem::last_write_time(std::filesystem::path(sessionFilePath).replace_extension(StatFileDefs::JournalFileExtension), errorCode);
+	if (!errorCode && journalWriteTime > lastWriteTime)
+	{
+		lastWriteTime = journalWriteTime;
+	}
+	return (int64_t)lastWriteTime.time_since_epoch().count();
+}
+
+// Retrieves the last write time of the given folder as a plain number. It changes whenever a file gets added to or removed from the folder
+int64_t getFolderWriteTime(const std::filesystem::path& folderPath)
+{
+	std::error_code errorCode;
+	return (int64_t)std::filesystem::last_write_time(folderPath, errorCode).time_since_epoch().count();
+}
+
+// Splits a tab separated line of the manifest into its values
+std::vector<std::string_view> splitManifestLine(std::string_view line)
+{
+	std::vector<std::string_view> values;
+	size_t start = 0;
+	for (auto end = line.find('\t'); end != std::string_view::npos; end = line.find('\t', start))
+	{
+		values.push_back(line.substr(start, end - start));
+		start = end + 1;
+	}
+	values.push_back(line.substr(start));
+	return values;
+}
+
+template<typename T>
+bool parseManifestValue(std::string_view text, T& value)
+{
+	auto [end, errorCode] = std::from_chars(text.data(), text.data() + text.size(), value);
+	return errorCode == std::errc() && end == text.data() + text.size();
+}
+
+const std::vector<SessionIndexEntry>& SessionIndex::getEntries(const std::filesystem::path& folderPath, const std::string& trainingPackFileName, const SummaryReader& readSummary)
+{
+	// The entries of the loaded folder are kept up to date by updateEntry(), so the files only need to be checked if the folder has changed
+	if (folderPath != _folderPath || getFolderWriteTime(folderPath) != _folderWriteTime)
+	{
+		refreshEntries(folderPath, trainingPackFileName, readSummary);
+	}
+	return _entries;
+}
+
+const SessionIndexEntry* SessionIndex::findEntry(const std::filesystem::path& sessionFilePath) const
+{
+	if (_folderPath.empty() || sessionFilePath.parent_path() != _folderPath)
+	{
+		return nullptr;
+	}
+
+	// The entries are sorted in descending order
+	auto fileName = sessionFilePath.filename().u8string();
+	auto iterator = std::lower_bound(_entries.begin(), _entries.end(), fileName, [](const SessionIndexEntry& entry, const std::string& value) {
+		return entry.FileName > value;
+	});
+	if (iterator == _entries.end() || iterator->FileName != fileName)
+	{
+		return nullptr;
+	}
+	return &*iterator;
+}
+
+void SessionIndex::updateEntry(const std::filesystem::path& sessionFilePath, int attempts, int goals, int numberOfShots, const std::string& version, bool persist)
+{
+	if (_folderPath.empty() || sessionFilePath.parent_path() != _folderPath)
+	{
+		return;
+	}
+
+	auto fileName = sessionFilePath.filename().u8string();
+	auto iterator = std::lower_bound(_entries.begin(), _entries.end(), fileName, [](const SessionIndexEntry& entry, const std::string& value) {
+		return entry.FileName > value;
+	});
+	if (iterator == _entries.end() || iterator->FileName != fileName)
+	{
+		iterator = _entries.insert(iterator, SessionIndexEntry());
+		iterator->FileName = fileName;
+		_manifestIsOutdated = true;
+	}
+
+	if (iterator->Attempts != attempts || iterator->Goals != goals || iterator->NumberOfShots != numberOfShots || iterator->Version != version)
+	{
+		iterator->Attempts = attempts;
+		iterator->Goals = goals;
+		iterator->NumberOfShots = numberOfShots;
+		iterator->Version = version;
+		_manifestIsOutdated = true;
+	}
+
+	if (persist)
+	{
+		// Only remember the write time when the entry is persisted, so that entries which were not persisted get detected as outdated.
+		// If the entry was persisted with the same values already, the manifest stays as it is. Should it get written for a different
+		// reason later on, it will contain the new write time
+		iterator->LastWriteTime = getSessionWriteTime(sessionFilePath);
+		if (_manifestIsOutdated)
+		{
+			writeManifest();
+		}
+	}
+}
+
+void SessionIndex::refreshEntries(const std::filesystem::path& folderPath, const std::string& trainingPackFileName, const SummaryReader& readSummary)
+{
+	// The entries of the loaded folder are as recent as the manifest, or even more recent
+	std::vector<SessionIndexEntry> knownEntries;
+	auto folderIsLoaded = folderPath == _folderPath;
+	if (folderIsLoaded)
+	{
+		knownEntries = std::move(_entries);
+	}
+	_folderPath = folderPath;
+	_entries.clear();
+
+	// Find all sessions and the time they were last changed. Journals count as a change of their session
+	std::map<std::string, int64_t, std::greater<>> sessionWriteTimes;
+	std::map<std::string, int64_t> journalWriteTimes;
+	try
+	{
+		for (const auto& directoryEntry : std::filesystem::directory_iterator(folderPath))
+		{
+			if (!directoryEntry.is_regular_file()) { continue; }
+
+			const auto& filePath = directoryEntry.path();
+			auto extension = filePath.extension().u8string();
+			auto lastWriteTime = (int64_t)directoryEntry.last_write_time().time_since_epoch().count();
+			if (extension == StatFileDefs::JournalFileExtension)
+			{
+				journalWriteTimes[filePath.stem().u8string()] = lastWriteTime;
+			}
+			else if ((extension == StatFileDefs::TextFileExtension || extension == StatFileDefs::BinaryFileExtension) &&
+				filePath.filename().u8string() != trainingPackFileName)
+			{
+				sessionWriteTimes[filePath.filename().u8string()] = lastWriteTime;
+			}
+		}
+	}
+	catch (const std::filesystem::filesystem_error&)
+	{
+		// treat this case like there would be no files
+		return;
+	}
+
+	if (!folderIsLoaded)
+	{
+		// Changes which were not persisted in the previous folder are detected by their write time when it gets loaded again
+		_manifestIsOutdated = false;
+		knownEntries = readManifest();
+	}
+	std::map<std::string, SessionIndexEntry> manifestEntries;
+	for (auto& entry : knownEntries)
+	{
+		manifestEntries.emplace(entry.FileName, std::move(entry));
+	}
+
+	// Reuse every entry which is still up to date, and only read the sessions which are not. This also drops the entries of removed sessions
+	if (manifestEntries.size() != sessionWriteTimes.size())
+	{
+		_manifestIsOutdated = true;
+	}
+	for (const auto& [fileName, sessionWriteTime] : sessionWriteTimes)
+	{
+		auto lastWriteTime = sessionWriteTime;
+		auto journalIterator = journalWriteTimes.find(std::filesystem::u8path(fileName).stem().u8string());
+		if (journalIterator != journalWriteTimes.end())
+		{
+			lastWriteTime = std::max<int64_t>(lastWriteTime, journalIterator->second);
+		}
+
+		auto manifestIterator = manifestEntries.find(fileName);
+		if (manifestIterator != manifestEntries.end() && manifestIterator->second.LastWriteTime == lastWriteTime)
+		{
+			_entries.push_back(std::move(manifestIterator->second));
+			continue;
+		}
+
+		// Invalid files stay in the manifest as well so they don't get read again every time
+		SessionIndexEntry entry;
+		if (!readSummary(folderPath / std::filesystem::u8path(fileName), entry))
+		{
+			entry = SessionIndexEntry();
+		}
+		entry.FileName = fileName;
+		entry.LastWriteTime = lastWriteTime;
+		_entries.push_back(std::move(entry));
+		_manifestIsOutdated = true;
+	}
+
+	if (_manifestIsOutdated)
+	{
+		writeManifest();
+	}
+
+	// Creating the manifest changes the folder as well
+	_folderWriteTime = getFolderWriteTime(folderPath);
+}
+
+std::vector<SessionIndexEntry> SessionIndex::readManifest() const
+{
+	std::vector<SessionIndexEntry> entries;
+
+	std::ifstream fileStream(_folderPath / std::filesystem::u8path(StatFileDefs::SessionIndexFileName));
+	if (fileStream.fail()) { return entries; }
+
+	// The manifest can always be rebuilt from the sessions, so anything unexpected just discards it
+	std::string currentLine;
+	if (!std::getline(fileStream, currentLine) || currentLine != fmt::format("{}\t{}", StatFileDefs::Version, ManifestVersion))
+	{
+		return entries;
+	}
+
+	while (std::getline(fileStream, currentLine))
+	{
+		auto values = splitManifestLine(currentLine);
+		SessionIndexEntry entry;
+		if (values.size() != 6 ||
+			!parseManifestValue(values[1], entry.LastWriteTime) ||
+			!parseManifestValue(values[2], entry.Attempts) ||
+			!parseManifestValue(values[3], entry.Goals) ||
+			!parseManifestValue(values[4], entry.NumberOfShots))
+		{
+			return {};
+		}
+		entry.FileName = std::string(values[0]);
+		entry.Version = std::string(values[5]);
+		entries.push_back(std::move(entry));
+	}
+	return entries;
+}
+
+void SessionIndex::writeManifest()
+{
+	fmt::memory_buffer buffer;
+	fmt::format_to(buffer, "{}\t{}\n", StatFileDefs::Version, ManifestVersion);
+	for (const auto& entry : _entries)
+	{
+		fmt::format_to(buffer, "{}\t{}\t{}\t{}\t{}\t{}\n", entry.FileName, entry.LastWriteTime, entry.Attempts, entry.Goals, entry.NumberOfShots, entry.Version);
+	}
+
+	std::ofstream fileStream(_folderPath / std::filesystem::u8path(StatFileDefs::SessionIndexFileName), std::ios::out | std::ios::trunc | std::ios::binary);
+	if (fileStream.fail())
+	{
+		return; // The manifest will simply be rebuilt next time
+	}
+	fileStream.write(buffer.data(), buffer.size());
+	_manifestIsOutdated = fileStream.fail();
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../DLLImportExport.h"
+
+/** Describes a single session file of a training pack, without having to open it. */
+struct SessionIndexEntry
+{
+	std::string FileName;			///< The name of the session file, without the folder.
+	int64_t LastWriteTime = 0;		///< The last write time of the session file or its journal, whichever is newer. Used for detecting outdated entries.
+	int Attempts = 0;				///< The number of attempts, including the ones which are only stored in the journal.
+	int Goals = 0;
+	int NumberOfShots = 0;
+	std::string Version;			///< The version of the file format.
+};
+
+/** Keeps a small manifest of all sessions of a training pack, so looking up previous sessions does not require opening every session file.
+ *
+ * The manifest is stored next to the sessions. It gets loaded the first time the sessions of a training pack are requested, and checked
+ * against the last write times of the files in the folder at that point. Only sessions which were added or changed since the manifest was
+ * written get read again. After that, the stat writer keeps the entries up to date, so looking up sessions does not touch the files.
+ * Only if the last write time of the folder changes, i.e. if files were added or removed, the entries get checked against the files again.
+ */
+class GOALPERCENTAGECOUNTER_IMPORT_EXPORT SessionIndex
+{
+public:
+	/** Reads the summary of the session file at the given path into the given entry. Returns false if the file is no valid session. */
+	using SummaryReader = std::function<bool(const std::filesystem::path& sessionFilePath, SessionIndexEntry& entry)>;
+
+	/** Retrieves the entries of all sessions in the given folder, the most recent session first.
+	 *
+	 * \param	folderPath				The folder of the training pack.
+	 * \param	trainingPackFileName	The name of the all time peak file in that folder, which is no session.
+	 * \param	readSummary				Used for reading sessions which are not part of the manifest yet, or which have changed since.
+	 */
+	const std::vector<SessionIndexEntry>& getEntries(const std::filesystem::path& folderPath, const std::string& trainingPackFileName, const SummaryReader& readSummary);
+
+	/** Retrieves the entry of the given session file, or nullptr if it is not part of the currently loaded folder. */
+	const SessionIndexEntry* findEntry(const std::filesystem::path& sessionFilePath) const;
+
+	/** Adds or updates the entry of the given session file. Sessions of a folder which is not currently loaded are ignored, since they will be
+	 * read again when that folder gets loaded.
+	 *
+	 * \param	persist		True if the manifest shall be written, too. It only gets written if an entry has changed since it was written last.
+	 *						Changes which are not persisted are still picked up when the folder gets loaded next time, since the last write time
+	 *						of the session will differ from the one in the manifest.
+	 */
+	void updateEntry(const std::filesystem::path& sessionFilePath, int attempts, int goals, int numberOfShots, const std::string& version, bool persist);
+
+private:
+	/** Brings the entries up to date with the files in the given folder. The manifest only gets read if the folder is not loaded yet. */
+	void refreshEntries(const std::filesystem::path& folderPath, const std::string& trainingPackFileName, const SummaryReader& readSummary);
+	/** Reads the manifest of the current folder. Returns an empty list if it is missing or invalid. */
+	std::vector<SessionIndexEntry> readManifest() const;
+	/** Writes the manifest of the current folder. */
+	void writeManifest();
+
+	std::filesystem::path _folderPath;			///< The training pack folder the entries belong to. Empty until a folder was loaded.
+	std::vector<SessionIndexEntry> _entries;	///< The sessions of the folder, sorted by file name in descending order (i.e. the most recent session first).
+	int64_t _folderWriteTime = 0;				///< The last write time of the folder when the entries were checked against its files.
+	bool _manifestIsOutdated = false;			///< True if an entry has changed since the manifest was written.
+};
@@ -0,0 +1,255 @@
+#include <pch.h>
+#include "SessionPrefetchCache.h"
+
+#include <algorithm>
+
+SessionPrefetchCache::SessionPrefetchCache(std::shared_ptr<IStatReader> statReader, std::shared_ptr<ShotDistributionTracker> shotDistributionTracker, std::shared_ptr<StorageWorker> storageWorker)
+	: _statReader(statReader)
+	, _shotDistributionTracker(shotDistributionTracker)
+	, _storageWorker(storageWorker)
+{
+}
+
+void SessionPrefetchCache::prefetch(const std::string& trainingPackCode)
+{
+	if (trainingPackCode != _trainingPackCode)
+	{
+		// Anything of the previous training pack is of no use anymore, including requests and loads which are still pending
+		_trainingPackCode = trainingPackCode;
+		_previousSessions.clear();
+		_sessionsAreAvailable = false;
+		_peakStats = {};
+		_peakStatsAreAvailable = false;
+		_isLoading = false;
+		_numberOfLoads++;
+		_pendingRequests.clear();
+	}
+
+	if (_trainingPackCode.empty() || _isLoading || (_sessionsAreAvailable && _peakStatsAreAvailable)) { return; }
+
+	startLoading();
+}
+
+void SessionPrefetchCache::requestPreviousSession(const std::string& trainingPackCode, int numberOfSkips, StatsCallback onAvailable)
+{
+	if (trainingPackCode.empty())
+	{
+		onAvailable({});
+		return;
+	}
+
+	prefetch(trainingPackCode);
+	if (_isLoading)
+	{
+		_pendingRequests.push_back([this, trainingPackCode, numberOfSkips, onAvailable]() {
+			requestPreviousSession(trainingPackCode, numberOfSkips, onAvailable);
+		});
+		return;
+	}
+
+	if (numberOfSkips < (int)_previousSessions.size())
+	{
+		const auto& session = _previousSessions[numberOfSkips];
+		if (!session.WasRestored)
+		{
+			onAvailable(session.Stats);
+			return;
+		}
+	}
+	else if (_previousSessions.size() < NumberOfPrefetchedSessions)
+	{
+		onAvailable({}); // There are no further sessions
+		return;
+	}
+
+	// The session is not kept in memory (anymore)
+	readPreviousSession(numberOfSkips, onAvailable);
+}
+
+void SessionPrefetchCache::requestPeakStats(const std::string& trainingPackCode, StatsCallback onAvailable)
+{
+	if (trainingPackCode.empty())
+	{
+		onAvailable({});
+		return;
+	}
+
+	prefetch(trainingPackCode);
+	if (_isLoading)
+	{
+		_pendingRequests.push_back([this, trainingPackCode, onAvailable]() {
+			requestPeakStats(trainingPackCode, onAvailable);
+		});
+		return;
+	}
+
+	onAvailable(_peakStats);
+}
+
+ShotStats SessionPrefetchCache::restorePreviousSession(const std::string& trainingPackCode)
+{
+	if (trainingPackCode.empty()) { return {}; }
+
+	if (trainingPackCode == _trainingPackCode && _sessionsAreAvailable && !_isLoading)
+	{
+		if (_previousSessions.empty()) { return {}; }
+
+		auto& session = _previousSessions.front();
+		if (!session.WasRestored)
+		{
+			// Restore both impact locations and heatmap
+			if (_shotDistributionTracker)
+			{
+				_shotDistributionTracker->restoreImpacts(session.Impacts);
+			}
+
+			// The stats are handed over rather than copied, since the copy would share the goal speed values with the restored session
+			session.WasRestored = true;
+			session.Impacts = {};
+			return std::move(session.Stats);
+		}
+	}
+
+	// The session has not been loaded yet, so read it now. Going through the storage worker makes sure it is not being written at the same time
+	auto readSession = [statReader = _statReader, trainingPackCode]() {
+		auto resourcePaths = findPreviousSessions(statReader, trainingPackCode, 1);
+		return resourcePaths.empty() ? ShotStats() : statReader->readStats(resourcePaths.front(), StatFieldMask::All);
+	};
+	return _storageWorker ? _storageWorker->readNow<ShotStats>(readSession) : readSession();
+}
+
+void SessionPrefetchCache::invalidateSession(const std::filesystem::path& sessionFilePath, int attempts)
+{
+	if (_trainingPackCode.empty()) { return; }
+
+	// Sessions without attempts are never considered as previous session, unless they had attempts before
+	auto sessionIsPrefetched = std::any_of(_previousSessions.begin(), _previousSessions.end(), [&sessionFilePath](const PrefetchedSession& session) {
+		return std::filesystem::u8path(session.ResourcePath) == sessionFilePath;
+	});
+	if (attempts == 0 && !sessionIsPrefetched) { return; }
+
+	_sessionsAreAvailable = false;
+	if (_isLoading)
+	{
+		startLoading(); // The load might have read the session before it was changed
+	}
+}
+
+void SessionPrefetchCache::invalidatePeakStats(const std::string& trainingPackCode)
+{
+	if (trainingPackCode != _trainingPackCode) { return; }
+
+	_peakStatsAreAvailable = false;
+	if (_isLoading)
+	{
+		startLoading(); // The load might have read the file before it was changed
+	}
+}
+
+std::vector<std::string> SessionPrefetchCache::findPreviousSessions(const std::shared_ptr<IStatReader>& statReader, const std::string& trainingPackCode, size_t maximumNumberOfSessions)
+{
+	std::vector<std::string> sessionPaths;
+	for (const auto& resourcePath : statReader->getAvailableResourcePaths(trainingPackCode))
+	{
+		if (sessionPaths.size() >= maximumNumberOfSessions) { break; }
+
+		// Skip any file which only has zero attempts stored
+		if (statReader->peekAttemptAmount(resourcePath) == 0) { continue; }
+
+		sessionPaths.push_back(resourcePath);
+	}
+	return sessionPaths;
+}
+
+SessionPrefetchCache::LoadedStats SessionPrefetchCache::loadStats(const std::shared_ptr<IStatReader>& statReader, const std::string& trainingPackCode, bool sessionsShallBeLoaded, bool peakStatsShallBeLoaded)
+{
+	LoadedStats loadedStats;
+	if (sessionsShallBeLoaded)
+	{
+		loadedStats.ContainsSessions = true;
+		for (const auto& resourcePath : findPreviousSessions(statReader, trainingPackCode, NumberOfPrefetchedSessions))
+		{
+			PrefetchedSession session;
+			session.ResourcePath = resourcePath;
+			if (loadedStats.PreviousSessions.empty())
+			{
+				// The most recent session might get restored. Its impact locations get registered only if that actually happens
+				session.Stats = statReader->readStats(resourcePath, StatFieldMask::AllExceptImpactLocations);
+				session.Impacts = statReader->readImpactLocations(resourcePath);
+			}
+			else
+			{
+				session.Stats = statReader->readStats(resourcePath, StatFieldMask::DiffComparable);
+			}
+			loadedStats.PreviousSessions.push_back(std::move(session));
+		}
+	}
+	if (peakStatsShallBeLoaded)
+	{
+		loadedStats.ContainsPeakStats = true;
+		loadedStats.PeakStats = statReader->readTrainingPackStatistics(trainingPackCode);
+	}
+	return loadedStats;
+}
+
+void SessionPrefetchCache::startLoading()
+{
+	_isLoading = true;
+	auto loadNumber = ++_numberOfLoads;
+	auto load = [statReader = _statReader, trainingPackCode = _trainingPackCode, sessionsShallBeLoaded = !_sessionsAreAvailable, peakStatsShallBeLoaded = !_peakStatsAreAvailable]() {
+		return loadStats(statReader, trainingPackCode, sessionsShallBeLoaded, peakStatsShallBeLoaded);
+	};
+
+	if (!_storageWorker)
+	{
+		auto loadedStats = load();
+		finishLoading(loadedStats, loadNumber);
+		return;
+	}
+	_storageWorker->queueRead<LoadedStats>(load, [this, loadNumber](LoadedStats& loadedStats) {
+		finishLoading(loadedStats, loadNumber);
+	});
+}
+
+void SessionPrefetchCache::finishLoading(LoadedStats& loadedStats, int loadNumber)
+{
+	if (loadNumber != _numberOfLoads)
+	{
+		return; // The load was discarded since then
+	}
+
+	_isLoading = false;
+	if (loadedStats.ContainsSessions)
+	{
+		_previousSessions = std::move(loadedStats.PreviousSessions);
+		_sessionsAreAvailable = true;
+	}
+	if (loadedStats.ContainsPeakStats)
+	{
+		_peakStats = std::move(loadedStats.PeakStats);
+		_peakStatsAreAvailable = true;
+	}
+
+	// The requests might cause another load if something got invalidated in the meantime
+	auto pendingRequests = std::move(_pendingRequests);
+	_pendingRequests.clear();
+	for (const auto& request : pendingRequests)
+	{
+		request();
+	}
+}
+
+void SessionPrefetchCache::readPreviousSession(int numberOfSkips, StatsCallback onAvailable)
+{
+	auto readSession = [statReader = _statReader, trainingPackCode = _trainingPackCode, numberOfSkips]() {
+		auto resourcePaths = findPreviousSessions(statReader, trainingPackCode, (size_t)numberOfSkips + 1);
+		return resourcePaths.size() <= (size_t)numberOfSkips ? ShotStats() : statReader->readStats(resourcePaths.back(), StatFieldMask::DiffComparable);
+	};
+
+	if (!_storageWorker)
+	{
+		onAvailable(readSession());
+		return;
+	}
+	_storageWorker->queueRead<ShotStats>(readSession, [onAvailable](ShotStats& stats) { onAvailable(stats); });
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../DLLImportExport.h"
+#include "../Core/IStatReader.h"
+#include "../Calculation/ShotDistributionTracker.h"
+#include "StorageWorker.h"
+
+/** Keeps the stats of the previous sessions and the all time peak stats of the current training pack in memory.
+ *
+ * The stats get loaded in the background as soon as the training pack code is known, so resetting the stats, restoring the previous session
+ * or switching the compare base does not have to wait for the file system. Writing anything which could change them invalidates them, in
+ * which case they get loaded again on the next request.
+ *
+ * This must only be used from the game thread. Requests are answered through callbacks, which get executed right away if the stats are
+ * available already, or as soon as they have been loaded otherwise.
+ */
+class GOALPERCENTAGECOUNTER_IMPORT_EXPORT SessionPrefetchCache
+{
+public:
+	/** Receives the requested stats. They are empty if there are no such stats. */
+	using StatsCallback = std::function<void(const ShotStats& stats)>;
+
+	/** The number of previous sessions which get loaded: The previous session, and the one before, which is required for comparing after restoring the previous session. */
+	static constexpr size_t NumberOfPrefetchedSessions = 2;
+
+	/** Creates a new cache. Stats get loaded right away if no storage worker is provided. The shot distribution tracker receives the impact
+	 * locations of restored sessions.
+	 */
+	SessionPrefetchCache(std::shared_ptr<IStatReader> statReader, std::shared_ptr<ShotDistributionTracker> shotDistributionTracker, std::shared_ptr<StorageWorker> storageWorker);
+
+	/** Starts loading the stats of the given training pack, unless they are available or being loaded already. Stats of any other training pack get discarded. */
+	void prefetch(const std::string& trainingPackCode);
+
+	/** Requests the stats of a previous session which are required for comparing it to the current one.
+	 *
+	 * \param	numberOfSkips	The number of sessions with attempts to be skipped. Zero means the most recent session with attempts.
+	 */
+	void requestPreviousSession(const std::string& trainingPackCode, int numberOfSkips, StatsCallback onAvailable);
+
+	/** Requests the all time peak stats as stored in the file system. */
+	void requestPeakStats(const std::string& trainingPackCode, StatsCallback onAvailable);
+
+	/** Retrieves the complete stats of the most recent session with attempts and registers its impact locations, for continuing that session.
+	 * The stats are read right away if they are not available yet, since nothing may be counted before they have been restored.
+	 */
+	ShotStats restorePreviousSession(const std::string& trainingPackCode);
+
+	/** Invalidates the previous sessions if the given session would be one of them after writing the given number of attempts to it. */
+	void invalidateSession(const std::filesystem::path& sessionFilePath, int attempts);
+
+	/** Invalidates the all time peak stats of the given training pack. */
+	void invalidatePeakStats(const std::string& trainingPackCode);
+
+private:
+	/** A previous session which has been read in advance. */
+	struct PrefetchedSession
+	{
+		std::string ResourcePath;
+		ShotStats Stats;
+		StoredImpacts Impacts;					///< Only read for the most recent session, which is the one which can be restored.
+		bool WasRestored = false;				///< True if the stats were handed over for restoring the session, and are not available anymore.
+	};
+
+	/** The result of loading stats in the background. */
+	struct LoadedStats
+	{
+		bool ContainsSessions = false;
+		std::vector<PrefetchedSession> PreviousSessions;
+		bool ContainsPeakStats = false;
+		ShotStats PeakStats;
+	};
+
+	/** Reads the requested stats of the given training pack. Runs on the storage worker. */
+	static LoadedStats loadStats(const std::shared_ptr<IStatReader>& statReader, const std::string& trainingPackCode, bool sessionsShallBeLoaded, bool peakStatsShallBeLoaded);
+	/** Finds the resource paths of the most recent sessions which contain any attempts. */
+	static std::vector<std::string> findPreviousSessions(const std::shared_ptr<IStatReader>& statReader, const std::string& trainingPackCode, size_t maximumNumberOfSessions);
+
+	/** Starts loading any stats of the current training pack which are not available. Any load which is still in progress gets discarded. */
+	void startLoading();
+	/** Stores the loaded stats and answers any pending request, unless the load was discarded in the meantime. */
+	void finishLoading(LoadedStats& loadedStats, int loadNumber);
+	/** Reads the given previous session in the background, for sessions which are not kept in memory. */
+	void readPreviousSession(int numberOfSkips, StatsCallback onAvailable);
+
+	std::shared_ptr<IStatReader> _statReader;							///< Reads the stats.
+	std::shared_ptr<ShotDistributionTracker> _shotDistributionTracker;	///< Receives the impact locations of restored sessions. May be nullptr.
+	std::shared_ptr<StorageWorker> _storageWorker;						///< Loads the stats in the background. May be nullptr.
+
+	std::string _trainingPackCode;							///< The training pack the stats below belong to.
+	std::vector<PrefetchedSession> _previousSessions;		///< The most recent sessions with attempts, most recent first. Fewer than NumberOfPrefetchedSessions entries mean there are no further sessions.
+	bool _sessionsAreAvailable = false;						///< True if _previousSessions are up to date.
+	ShotStats _peakStats;									///< The all time peak stats as stored in the file system.
+	bool _peakStatsAreAvailable = false;					///< True if _peakStats are up to date.
+	bool _isLoading = false;								///< True while stats are being loaded in the background.
+	int _numberOfLoads = 0;									///< Identifies the most recent load, so the results of discarded loads can be ignored.
+	std::vector<std::function<void()>> _pendingRequests;	///< Requests which will be answered as soon as the current load has finished.
+};
@@ -1,5 +1,6 @@
 #include <pch.h>
 #include "StatFileDefs.h"
+#include "BinaryStatFileDefs.h"
 #include <sstream>
 
 const std::vector<std::string> StatFileDefs::SupportedVersionNumbers = {
@@ -8,7 +9,8 @@ const std::vector<std::string> StatFileDefs::SupportedVersionNumbers = {
 	"1.2",
 	"1.3"
 };
-const std::string StatFileDefs::CurrentVersionNumber = "1.3";
+const std::string StatFileDefs::CurrentVersionNumber = fmt::format("{}.{}", BinaryStatFileDefs::MajorVersion, BinaryStatFileDefs::MinorVersion);
+const std::string StatFileDefs::CurrentTextVersionNumber = "1.3";
 const std::string StatFileDefs::Version = "Version";
 const std::string StatFileDefs::NumberOfShots = "NumberOfShots";
 const std::string StatFileDefs::ShotSeparator = "----------------------------------------------------------";
@@ -46,6 +48,11 @@ const std::string StatFileDefs::ImpactLocations = "ImpactLocations";
 // V1.3 and beyond
 const std::string StatFileDefs::GoalSpeedValues = "ShotSpeedValues";
 
+const std::string StatFileDefs::TextFileExtension = ".txt";
+const std::string StatFileDefs::BinaryFileExtension = ".bin";
+const std::string StatFileDefs::JournalFileExtension = ".journal";
+const std::string StatFileDefs::SessionIndexFileName = "Sessions.index";
+
 
 
 
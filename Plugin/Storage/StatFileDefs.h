@@ -9,8 +9,9 @@
 class StatFileDefs
 {
 public:
-	static const std::vector<std::string> SupportedVersionNumbers;
-	static const std::string CurrentVersionNumber;
+	static const std::vector<std::string> SupportedVersionNumbers;	///< The versions of the text format. Binary files carry their version in the header, see BinaryStatFileDefs.
+	static const std::string CurrentVersionNumber;					///< The version of the binary format which is written, derived from BinaryStatFileDefs.
+	static const std::string CurrentTextVersionNumber; ///< The latest version of the text format. Newer versions are binary, see BinaryStatFileDefs.
 
 	static const std::string Version;
 
@@ -51,6 +52,11 @@ public:
 
 	static const std::string GoalSpeedValues;
 
+	static const std::string TextFileExtension; ///< The extension of session files up to version 1.3, and of all time peak stat files.
+	static const std::string BinaryFileExtension; ///< The extension of session files from version 2.0 on.
+	static const std::string JournalFileExtension; ///< The extension of the attempt journal which is stored next to each session file.
+	static const std::string SessionIndexFileName; ///< The name of the manifest of all sessions of a training pack, see SessionIndex.
+
 
 
 	/** Retrieves the path to the training pack data folder. */
@@ -1,20 +1,25 @@
 #include <pch.h>
 #include "StatFileReader.h"
 #include "StatFileDefs.h"
+#include "AttemptJournal.h"
+#include "BinaryStatFileDefs.h"
+#include "BinaryCursor.h"
+#include "MemoryMappedFile.h"
+#include "TextCursor.h"
 
 #include <sstream>
 #include <filesystem>
-#include <fstream>
 
-StatFileReader::StatFileReader(std::shared_ptr<GameWrapper> gameWrapper, std::shared_ptr<ShotDistributionTracker> shotDistributionTracker)
+StatFileReader::StatFileReader(std::shared_ptr<GameWrapper> gameWrapper, std::shared_ptr<ShotDistributionTracker> shotDistributionTracker, std::shared_ptr<SessionIndex> sessionIndex)
 	: _gameWrapper(gameWrapper)
 	, _shotDistributionTracker(shotDistributionTracker)
+	, _sessionIndex(sessionIndex)
 {
 }
 
 std::string getTrainingPackFilePath(std::shared_ptr<GameWrapper> gameWrapper, const std::string& trainingPackCode)
 {
-	return fmt::format("{}\\{}.txt", StatFileDefs::getTrainingFolder(gameWrapper, trainingPackCode), trainingPackCode);
+	return fmt::format("{}\\{}{}", StatFileDefs::getTrainingFolder(gameWrapper, trainingPackCode), trainingPackCode, StatFileDefs::TextFileExtension);
 }
 
 template<typename T>
@@ -31,19 +36,41 @@ int indexInVector(const std::vector<T>& vector, T searchValue)
 	}
 }
 
+// Retrieves the index of the given version in the list of supported text versions, or -1 if it is not a version of the text format
+int getTextVersionIndex(std::string_view versionNumber)
+{
+	return indexInVector(StatFileDefs::SupportedVersionNumbers, std::string(versionNumber));
+}
+
 std::vector<std::string> StatFileReader::getAvailableResourcePaths(const std::string& trainingPackCode)
 {
 	// Read the folder for the current training pack
 	auto folderPath = std::filesystem::u8path(StatFileDefs::getTrainingFolder(_gameWrapper, trainingPackCode));
 	auto trainingPackFilePath = getTrainingPackFilePath(_gameWrapper, trainingPackCode);
 	std::vector<std::string> filePaths;
+	if (_sessionIndex)
+	{
+		// The index already knows about all sessions, and sorts them by date
+		auto trainingPackFileName = std::filesystem::u8path(trainingPackFilePath).filename().u8string();
+		auto readSummary = [this](const std::filesystem::path& filePath, SessionIndexEntry& entry) { return readSessionSummary(filePath, entry); };
+		for (const auto& entry : _sessionIndex->getEntries(folderPath, trainingPackFileName, readSummary))
+		{
+			filePaths.emplace_back((folderPath / std::filesystem::u8path(entry.FileName)).u8string());
+		}
+		return filePaths;
+	}
+
 	if (std::filesystem::exists(folderPath))
 	{
 		try
 		{
 			for (const auto& entry : std::filesystem::directory_iterator(folderPath))
 			{
-				if (!entry.is_regular_file() || entry.path().u8string() == trainingPackFilePath)
+				// Sessions are stored as text files up to version 1.3, and as binary files after that. Anything else (e.g. journals) is no session
+				auto extension = entry.path().extension().u8string();
+				if (!entry.is_regular_file() || 
+					entry.path().u8string() == trainingPackFilePath ||
+					(extension != StatFileDefs::TextFileExtension && extension != StatFileDefs::BinaryFileExtension))
 				{
 					continue;
 				}
@@ -61,160 +88,595 @@ std::vector<std::string> StatFileReader::getAvailableResourcePaths(const std::st
 	return filePaths;
 }
 
-std::pair<std::string, std::string> getLineValues(const std::string& line)
+bool isBinaryStatFile(const MemoryMappedFile& file)
 {
-	std::string delimiter = "\t";
+	uint32_t magic;
+	return file.isOpen() && BinaryCursor(file.data(), file.size()).read(magic) && magic == BinaryStatFileDefs::Magic;
+}
 
-	auto end = line.find(delimiter);
-	if (end == std::string::npos)
+int StatFileReader::peekAttemptAmount(const std::string& resourcePath)
+{
+	// Sessions which are part of the index don't need to be opened at all
+	auto filePath = std::filesystem::u8path(resourcePath);
+	if (_sessionIndex)
 	{
-		return {};
+		if (auto entry = _sessionIndex->findEntry(filePath))
+		{
+			return entry->Attempts;
+		}
 	}
 
-	return { line.substr(0, end), line.substr(end + 1, line.size() - end + 1) };
+	SessionIndexEntry entry;
+	return readSessionSummary(filePath, entry) ? entry.Attempts : 0;
 }
 
+bool StatFileReader::readSessionSummary(const std::filesystem::path& filePath, SessionIndexEntry& entry)
+{
+	bool summaryWasRead = false;
+	{
+		MemoryMappedFile file(filePath);
+		summaryWasRead = isBinaryStatFile(file) ? peekBinarySummary(file, entry) : peekTextSummary(file, entry);
+	}
+	if (!summaryWasRead) { return false; }
 
-int StatFileReader::peekAttemptAmount(const std::string& resourcePath)
+	// Attempts which have not been compacted into the file yet are stored in the journal
+	for (const auto& record : AttemptJournal::readRecords(AttemptJournal::getJournalPath(filePath)))
+	{
+		if (record.Summary.Attempts == entry.Attempts + 1)
+		{
+			entry.Attempts = record.Summary.Attempts;
+			entry.Goals = record.Summary.Goals;
+		}
+	}
+	return true;
+}
+
+bool StatFileReader::peekBinarySummary(const MemoryMappedFile& file, SessionIndexEntry& entry)
 {
-	// Try opening the file
-	std::ifstream fileStream(resourcePath);
-	if (fileStream.fail()) { return 0; }
+	// The header is followed by the summary record, which starts with the number of attempts and goals
+	BinaryCursor cursor(file.data(), file.size());
+	uint32_t magic, numberOfShots, recordSize, numberOfSections;
+	uint16_t majorVersion, minorVersion;
+	int32_t attempts, goals;
+	if (!cursor.read(magic) || !cursor.read(majorVersion) || !cursor.read(minorVersion) ||
+		!cursor.read(numberOfShots) || !cursor.read(recordSize) || !cursor.read(numberOfSections) ||
+		!cursor.read(attempts) || !cursor.read(goals) || attempts < 0 || goals < 0)
+	{
+		return false; // The file is invalid
+	}
+	entry.Attempts = attempts;
+	entry.Goals = goals;
+	entry.NumberOfShots = (int)numberOfShots;
+	entry.Version = fmt::format("{}.{}", majorVersion, minorVersion);
+	return true;
+}
+
+bool StatFileReader::peekTextSummary(const MemoryMappedFile& file, SessionIndexEntry& entry)
+{
+	if (!file.isOpen()) { return false; }
+	TextCursor cursor(file.data(), file.size());
 
 	// Try reading the version from the file
-	std::string currentLine;
-	if (!std::getline(fileStream, currentLine)) { return 0; }
+	std::string_view versionTag, versionNumber;
+	if (!cursor.readKeyValue(versionTag, versionNumber) || versionTag != StatFileDefs::Version || getTextVersionIndex(versionNumber) < 0)
+	{
+		return false; // Version number is unknown or file is invalid
+	}
 
-	auto [versionTag, versionNumber] = getLineValues(currentLine);
-	auto versionIndex = indexInVector(StatFileDefs::SupportedVersionNumbers, versionNumber);
-	if (versionTag != StatFileDefs::Version || versionIndex < 0)
+	// This looks like an actually supported file => Currently, the version will be followed by the amount of shots, a separator line and then the attempts and goals
+	std::string_view separatorLine;
+	if (!cursor.readValue(entry.NumberOfShots) || entry.NumberOfShots <= 0 ||
+		!cursor.readLine(separatorLine) ||
+		!cursor.readValue(entry.Attempts) ||
+		!cursor.readValue(entry.Goals))
 	{
-		return 0; // Version number is unknown or file is invalid
+		// The file is invalid, maybe someone messed with it
+		return false;
 	}
 
-	// This looks like an actually supported file => Currently, the version will be followed by the amount of shots, a separator line and then the attempts
-	// We're only interested in the attempts here
+	entry.Version = std::string(versionNumber);
+	return true;
+}
 
-	for (int i = 0; i < 3; i++)
+// Replaces the goal speed statistics which were stored in the file by the ones of the values which were read
+void updateGoalSpeedSummaries(ShotStats& stats)
+{
+	stats.updateGoalSpeedSummary(-1);
+	for (auto shotIndex = 0; shotIndex < (int)stats.PerShotStats.size(); shotIndex++)
 	{
-		if (!std::getline(fileStream, currentLine)) { return 0; }
+		stats.updateGoalSpeedSummary(shotIndex);
 	}
+}
+
+ShotStats StatFileReader::readStats(const std::string& resourcePath, StatFieldMask fields)
+{
+	StoredImpacts impacts;
+	auto stats = readStats(resourcePath, fields, impacts);
 
-	auto [attemptsTag, attemptAmount] = getLineValues(currentLine);
-	auto attempts = std::stoi(attemptAmount);
-	if (attemptsTag != StatFileDefs::Attempts || attempts < 0)
+	// Restore both impact locations and heatmap. They are only registered once the whole session was read, so an invalid file does not leave half of its impacts behind
+	if (!impacts.Locations.empty())
 	{
-		// The file is invalid, maybe someone messed with it
-		return 0;
+		_shotDistributionTracker->restoreImpacts(impacts);
 	}
+	return stats;
+}
 
-	return attempts;
+StoredImpacts StatFileReader::readImpactLocations(const std::string& resourcePath)
+{
+	StoredImpacts impacts;
+	readStats(resourcePath, StatFieldMask::Summary | StatFieldMask::ImpactLocations | StatFieldMask::Heatmap, impacts);
+	return impacts;
 }
 
-bool readValueIntoField(std::ifstream& stream, int* valuePointer)
+ShotStats StatFileReader::readStats(const std::string& resourcePath, StatFieldMask fields, StoredImpacts& impacts)
 {
-	std::string currentLine;
-	if (!std::getline(stream, currentLine)) { return false; }
-	if (currentLine.empty()) { return false; }
+	// The summary is always required since it tells whether or not there are any attempts.
+	// Journal records can only be applied to the complete stats, so any session with a journal needs to be read completely
+	auto journalRecords = AttemptJournal::readRecords(AttemptJournal::getJournalPath(std::filesystem::u8path(resourcePath)));
+	auto goalSpeedSketchWasRequested = containsFields(fields, StatFieldMask::GoalSpeedSketch);
+	fields = fields | StatFieldMask::Summary;
+	if (!journalRecords.empty())
+	{
+		fields = fields | StatFieldMask::PerShotStats | StatFieldMask::GoalSpeedValues;
+	}
+
+	ShotStats stats;
+	bool statsWereRead = false;
+	{
+		MemoryMappedFile file(std::filesystem::u8path(resourcePath));
+		if (isBinaryStatFile(file))
+		{
+			statsWereRead = readBinaryStats(file, stats, fields, impacts);
+		}
+		else
+		{
+			// Files up to version 1.3 are text files, which don't store a heatmap
+			statsWereRead = readTextStats(file, stats, fields, impacts.Locations);
+		}
+	}
+	if (!statsWereRead)
+	{
+		impacts = {};
+		return {};
+	}
+
+	// Impact locations of the journal are not part of the stored heatmap
+	replayJournal(journalRecords, stats, containsFields(fields, StatFieldMask::ImpactLocations) ? &impacts.Locations : nullptr);
+	if (goalSpeedSketchWasRequested && containsFields(fields, StatFieldMask::GoalSpeedValues))
+	{
+		// The sketch wasn't read since the values were required for the journal, so it gets created from them
+		stats.getGoalSpeedValues(-1).mergeInto(stats.GoalSpeedSketch);
+	}
+	return stats;
+}
 
-	auto [key, value] = getLineValues(currentLine);
-	if (key.empty() || value.empty()) { return false; }
+bool StatFileReader::readTextStats(const MemoryMappedFile& file, ShotStats& stats, StatFieldMask fields, std::vector<Vector>& impactLocations)
+{
+	// The whole file is parsed directly from the mapped memory
+	if (!file.isOpen()) { return false; }
+	TextCursor cursor(file.data(), file.size());
 
-	auto valueAsInt = std::stoi(value);
-	if (valueAsInt < 0)
+	// Check for the version number
+	std::string_view versionTag, versionNumber;
+	if (!cursor.readKeyValue(versionTag, versionNumber)) { return false; }
+	auto versionIndex = getTextVersionIndex(versionNumber);
+	if (versionIndex < 0)
+	{
+		return false; // Version number is unknown or file is invalid
+	}
+
+	// Actually read the number of shots
+	std::string_view numberOfShotsTag, numberOfShotsValue;
+	int numberOfShots;
+	if (!cursor.readKeyValue(numberOfShotsTag, numberOfShotsValue) ||
+		numberOfShotsTag != StatFileDefs::NumberOfShots ||
+		!TextCursor::parse(numberOfShotsValue, numberOfShots) ||
+		numberOfShots <= 0)
 	{
 		return false;
 	}
-	*valuePointer = valueAsInt;
+
+	// The all shot stats are followed by the stats of each shot, so we can read everything in a loop. If the stats of the single shots
+	// are not required, we can stop after the all shot stats
+	auto numberOfShotsToBeRead = 0;
+	if (containsFields(fields, StatFieldMask::PerShotStats))
+	{
+		numberOfShotsToBeRead = numberOfShots;
+		stats.PerShotStats.resize(numberOfShots);
+	}
+
+	auto goalSpeedValuesShallBeRead = containsFields(fields, StatFieldMask::GoalSpeedValues);
+	auto goalSpeedSketchShallBeRead = !goalSpeedValuesShallBeRead && containsFields(fields, StatFieldMask::GoalSpeedSketch);
+	auto goalSpeedStatisticsShallBeRead = !goalSpeedValuesShallBeRead && !goalSpeedSketchShallBeRead && containsFields(fields, StatFieldMask::GoalSpeedStatistics);
+	auto impactLocationTarget = containsFields(fields, StatFieldMask::ImpactLocations) ? &impactLocations : nullptr;
+	for (int shotNumber = -1; shotNumber < numberOfShotsToBeRead; shotNumber++)
+	{
+		auto& statsData = shotNumber < 0 ? stats.AllShotStats : stats.PerShotStats[shotNumber];
+
+		// Skip the dashes lines
+		std::string_view separatorLine;
+		if (!cursor.readLine(separatorLine)) { return false; }
+
+		// Read stats
+		if (!readVersion_1_0(cursor, statsData)) { return false; }
+		if (versionIndex > 0 && !readVersion_1_1_additions(cursor, statsData)) { return false; }
+		if (versionIndex > 1 && !readVersion_1_2_additions(cursor, impactLocationTarget)) { return false; }
+
+		// Text files don't contain sketches, so the sketch of the summary gets created from the single values
+		IGoalSpeedProvider* goalSpeedValues = nullptr;
+		if (goalSpeedValuesShallBeRead) { goalSpeedValues = &stats.getGoalSpeedValues(shotNumber); }
+		else if (goalSpeedSketchShallBeRead && shotNumber < 0) { goalSpeedValues = &stats.GoalSpeedSketch; }
+		auto goalSpeedDeviation = goalSpeedStatisticsShallBeRead ? &statsData.Stats.GoalSpeed : nullptr;
+		if (versionIndex > 2 && !readVersion_1_3_additions(cursor, goalSpeedValues, goalSpeedDeviation)) { return false; }
+	}
+
+	if (goalSpeedValuesShallBeRead) { updateGoalSpeedSummaries(stats); }
+	if (goalSpeedSketchShallBeRead) { stats.AllShotStats.Stats.GoalSpeed = stats.GoalSpeedSketch.getSummary(); }
 	return true;
 }
-bool readValueIntoField(std::ifstream& stream, double* valuePointer)
+
+bool StatFileReader::readBinaryStats(const MemoryMappedFile& file, ShotStats& stats, StatFieldMask fields, StoredImpacts& impacts)
 {
-	std::string currentLine;
-	if (!std::getline(stream, currentLine)) { return false; }
-	if (currentLine.empty()) { return false; }
+	BinaryCursor cursor(file.data(), file.size());
 
-	auto [key, value] = getLineValues(currentLine);
-	if (key.empty() || value.empty()) { return false; }
+	// Header
+	uint32_t magic, numberOfShots, recordSize, numberOfSections;
+	uint16_t majorVersion, minorVersion;
+	if (!cursor.read(magic) || !cursor.read(majorVersion) || !cursor.read(minorVersion) ||
+		!cursor.read(numberOfShots) || !cursor.read(recordSize) || !cursor.read(numberOfSections))
+	{
+		return false;
+	}
+	if (magic != BinaryStatFileDefs::Magic || majorVersion != BinaryStatFileDefs::MajorVersion)
+	{
+		return false; // File is invalid or uses an incompatible layout. Newer minor versions only append record fields and sections, which get skipped
+	}
+
+	// Make sure the record table is actually there before allocating anything for it
+	if (numberOfShots == 0 || (uint64_t)recordSize * (numberOfShots + 1) > cursor.remaining())
+	{
+		return false;
+	}
 
-	auto valueAsFloat = std::stod(value);
-	if (valueAsFloat < .0)
+	// Record table. The records of the single shots can simply be skipped if they are not required
+	if (!readBinaryRecord(cursor.split(recordSize), stats.AllShotStats)) { return false; }
+	if (containsFields(fields, StatFieldMask::PerShotStats))
+	{
+		stats.PerShotStats.resize(numberOfShots);
+		for (auto& shotStats : stats.PerShotStats)
+		{
+			if (!readBinaryRecord(cursor.split(recordSize), shotStats)) { return false; }
+		}
+	}
+	else if (!cursor.skip((size_t)recordSize * numberOfShots))
 	{
 		return false;
 	}
-	*valuePointer = valueAsFloat;
+
+	// Unless the single goal speed values or the sketch are required, the statistics which were stored in the records are sufficient.
+	// Only their standard deviation is not stored, it gets calculated from the single values while reading them.
+	// Only the sketch of the summary is used, since the sketches are meant for combining the sessions of a training pack
+	std::vector<IGoalSpeedProvider*> goalSpeedValues;
+	std::vector<GoalSpeedSummary*> goalSpeedDeviations;
+	auto goalSpeedValuesShallBeRead = containsFields(fields, StatFieldMask::GoalSpeedValues);
+	auto goalSpeedSketchShallBeRead = !goalSpeedValuesShallBeRead && containsFields(fields, StatFieldMask::GoalSpeedSketch);
+	if (goalSpeedValuesShallBeRead)
+	{
+		goalSpeedValues.push_back(&stats.getGoalSpeedValues(-1));
+		for (auto shotIndex = 0; shotIndex < (int)stats.PerShotStats.size(); shotIndex++)
+		{
+			goalSpeedValues.push_back(&stats.getGoalSpeedValues(shotIndex));
+		}
+	}
+	else if (goalSpeedSketchShallBeRead)
+	{
+		// Files before version 2.2 don't contain sketches, so the sketch gets created from the single values unless a sketch section gets read
+		goalSpeedValues.push_back(&stats.GoalSpeedSketch);
+	}
+	else if (containsFields(fields, StatFieldMask::GoalSpeedStatistics))
+	{
+		goalSpeedDeviations.push_back(&stats.AllShotStats.Stats.GoalSpeed);
+		for (auto& shotStats : stats.PerShotStats)
+		{
+			goalSpeedDeviations.push_back(&shotStats.Stats.GoalSpeed);
+		}
+	}
+
+	// Sections
+	auto goalSpeedSketchWasRead = false;
+	for (uint32_t sectionIndex = 0; sectionIndex < numberOfSections; sectionIndex++)
+	{
+		uint32_t sectionId, sectionLength;
+		if (!cursor.read(sectionId) || !cursor.read(sectionLength) || sectionLength > cursor.remaining()) { return false; }
+		auto sectionCursor = cursor.split(sectionLength);
+
+		switch ((BinaryStatFileDefs::SectionId)sectionId)
+		{
+		case BinaryStatFileDefs::SectionId::ImpactLocations:
+			// Impact locations are only relevant when restoring, comparing them isn't supported
+			if (containsFields(fields, StatFieldMask::ImpactLocations) && !readBinaryImpactLocations(sectionCursor, impacts.Locations)) { return false; }
+			break;
+		case BinaryStatFileDefs::SectionId::Heatmap:
+			// Without the heatmap, it would have to be recreated from the impact locations
+			if (containsFields(fields, StatFieldMask::ImpactLocations | StatFieldMask::Heatmap) && !readBinaryHeatmap(sectionCursor, impacts)) { return false; }
+			break;
+		case BinaryStatFileDefs::SectionId::GoalSpeedSketches:
+			if (goalSpeedSketchShallBeRead)
+			{
+				if (!readBinaryGoalSpeedSketch(sectionCursor, stats.GoalSpeedSketch)) { return false; }
+				goalSpeedSketchWasRead = true;
+			}
+			break;
+		case BinaryStatFileDefs::SectionId::GoalSpeedValues:
+			if (!goalSpeedSketchWasRead && !readBinaryGoalSpeedValues(sectionCursor, goalSpeedValues)) { return false; }
+			if (!readBinaryGoalSpeedDeviations(sectionCursor, goalSpeedDeviations)) { return false; }
+			break;
+		case BinaryStatFileDefs::SectionId::RecentShots:
+			if (!readBinaryRecentShots(sectionCursor, stats)) { return false; }
+			break;
+		case BinaryStatFileDefs::SectionId::RollingWindows:
+			if (!readBinaryRollingWindows(sectionCursor, stats)) { return false; }
+			break;
+		default:
+			break; // Sections of newer versions are skipped
+		}
+	}
+
+	if (goalSpeedValuesShallBeRead) { updateGoalSpeedSummaries(stats); }
+	if (goalSpeedSketchShallBeRead) { stats.AllShotStats.Stats.GoalSpeed = stats.GoalSpeedSketch.getSummary(); }
 	return true;
 }
-bool readValueIntoField(std::ifstream& stream, float* valuePointer)
+
+bool StatFileReader::readBinaryRecord(BinaryCursor cursor, StatsData& statsData)
 {
-	double tmp;
-	auto readSucceeded = readValueIntoField(stream, &tmp);
-	if (readSucceeded)
-	{
-		*valuePointer = (float)tmp;
+	// Note: The order of the fields must match BinaryStatFileSerializer::appendRecord()
+	auto readInt = [&cursor](int& field) {
+		int32_t value;
+		if (!cursor.read(value) || value < 0) { return false; }
+		field = value;
 		return true;
-	}
-	return false;
+	};
+
+	// Player Stats
+	if (!readInt(statsData.Stats.Attempts)) { return false; }
+	if (!readInt(statsData.Stats.Goals)) { return false; }
+	if (!readInt(statsData.Stats.InitialHits)) { return false; }
+	if (!readInt(statsData.Stats.GoalStreakCounter)) { return false; }
+	if (!readInt(statsData.Stats.MissStreakCounter)) { return false; }
+	if (!readInt(statsData.Stats.LongestGoalStreak)) { return false; }
+	if (!readInt(statsData.Stats.LongestMissStreak)) { return false; }
+	if (!readInt(statsData.Stats.MaxAirDribbleTouches)) { return false; }
+	if (!readInt(statsData.Stats.DoubleTapGoals)) { return false; }
+	if (!readInt(statsData.Stats.MaxFlipResets)) { return false; }
+	if (!readInt(statsData.Stats.TotalFlipResets)) { return false; }
+	if (!readInt(statsData.Stats.FlipResetAttemptsScored)) { return false; }
+	if (!readInt(statsData.Stats.CloseMisses)) { return false; }
+	if (!cursor.read(statsData.Stats.MaxAirDribbleTime)) { return false; }
+	if (!cursor.read(statsData.Stats.MaxGroundDribbleTime)) { return false; }
+
+	// The last 64 shots. Files of version 2.1 and later contain more shots in a section
+	uint32_t numberOfRecentShots;
+	uint64_t recentShotBits;
+	if (!cursor.read(numberOfRecentShots) || !cursor.read(recentShotBits) || numberOfRecentShots > 64) { return false; }
+	statsData.Stats.RecentShots.clear();
+	statsData.Stats.RecentShots.pushPackedWord(recentShotBits, numberOfRecentShots);
+
+	// Goal speed. The number of values and the standard deviation are only known when reading the goal speed section
+	auto& goalSpeed = statsData.Stats.GoalSpeed;
+	if (!cursor.read(goalSpeed.MostRecent)) { return false; }
+	if (!cursor.read(goalSpeed.Max)) { return false; }
+	if (!cursor.read(goalSpeed.Min)) { return false; }
+	if (!cursor.read(goalSpeed.Median)) { return false; }
+	if (!cursor.read(goalSpeed.Mean)) { return false; }
+
+	// Calculated stats
+	if (!cursor.read(statsData.Data.SuccessPercentage)) { return false; }
+	if (!cursor.read(statsData.Data.PeakSuccessPercentage)) { return false; }
+	if (!readInt(statsData.Data.PeakShotNumber)) { return false; }
+	if (!cursor.read(statsData.Data.Last50ShotsPercentage)) { return false; }
+	if (!cursor.read(statsData.Data.InitialHitPercentage)) { return false; }
+	if (!cursor.read(statsData.Data.DoubleTapGoalPercentage)) { return false; }
+	if (!cursor.read(statsData.Data.AverageFlipResetsPerAttempt)) { return false; }
+	if (!cursor.read(statsData.Data.FlipResetGoalPercentage)) { return false; }
+	if (!cursor.read(statsData.Data.CloseMissPercentage)) { return false; }
+
+	// Any remaining bytes belong to fields of newer versions
+	return true;
 }
 
+bool StatFileReader::readBinaryImpactLocations(BinaryCursor cursor, std::vector<Vector>& impactLocations)
+{
+	uint32_t numberOfLocations;
+	if (!cursor.read(numberOfLocations) || (uint64_t)numberOfLocations * 3 * sizeof(float) > cursor.remaining()) { return false; }
+
+	impactLocations.reserve(impactLocations.size() + numberOfLocations);
+	for (uint32_t index = 0; index < numberOfLocations; index++)
+	{
+		Vector location;
+		cursor.read(location.X);
+		cursor.read(location.Y);
+		cursor.read(location.Z);
+		impactLocations.push_back(location);
+	}
+	return true;
+}
 
-ShotStats StatFileReader::readStats(const std::string& resourcePath, bool statsAboutToBeRestored)
+bool StatFileReader::readBinaryHeatmap(BinaryCursor cursor, StoredImpacts& impacts)
 {
-	// Try opening the file
-	std::ifstream fileStream(resourcePath);
-	if (fileStream.fail()) { return {}; }
+	uint32_t numberOfLocations, numberOfXBrackets, numberOfZBrackets;
+	float maximumValue;
+	if (!cursor.read(numberOfLocations) || !cursor.read(maximumValue) || !cursor.read(numberOfXBrackets) || !cursor.read(numberOfZBrackets)) { return false; }
 
-	std::string currentLine;
+	// A heatmap with a different resolution can't be used, and neither can one which does not match the impact locations.
+	// The impact locations can still be restored without it, though
+	if (numberOfXBrackets != ImpactHeatmap::XBrackets || numberOfZBrackets != ImpactHeatmap::ZBrackets || numberOfLocations != impacts.Locations.size())
+	{
+		return true;
+	}
 
-	// Check for the version number
-	if (!std::getline(fileStream, currentLine)) { return {}; }
-	auto [versionTag, versionNumber] = getLineValues(currentLine);
-	auto versionIndex = indexInVector(StatFileDefs::SupportedVersionNumbers, versionNumber);
-	if (versionIndex < 0)
+	// Only the part of each row which is not zero has been stored
+	auto data = std::make_unique<ImpactHeatmap::Grid>();
+	for (auto& row : *data)
 	{
-		return {}; // Version number is unknown or file is invalid
+		uint16_t firstIndex, numberOfValues;
+		if (!cursor.read(firstIndex) || !cursor.read(numberOfValues) ||
+			firstIndex + numberOfValues > ImpactHeatmap::ZBrackets || (size_t)numberOfValues * sizeof(float) > cursor.remaining())
+		{
+			return false;
+		}
+		for (auto index = firstIndex; index < firstIndex + numberOfValues; index++)
+		{
+			cursor.read(row[index]);
+		}
 	}
 
-	// Actually read the number of shots
-	if (!std::getline(fileStream, currentLine)) { return {}; }
+	auto heatmap = std::make_shared<ImpactHeatmap>();
+	heatmap->restore(*data, maximumValue);
+	impacts.Heatmap = heatmap;
+	impacts.NumberOfLocationsInHeatmap = numberOfLocations;
+	return true;
+}
 
-	auto [numberOfShotsTag, numberOfShotsValue] = getLineValues(currentLine);
-	auto numberOfShots = std::stoi(numberOfShotsValue);
-	if (numberOfShotsTag != StatFileDefs::NumberOfShots || numberOfShots <= 0)
+bool StatFileReader::readBinaryGoalSpeedSketch(BinaryCursor cursor, SketchedGoalSpeed& goalSpeedSketch)
+{
+	// The section starts with the sketch of the all shot stats. Version 2.2 wrote the sketch of each shot after it, which is not read
 	{
-		return {};
+		uint32_t numberOfValues, numberOfLevels;
+		float mostRecent, min, max, mean, variance;
+		if (!cursor.read(numberOfValues) || !cursor.read(mostRecent) || !cursor.read(min) || !cursor.read(max) ||
+			!cursor.read(mean) || !cursor.read(variance) || !cursor.read(numberOfLevels) || numberOfLevels >= 64)
+		{
+			return false;
+		}
+
+		std::vector<std::vector<float>> levels(numberOfLevels);
+		for (auto& levelValues : levels)
+		{
+			uint32_t numberOfLevelValues;
+			if (!cursor.read(numberOfLevelValues) || (uint64_t)numberOfLevelValues * sizeof(float) > cursor.remaining()) { return false; }
+
+			levelValues.resize(numberOfLevelValues);
+			for (auto& value : levelValues)
+			{
+				cursor.read(value);
+			}
+		}
+
+		QuantileSketch sketch;
+		if (!sketch.restore(numberOfValues, min, max, std::move(levels))) { return false; }
+		goalSpeedSketch = SketchedGoalSpeed(std::move(sketch), RunningMean(numberOfValues, mean, variance), mostRecent);
 	}
+	return true;
+}
 
-	// Build a vector which points to the all stats object and then the shot stats objects. That way we can read everything in a loop
-	ShotStats stats;
-	for (int shotNumber = 0; shotNumber < numberOfShots; shotNumber++)
+bool StatFileReader::readBinaryGoalSpeedValues(BinaryCursor cursor, const std::vector<IGoalSpeedProvider*>& goalSpeedValues)
+{
+	// The section contains the values of the all shot stats first, followed by the values of each shot
+	for (auto goalSpeedStats : goalSpeedValues)
 	{
-		stats.PerShotStats.emplace_back();
+		uint32_t numberOfValues;
+		if (!cursor.read(numberOfValues) || (uint64_t)numberOfValues * sizeof(float) > cursor.remaining()) { return false; }
+
+		for (uint32_t index = 0; index < numberOfValues; index++)
+		{
+			// Register the goal speed value as if the player had taken the shot
+			float goalSpeed;
+			cursor.read(goalSpeed);
+			goalSpeedStats->insert(goalSpeed);
+		}
 	}
+	return true;
+}
 
-	std::vector<StatsData*> statsDataObjectsToBeFilled = { &stats.AllShotStats };
-	for (int shotNumber = 0; shotNumber < numberOfShots; shotNumber++)
+bool StatFileReader::readBinaryGoalSpeedDeviations(BinaryCursor cursor, const std::vector<GoalSpeedSummary*>& goalSpeedStatistics)
+{
+	// Like the values, but they are only streamed through, rather than being stored
+	for (auto statistics : goalSpeedStatistics)
 	{
-		statsDataObjectsToBeFilled.emplace_back(&stats.PerShotStats[shotNumber]);
+		uint32_t numberOfValues;
+		if (!cursor.read(numberOfValues) || (uint64_t)numberOfValues * sizeof(float) > cursor.remaining()) { return false; }
+
+		RunningMean deviation;
+		for (uint32_t index = 0; index < numberOfValues; index++)
+		{
+			float goalSpeed;
+			cursor.read(goalSpeed);
+			deviation.insert(goalSpeed);
+		}
+		statistics->StdDev = deviation.getStdDev();
 	}
+	return true;
+}
 
-	// Lazy approach: We got the version and this looks like a valid file, so we ignore the labels
-	//                A more robust approach would obviously be to create a map of key,value pairs and then distribute stats based on that
-	for (int shotNumber = -1; shotNumber < numberOfShots; shotNumber++)
+bool StatFileReader::readBinaryRecentShots(BinaryCursor cursor, ShotStats& stats)
+{
+	// Like the goal speed values, the section contains the summary first. The shots which weren't read are simply ignored
+	auto readRecentShots = [&cursor](StatsData& statsData) {
+		uint32_t numberOfShots;
+		if (!cursor.read(numberOfShots) || ((uint64_t)numberOfShots + 63) / 64 * sizeof(uint64_t) > cursor.remaining()) { return false; }
+
+		auto& recentShots = statsData.Stats.RecentShots;
+		recentShots.clear();
+		for (uint32_t firstShotIndex = 0; firstShotIndex < numberOfShots; firstShotIndex += (uint32_t)recentShots.BitsPerWord)
+		{
+			uint64_t recentShotBits;
+			cursor.read(recentShotBits);
+			recentShots.pushPackedWord(recentShotBits, numberOfShots - firstShotIndex);
+		}
+		return true;
+	};
+
+	if (!readRecentShots(stats.AllShotStats)) { return false; }
+	for (auto& shotStats : stats.PerShotStats)
 	{
-		auto vectorIndex = shotNumber + 1;
-		auto statsDataPointer = statsDataObjectsToBeFilled[vectorIndex];
+		if (!readRecentShots(shotStats)) { return false; }
+	}
+	return true;
+}
 
-		// Skip the dashes lines
-		if (!std::getline(fileStream, currentLine)) { return {}; }
+bool StatFileReader::readBinaryRollingWindows(BinaryCursor cursor, ShotStats& stats)
+{
+	auto readRollingWindows = [&cursor](StatsData& statsData) {
+		uint32_t numberOfWindows;
+		if (!cursor.read(numberOfWindows)) { return false; }
 
-		// Read stats
-		if (!readVersion_1_0(fileStream, statsDataPointer)) { return {}; }
-		if (versionIndex > 0 && !readVersion_1_1_additions(fileStream, statsDataPointer)) { return {}; }
-		if (versionIndex > 1 && !readVersion_1_2_additions(fileStream, statsAboutToBeRestored)) { return {}; }
-		if (versionIndex > 2 && !readVersion_1_3_additions(fileStream, statsDataPointer)) { return {}; }
+		auto& rollingWindows = statsData.Data.RollingWindows;
+		rollingWindows = {};
+		for (uint32_t index = 0; index < numberOfWindows; index++)
+		{
+			RollingWindow window;
+			if (!cursor.read(window.Size) || !cursor.read(window.Goals) || !cursor.read(window.Percentage) ||
+				!cursor.read(window.PeakPercentage) || !cursor.read(window.PeakShotNumber))
+			{
+				return false;
+			}
+			if (window.Size <= 0 || window.Size > RollingWindowDefs::MaxWindowSize || window.Goals < 0 || window.Goals > window.Size) { return false; }
+
+			// Windows beyond the supported number are skipped
+			if (index < rollingWindows.size())
+			{
+				rollingWindows[index] = window;
+			}
+		}
+		return true;
+	};
+
+	if (!readRollingWindows(stats.AllShotStats)) { return false; }
+	for (auto& shotStats : stats.PerShotStats)
+	{
+		if (!readRollingWindows(shotStats)) { return false; }
+	}
+	return true;
+}
+
+void StatFileReader::replayJournal(const std::vector<AttemptJournalRecord>& journalRecords, ShotStats& stats, std::vector<Vector>* impactLocations)
+{
+	// The file only contains the stats up to the last snapshot. Any attempt after that has been appended to the journal
+	for (const auto& record : journalRecords)
+	{
+		// Records which are already part of the snapshot get skipped
+		AttemptJournal::applyRecord(record, stats, impactLocations);
 	}
-	return stats;
 }
 ShotStats StatFileReader::readTrainingPackStatistics(const std::string& trainingPackCode)
 {
@@ -224,126 +686,111 @@ ShotStats StatFileReader::readTrainingPackStatistics(const std::string& training
 		return ShotStats();
 	}
 	// Read the stats as usual from the training pack file, but skip stuff like heatmap and shot locations
-	return readStats(trainingPackFilePath, false);
+	return readStats(trainingPackFilePath, StatFieldMask::Summary | StatFieldMask::PerShotStats);
 }
 
-bool StatFileReader::readVersion_1_0(std::ifstream& fileStream, StatsData* const statsDataPointer)
+bool StatFileReader::readVersion_1_0(TextCursor& cursor, StatsData& statsData)
 {
-	if (!readValueIntoField(fileStream, &statsDataPointer->Stats.Attempts)) { return false; }
-	if (!readValueIntoField(fileStream, &statsDataPointer->Stats.Goals)) { return false; }
-	if (!readValueIntoField(fileStream, &statsDataPointer->Stats.InitialHits)) { return false; }
-	if (!readValueIntoField(fileStream, &statsDataPointer->Stats.GoalStreakCounter)) { return false; }
-	if (!readValueIntoField(fileStream, &statsDataPointer->Stats.MissStreakCounter)) { return false; }
-	if (!readValueIntoField(fileStream, &statsDataPointer->Stats.LongestGoalStreak)) { return false; }
-	if (!readValueIntoField(fileStream, &statsDataPointer->Stats.LongestMissStreak)) { return false; }
+	if (!cursor.readValue(statsData.Stats.Attempts)) { return false; }
+	if (!cursor.readValue(statsData.Stats.Goals)) { return false; }
+	if (!cursor.readValue(statsData.Stats.InitialHits)) { return false; }
+	if (!cursor.readValue(statsData.Stats.GoalStreakCounter)) { return false; }
+	if (!cursor.readValue(statsData.Stats.MissStreakCounter)) { return false; }
+	if (!cursor.readValue(statsData.Stats.LongestGoalStreak)) { return false; }
+	if (!cursor.readValue(statsData.Stats.LongestMissStreak)) { return false; }
 
 	// last N shot: we need to add true/false values for each 1/0 in the string
-	std::string currentLine;
-	if (!std::getline(fileStream, currentLine)) { return false; }
-	auto [key, boolArrayString] = getLineValues(currentLine);
+	std::string_view key, boolArrayString;
+	if (!cursor.readKeyValue(key, boolArrayString)) { return false; }
 	// Note: boolArrayString might be empty if the last session didn't include at least one of the shots
 
-	for (int index = 0; index < boolArrayString.size(); index++)
-	{
-		statsDataPointer->Stats.Last50Shots.emplace_back((boolArrayString.at(index) == '1' ? true : false));
-	}
+	statsData.Stats.RecentShots = decltype(statsData.Stats.RecentShots)::fromString(boolArrayString);
 
-	// We restore goal speed through an additional stat, but these lines were not removed for backwards compatibility
-	if (!std::getline(fileStream, currentLine)) { return false; } // latest speed
-	if (!readValueIntoField(fileStream, &statsDataPointer->Stats.MaxGoalSpeedFromFile)) { return false; } // max speed
-	if (!readValueIntoField(fileStream, &statsDataPointer->Stats.MinGoalSpeedFromFile)) { return false; } // min speed
-	if (!readValueIntoField(fileStream, &statsDataPointer->Stats.MedianGoalSpeedFromFile)) { return false; } // median speed
-	if (!readValueIntoField(fileStream, &statsDataPointer->Stats.MeanGoalSpeedFromFile)) { return false; } // mean speed
+	// These statistics are replaced by the ones of the single values, in case those get read
+	auto& goalSpeed = statsData.Stats.GoalSpeed;
+	if (!cursor.readValue(goalSpeed.MostRecent)) { return false; } // latest speed
+	if (!cursor.readValue(goalSpeed.Max)) { return false; } // max speed
+	if (!cursor.readValue(goalSpeed.Min)) { return false; } // min speed
+	if (!cursor.readValue(goalSpeed.Median)) { return false; } // median speed
+	if (!cursor.readValue(goalSpeed.Mean)) { return false; } // mean speed
 
-	if (!readValueIntoField(fileStream, &statsDataPointer->Data.InitialHitPercentage)) { return false; }
-	if (!readValueIntoField(fileStream, &statsDataPointer->Data.SuccessPercentage)) { return false; }
-	if (!readValueIntoField(fileStream, &statsDataPointer->Data.PeakSuccessPercentage)) { return false; }
-	if (!readValueIntoField(fileStream, &statsDataPointer->Data.PeakShotNumber)) { return false; }
+	if (!cursor.readValue(statsData.Data.InitialHitPercentage)) { return false; }
+	if (!cursor.readValue(statsData.Data.SuccessPercentage)) { return false; }
+	if (!cursor.readValue(statsData.Data.PeakSuccessPercentage)) { return false; }
+	if (!cursor.readValue(statsData.Data.PeakShotNumber)) { return false; }
 
 	return true;
 }
 
-bool StatFileReader::readVersion_1_1_additions(std::ifstream& fileStream, StatsData* const statsDataPointer)
+bool StatFileReader::readVersion_1_1_additions(TextCursor& cursor, StatsData& statsData)
 {
-	if (!readValueIntoField(fileStream, &statsDataPointer->Stats.MaxAirDribbleTouches)) { return false; }
-	if (!readValueIntoField(fileStream, &statsDataPointer->Stats.MaxAirDribbleTime)) { return false; }
-	if (!readValueIntoField(fileStream, &statsDataPointer->Stats.MaxGroundDribbleTime)) { return false; }
-	if (!readValueIntoField(fileStream, &statsDataPointer->Stats.DoubleTapGoals)) { return false; }
-	if (!readValueIntoField(fileStream, &statsDataPointer->Data.DoubleTapGoalPercentage)) { return false; }
-	if (!readValueIntoField(fileStream, &statsDataPointer->Stats.MaxFlipResets)) { return false; }
-	if (!readValueIntoField(fileStream, &statsDataPointer->Stats.TotalFlipResets)) { return false; }
-	if (!readValueIntoField(fileStream, &statsDataPointer->Data.AverageFlipResetsPerAttempt)) { return false; }
-	if (!readValueIntoField(fileStream, &statsDataPointer->Data.FlipResetGoalPercentage)) { return false; }
-	if (!readValueIntoField(fileStream, &statsDataPointer->Stats.CloseMisses)) { return false; }
-	if (!readValueIntoField(fileStream, &statsDataPointer->Data.CloseMissPercentage)) { return false; }
+	if (!cursor.readValue(statsData.Stats.MaxAirDribbleTouches)) { return false; }
+	if (!cursor.readValue(statsData.Stats.MaxAirDribbleTime)) { return false; }
+	if (!cursor.readValue(statsData.Stats.MaxGroundDribbleTime)) { return false; }
+	if (!cursor.readValue(statsData.Stats.DoubleTapGoals)) { return false; }
+	if (!cursor.readValue(statsData.Data.DoubleTapGoalPercentage)) { return false; }
+	if (!cursor.readValue(statsData.Stats.MaxFlipResets)) { return false; }
+	if (!cursor.readValue(statsData.Stats.TotalFlipResets)) { return false; }
+	if (!cursor.readValue(statsData.Data.AverageFlipResetsPerAttempt)) { return false; }
+	if (!cursor.readValue(statsData.Data.FlipResetGoalPercentage)) { return false; }
+	if (!cursor.readValue(statsData.Stats.CloseMisses)) { return false; }
+	if (!cursor.readValue(statsData.Data.CloseMissPercentage)) { return false; }
 
 	return true;
 }
 
-bool StatFileReader::readVersion_1_2_additions(std::ifstream& fileStream, bool statsAboutToBeRestored)
+bool StatFileReader::readVersion_1_2_additions(TextCursor& cursor, std::vector<Vector>* impactLocations)
 {
-	std::string currentLine;
-	if (!std::getline(fileStream, currentLine)) { return false; } // This line will contain the whole vector
+	std::string_view currentLine;
+	if (!cursor.readLine(currentLine)) { return false; } // This line will contain the whole vector
 	if (currentLine.empty()) { return false; }
 
 	// if stats won't be restored in this run (and data area only gathered for comparison instead) we can skip this code.
 	// comparing heatmaps or shot locations isn't really supported (or even possible?)
-	if (!statsAboutToBeRestored) { return true; }
+	if (!impactLocations) { return true; }
 
-	auto [key, allShotLocations] = getLineValues(currentLine);
+	std::string_view key, allShotLocations;
+	if (!TextCursor::nextToken(currentLine, '\t', key)) { return false; }
+	allShotLocations = currentLine;
 	if (key.empty() || allShotLocations.empty()) { return false; }
 
 	if (key != StatFileDefs::ImpactLocations) { return false; }
 
 	const char separator = '|';
-	// read until the first separator
 
-	auto separatorPos = allShotLocations.find(separator);
-	if (separatorPos == std::string::npos) { return false; }
+	// Try to read the size of the vector
+	std::string_view sizeText;
+	int size;
+	if (!TextCursor::nextToken(allShotLocations, separator, sizeText) || !TextCursor::parse(sizeText, size)) { return false; }
 
-	// Try to read the size of the vector	
-	if (auto size = std::stoi(allShotLocations.substr(0, separatorPos)); size > 0)
+	for (int index = 0; index < size; index++)
 	{
-		size_t offset = separatorPos + 1;
-		for (int index = 0; index < size; index++)
+		// Parse a vector string like "3.456,2.3154,9.223". Impact locations have always been written with '.' as decimal separator
+		std::string_view xText, yText, zText;
+		Vector vector;
+		if (!TextCursor::nextToken(allShotLocations, ',', xText) || !TextCursor::parse(xText, vector.X) ||
+			!TextCursor::nextToken(allShotLocations, ',', yText) || !TextCursor::parse(yText, vector.Y) ||
+			!TextCursor::nextToken(allShotLocations, separator, zText) || !TextCursor::parse(zText, vector.Z))
 		{
-			// Parse a vector string like "3.456,2.3154,9.223"
-			auto valueSeparatorPos = allShotLocations.find(",", offset);
-			if (valueSeparatorPos == std::string::npos) { return false; }
-
-			Vector vector;
-			vector.X = std::stof(allShotLocations.substr(offset, valueSeparatorPos - offset));
-			offset = valueSeparatorPos + 1;
-
-			valueSeparatorPos = allShotLocations.find(",", offset);
-			if (valueSeparatorPos == std::string::npos) { return false; }
-
-			vector.Y = std::stof(allShotLocations.substr(offset, valueSeparatorPos - offset));
-			offset = valueSeparatorPos + 1;
-
-			valueSeparatorPos = allShotLocations.find(separator, offset);
-			if (valueSeparatorPos == std::string::npos) { return false; }
-
-			vector.Z = std::stof(allShotLocations.substr(offset, valueSeparatorPos - offset));
-			offset = valueSeparatorPos + 1;
-
-			// restore both impact locations and heatmap by simulating the impacts in the same order
-			_shotDistributionTracker->registerImpactLocation(vector);
+			return false;
 		}
+
+		impactLocations->push_back(vector);
 	}
 	// Else: Size 0 is valid, this just means none of the attempts hit the wall or the goal (will be rare)
 
 	return true;
 }
 
-bool StatFileReader::readVersion_1_3_additions(std::ifstream& fileStream, StatsData* const statsDataPointer)
+bool StatFileReader::readVersion_1_3_additions(TextCursor& cursor, IGoalSpeedProvider* goalSpeedValues, GoalSpeedSummary* goalSpeedDeviation)
 {
-	std::string currentLine;
-	if (!std::getline(fileStream, currentLine)) { return false; } // This line will contain the whole vector
+	std::string_view currentLine;
+	if (!cursor.readLine(currentLine)) { return false; } // This line will contain the whole vector
 	if (currentLine.empty()) { return false; }
 
-	auto [key, allGoalSpeeds] = getLineValues(currentLine);
-	if (key.empty()) { return false; }
+	std::string_view key;
+	if (!TextCursor::nextToken(currentLine, '\t', key) || key.empty()) { return false; }
+	auto allGoalSpeeds = currentLine;
 
 	if (allGoalSpeeds.empty())
 	{
@@ -352,27 +799,38 @@ bool StatFileReader::readVersion_1_3_additions(std::ifstream& fileStream, StatsD
 
 	if (key != StatFileDefs::GoalSpeedValues) { return false; }
 
+	// Unless the values or at least their deviation are required, there is nothing left to do for this line
+	if (!goalSpeedValues && !goalSpeedDeviation) { return true; }
+
 	const char separator = '|';
-	// read until the first separator
 
-	auto separatorPos = allGoalSpeeds.find(separator);
-	if (separatorPos == std::string::npos) { return false; }
+	// Try to read the size of the vector
+	std::string_view sizeText;
+	int size;
+	if (!TextCursor::nextToken(allGoalSpeeds, separator, sizeText) || !TextCursor::parse(sizeText, size)) { return false; }
 
-	// Try to read the size of the vector	
-	if (auto size = std::stoi(allGoalSpeeds.substr(0, separatorPos)); size > 0)
+	RunningMean deviation;
+	for (int index = 0; index < size; index++)
 	{
-		size_t offset = separatorPos + 1;
-		for (int index = 0; index < size; index++)
-		{
-			// Get the next float value
-			separatorPos = allGoalSpeeds.find(separator, offset);
-			if (separatorPos == std::string::npos) { return false; }
+		// Get the next float value
+		std::string_view goalSpeedText;
+		float goalSpeed;
+		if (!TextCursor::nextToken(allGoalSpeeds, separator, goalSpeedText) || !TextCursor::parse(goalSpeedText, goalSpeed)) { return false; }
 
+		if (goalSpeedValues)
+		{
 			// Register the goal speed value as if the player had taken the shot
-			statsDataPointer->Stats.GoalSpeedStats()->insert(std::stof(allGoalSpeeds.substr(offset, separatorPos - offset)));
-			offset = separatorPos + 1;
+			goalSpeedValues->insert(goalSpeed);
+		}
+		else
+		{
+			deviation.insert(goalSpeed);
 		}
 	}
 
+	if (goalSpeedDeviation)
+	{
+		goalSpeedDeviation->StdDev = deviation.getStdDev();
+	}
 	return true;
-}
\ No newline at end of file
+}
@@ -2,31 +2,74 @@
 
 #include "../Core/IStatReader.h"
 #include "../Calculation/ShotDistributionTracker.h"
+#include "BinaryCursor.h"
+#include "MemoryMappedFile.h"
+#include "TextCursor.h"
+#include "AttemptJournal.h"
+#include "../Data/SketchedGoalSpeed.h"
+#include "SessionIndex.h"
+#include "../Data/StoredImpacts.h"
 
 class GOALPERCENTAGECOUNTER_IMPORT_EXPORT StatFileReader : public IStatReader
 {
 public:
-	StatFileReader(std::shared_ptr<GameWrapper> gameWrapper, std::shared_ptr<ShotDistributionTracker> shotDistributionTracker);
+	StatFileReader(std::shared_ptr<GameWrapper> gameWrapper, std::shared_ptr<ShotDistributionTracker> shotDistributionTracker, std::shared_ptr<SessionIndex> sessionIndex);
 
 	// Inherited via IStatReader
 	std::vector<std::string> getAvailableResourcePaths(const std::string& trainingPackCode) override;
-	ShotStats readStats(const std::string& resourcePath, bool statsAboutToBeRestored) override;
+	ShotStats readStats(const std::string& resourcePath, StatFieldMask fields) override;
 
 	ShotStats readTrainingPackStatistics(const std::string& trainingPackCode) override;
 
+	StoredImpacts readImpactLocations(const std::string& resourcePath) override;
+
 	int peekAttemptAmount(const std::string& resourcePath) override;
 
 private:
+	/** Reads the attempts, goals, number of shots and version of a session file, including the attempts of its journal. Used for building the session index. */
+	bool readSessionSummary(const std::filesystem::path& filePath, SessionIndexEntry& entry);
+	/** Reads the summary from a binary stat file (version 2.0 and later). */
+	bool peekBinarySummary(const MemoryMappedFile& file, SessionIndexEntry& entry);
+	/** Reads the summary from a text stat file (version 1.0 to 1.3). */
+	bool peekTextSummary(const MemoryMappedFile& file, SessionIndexEntry& entry);
+
+	/** Reads the requested fields of the given session, including its journal. Impact locations are stored in the given object rather than being registered. */
+	ShotStats readStats(const std::string& resourcePath, StatFieldMask fields, StoredImpacts& impacts);
+
+	/** Reads a binary stat file (version 2.0 and later) directly from the mapped memory. */
+	bool readBinaryStats(const MemoryMappedFile& file, ShotStats& stats, StatFieldMask fields, StoredImpacts& impacts);
+	/** Reads a single entry of the record table of a binary stat file. */
+	bool readBinaryRecord(BinaryCursor cursor, StatsData& statsData);
+	/** Reads the impact location section of a binary stat file. */
+	bool readBinaryImpactLocations(BinaryCursor cursor, std::vector<Vector>& impactLocations);
+	/** Reads the heatmap section of a binary stat file. The heatmap is ignored if it does not belong to the impact locations which have been read. */
+	bool readBinaryHeatmap(BinaryCursor cursor, StoredImpacts& impacts);
+	/** Reads the sketch of the summary from the goal speed sketch section of a binary stat file. */
+	bool readBinaryGoalSpeedSketch(BinaryCursor cursor, SketchedGoalSpeed& goalSpeedSketch);
+	/** Reads the goal speed section of a binary stat file. Each list of values is inserted into the respective target, lists without a target are not read. */
+	bool readBinaryGoalSpeedValues(BinaryCursor cursor, const std::vector<IGoalSpeedProvider*>& goalSpeedValues);
+	/** Calculates the standard deviation of each list of values in the goal speed section of a binary stat file, without storing the values. */
+	bool readBinaryGoalSpeedDeviations(BinaryCursor cursor, const std::vector<GoalSpeedSummary*>& goalSpeedStatistics);
+	/** Reads the recent shots of the summary and any shot which has been read, replacing the recent shots stored in the records. */
+	bool readBinaryRecentShots(BinaryCursor cursor, ShotStats& stats);
+	/** Reads the rolling windows of the summary and any shot which has been read. */
+	bool readBinaryRollingWindows(BinaryCursor cursor, ShotStats& stats);
+
+	/** Reads a text stat file (version 1.0 to 1.3) directly from the mapped memory. */
+	bool readTextStats(const MemoryMappedFile& file, ShotStats& stats, StatFieldMask fields, std::vector<Vector>& impactLocations);
 
 	/** Reads the stat block which was available in version 1.0. So far, we only extend the block so we can read it the same way in v1.0 files and later files. */
-	bool readVersion_1_0(std::ifstream& fileStream, StatsData* const statsDataPointer);
+	bool readVersion_1_0(TextCursor& cursor, StatsData& statsData);
 	/** Reads attributes which were added in version 1.1. */
-	bool readVersion_1_1_additions(std::ifstream& fileStream, StatsData* const statsDataPointer);
-	/** Reads attributes which were added in verison 1.2 (heat map). */
-	bool readVersion_1_2_additions(std::ifstream& fileStream, bool statsAboutToBeRestored);
-	/** Reads attributes which were added in version 1.3 (goal speed). */
-	bool readVersion_1_3_additions(std::ifstream& fileStream, StatsData* const statsDataPointer);
+	bool readVersion_1_1_additions(TextCursor& cursor, StatsData& statsData);
+	/** Reads attributes which were added in verison 1.2 (heat map). Impact locations are skipped if impactLocations is nullptr. */
+	bool readVersion_1_2_additions(TextCursor& cursor, std::vector<Vector>* impactLocations);
+	/** Reads attributes which were added in version 1.3 (goal speed). The values are inserted into goalSpeedValues if it is set. Otherwise, if goalSpeedDeviation is set, only the deviation of the values gets calculated. */
+	bool readVersion_1_3_additions(TextCursor& cursor, IGoalSpeedProvider* goalSpeedValues, GoalSpeedSummary* goalSpeedDeviation);
+	/** Applies the attempts which were appended to the journal of the session after its file had been written. */
+	void replayJournal(const std::vector<AttemptJournalRecord>& journalRecords, ShotStats& stats, std::vector<Vector>* impactLocations);
 
 	std::shared_ptr<GameWrapper> _gameWrapper;
 	std::shared_ptr<ShotDistributionTracker> _shotDistributionTracker;
+	std::shared_ptr<SessionIndex> _sessionIndex; ///< Allows looking up sessions without opening them. May be nullptr, in which case the folder gets read every time.
 };
\ No newline at end of file
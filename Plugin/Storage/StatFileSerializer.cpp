@@ -0,0 +1,154 @@
+#include <pch.h>
+#include "StatFileSerializer.h"
+#include "StatFileDefs.h"
+
+#include <cstdio>
+
+const char LineSeparator = '\n'; // Converted to the platform line ending by the text mode file stream, just like std::endl would be
+const char ValueSeparator = '\t';
+const char VectorSeparator = '|';
+
+// Formats the given value the way printf would do it, which includes the decimal separator of the current C locale.
+// This keeps the output identical to what std::to_string() (%f) and std::ostream (%g) used to produce.
+template<size_t BufferSize>
+void appendPrintfValue(fmt::memory_buffer& buffer, const char* format, double value)
+{
+	char valueString[BufferSize];
+	auto length = std::snprintf(valueString, BufferSize, format, value);
+	if (length <= 0) { return; }
+	buffer.append(valueString, valueString + std::min<size_t>((size_t)length, BufferSize - 1));
+}
+
+void appendString(fmt::memory_buffer& buffer, const std::string& value)
+{
+	buffer.append(value.data(), value.data() + value.size());
+}
+
+std::string_view StatFileSerializer::serialize(const ShotStats& stats, const std::vector<Vector>* impactLocations)
+{
+	_buffer.clear();
+
+	appendLine(StatFileDefs::Version, StatFileDefs::CurrentTextVersionNumber);
+	appendLine(StatFileDefs::NumberOfShots, (int)stats.PerShotStats.size());
+
+	appendStatsData(stats.AllShotStats, stats.getGoalSpeedValues(-1), impactLocations);
+
+	for (auto shotIndex = 0; shotIndex < (int)stats.PerShotStats.size(); shotIndex++)
+	{
+		// Shot locations are only available once for the session rather than for every shot
+		appendStatsData(stats.PerShotStats[shotIndex], stats.getGoalSpeedValues(shotIndex), nullptr);
+	}
+
+	return std::string_view(_buffer.data(), _buffer.size());
+}
+
+void StatFileSerializer::appendStatsData(const StatsData& statsData, const GoalSpeed& goalSpeed, const std::vector<Vector>* impactLocations)
+{
+	appendString(_buffer, StatFileDefs::ShotSeparator);
+	_buffer.push_back(LineSeparator);
+
+	// Player Stats
+	appendLine(StatFileDefs::Attempts, statsData.Stats.Attempts);
+	appendLine(StatFileDefs::Goals, statsData.Stats.Goals);
+	appendLine(StatFileDefs::InitialHits, statsData.Stats.InitialHits);
+	appendLine(StatFileDefs::CurrentGoalStreak, statsData.Stats.GoalStreakCounter);
+	appendLine(StatFileDefs::CurrentMissStreak, statsData.Stats.MissStreakCounter);
+	appendLine(StatFileDefs::LongestGoalStreak, statsData.Stats.LongestGoalStreak);
+	appendLine(StatFileDefs::LongestMissStreak, statsData.Stats.LongestMissStreak);
+	appendRecentShots(StatFileDefs::LastNShotsPercentage, statsData.Stats.RecentShots);
+	appendLine(StatFileDefs::LatestGoalSpeed, statsData.Stats.GoalSpeed.MostRecent);
+	appendLine(StatFileDefs::MaxGoalSpeed, statsData.Stats.GoalSpeed.Max);
+	appendLine(StatFileDefs::MinGoalSpeed, statsData.Stats.GoalSpeed.Min);
+	appendLine(StatFileDefs::MedianGoalSpeed, statsData.Stats.GoalSpeed.Median);
+	appendLine(StatFileDefs::MeanGoalSpeed, statsData.Stats.GoalSpeed.Mean);
+
+	// Calculated stats
+	appendLine(StatFileDefs::InitialHitPercentage, statsData.Data.InitialHitPercentage);
+	appendLine(StatFileDefs::TotalSuccessRate, statsData.Data.SuccessPercentage);
+	appendLine(StatFileDefs::PeakSuccessRate, statsData.Data.PeakSuccessPercentage);
+	appendLine(StatFileDefs::PeakAtShotNumber, statsData.Data.PeakShotNumber);
+
+	// v1.1 stats
+	appendLine(StatFileDefs::AirDribbleTouches, statsData.Stats.MaxAirDribbleTouches);
+	appendLine(StatFileDefs::AirDribbleTime, statsData.Stats.MaxAirDribbleTime);
+	appendLine(StatFileDefs::GroundDribbleTime, statsData.Stats.MaxGroundDribbleTime);
+	appendLine(StatFileDefs::DoubleTapGoals, statsData.Stats.DoubleTapGoals);
+	appendLine(StatFileDefs::DoubleTapPercentage, statsData.Data.DoubleTapGoalPercentage);
+	appendLine(StatFileDefs::MaxFlipResets, statsData.Stats.MaxFlipResets);
+	appendLine(StatFileDefs::TotalFlipResets, statsData.Stats.TotalFlipResets);
+	appendLine(StatFileDefs::FlipResetsPerAttempt, statsData.Data.AverageFlipResetsPerAttempt);
+	appendLine(StatFileDefs::FlipResetPercentage, statsData.Data.FlipResetGoalPercentage);
+	appendLine(StatFileDefs::CloseMisses, statsData.Stats.CloseMisses);
+	appendLine(StatFileDefs::CloseMissPercentage, statsData.Data.CloseMissPercentage);
+
+	// v1.2 stats - Shot locations are only available once for the session rather than for every shot. They are also not tracked for the all time peak stats.
+	static const std::vector<Vector> NoImpactLocations;
+	appendShotLocationVector(StatFileDefs::ImpactLocations, impactLocations ? *impactLocations : NoImpactLocations);
+
+	// v1.3 stats
+	appendFloatVector(StatFileDefs::GoalSpeedValues, goalSpeed.getValues());
+}
+
+void StatFileSerializer::appendLine(const std::string& label, int value)
+{
+	appendString(_buffer, label);
+	_buffer.push_back(ValueSeparator);
+	fmt::format_to(_buffer, "{}", value);
+	_buffer.push_back(LineSeparator);
+}
+
+void StatFileSerializer::appendLine(const std::string& label, double value)
+{
+	appendString(_buffer, label);
+	_buffer.push_back(ValueSeparator);
+	appendPrintfValue<384>(_buffer, "%f", value); // Large enough for any double value formatted through %f
+	_buffer.push_back(LineSeparator);
+}
+
+void StatFileSerializer::appendLine(const std::string& label, const std::string& value)
+{
+	appendString(_buffer, label);
+	_buffer.push_back(ValueSeparator);
+	appendString(_buffer, value);
+	_buffer.push_back(LineSeparator);
+}
+
+void StatFileSerializer::appendRecentShots(const std::string& label, const decltype(PlayerStats::RecentShots)& shots)
+{
+	appendString(_buffer, label);
+	_buffer.push_back(ValueSeparator);
+	// Same format as RecentShotWindow::toString(), but without creating a temporary string
+	for (size_t index = 0; index < shots.size(); index++)
+	{
+		_buffer.push_back(shots[index] ? '1' : '0');
+	}
+	_buffer.push_back(LineSeparator);
+}
+
+void StatFileSerializer::appendFloatVector(const std::string& label, const std::vector<float>& values)
+{
+	appendString(_buffer, label);
+	_buffer.push_back(ValueSeparator);
+	fmt::format_to(_buffer, "{}", values.size());
+	_buffer.push_back(VectorSeparator);
+	for (auto value : values)
+	{
+		appendPrintfValue<32>(_buffer, "%g", value);
+		_buffer.push_back(VectorSeparator);
+	}
+	_buffer.push_back(LineSeparator);
+}
+
+void StatFileSerializer::appendShotLocationVector(const std::string& label, const std::vector<Vector>& values)
+{
+	appendString(_buffer, label);
+	_buffer.push_back(ValueSeparator);
+	fmt::format_to(_buffer, "{}", values.size());
+	_buffer.push_back(VectorSeparator);
+	for (const auto& vector : values)
+	{
+		fmt::format_to(_buffer, "{},{},{}", vector.X, vector.Y, vector.Z);
+		_buffer.push_back(VectorSeparator);
+	}
+	_buffer.push_back(LineSeparator);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include <bakkesmod/wrappers/wrapperstructs.h>
+#include <fmt/format.h>
+
+#include "../Data/ShotStats.h"
+
+/** Formats ShotStats objects into the text format defined by StatFileDefs. This format is used for all time peak stats.
+ *
+ * The whole session gets formatted into a single memory buffer which is reused between calls, so the caller can hand it to the file in one write
+ * rather than flushing the stream for every single line.
+ */
+class StatFileSerializer
+{
+public:
+	StatFileSerializer() = default;
+
+	/** Formats the given stats and returns a view on the result. The view stays valid until serialize() gets called again.
+	 *
+	 * \param	stats				The stats to be formatted.
+	 * \param	impactLocations		The impact locations of the session, or nullptr if they shall not be written (e.g. for all time peak stats).
+	 */
+	std::string_view serialize(const ShotStats& stats, const std::vector<Vector>* impactLocations);
+
+private:
+	void appendStatsData(const StatsData& statsData, const GoalSpeed& goalSpeed, const std::vector<Vector>* impactLocations);
+	void appendLine(const std::string& label, int value);
+	void appendLine(const std::string& label, double value);
+	void appendLine(const std::string& label, const std::string& value);
+	void appendRecentShots(const std::string& label, const decltype(PlayerStats::RecentShots)& shots);
+	void appendFloatVector(const std::string& label, const std::vector<float>& values);
+	void appendShotLocationVector(const std::string& label, const std::vector<Vector>& values);
+
+	fmt::memory_buffer _buffer; ///< Stores the formatted file content. Reused in order to avoid reallocating it for every write.
+};
@@ -9,16 +9,26 @@
 
 #include "StatFileWriter.h"
 #include "StatFileDefs.h"
+#include "AttemptJournal.h"
 
 
 using sysclock_t = std::chrono::system_clock;
 
 static const char* const CurrentVersion = "1.0";
 
-StatFileWriter::StatFileWriter(std::shared_ptr<GameWrapper> gameWrapper, std::shared_ptr<ShotStats> shotStats, std::shared_ptr<ShotDistributionTracker> tracker)
+StatFileWriter::StatFileWriter(
+	std::shared_ptr<GameWrapper> gameWrapper,
+	std::shared_ptr<ShotStats> shotStats,
+	std::shared_ptr<ShotDistributionTracker> tracker,
+	std::shared_ptr<SessionIndex> sessionIndex,
+	std::shared_ptr<StorageWorker> storageWorker,
+	std::shared_ptr<SessionPrefetchCache> prefetchCache)
 	: _gameWrapper(gameWrapper)
 	, _currentStats(shotStats)
 	, _shotDistributionTracker(tracker)
+	, _sessionIndex(sessionIndex)
+	, _storageWorker(storageWorker)
+	, _prefetchCache(prefetchCache)
 {
 }
 
@@ -36,8 +46,11 @@ std::string currentDate()
 void StatFileWriter::initializeStorage(const std::string& trainingPackCode)
 {
 	// Create a folder for each training pack
-	auto trainingFolder = StatFileDefs::getTrainingFolder(_gameWrapper, trainingPackCode);
-	auto folderPath = std::filesystem::u8path(trainingFolder);
+	initializeStorageInFolder(std::filesystem::u8path(StatFileDefs::getTrainingFolder(_gameWrapper, trainingPackCode)));
+}
+
+void StatFileWriter::initializeStorageInFolder(const std::filesystem::path& folderPath)
+{
 	if (!std::filesystem::exists(folderPath) && !std::filesystem::create_directories(folderPath))
 	{
 		// We can't write data => this feature simply won't be supported
@@ -45,10 +58,12 @@ void StatFileWriter::initializeStorage(const std::string& trainingPackCode)
 		return;
 	}
 
-	// Create a file for each time initializeStorage() is called
-	std::ostringstream stringStream;
-	stringStream << trainingFolder << "\\" << currentDate() << ".txt";
-	_outputFilePath = std::filesystem::u8path(stringStream.str());
+	// Create a file for each time initializeStorage() is called. Failures of the previous session don't affect the new one
+	_outputFilePath = folderPath / std::filesystem::u8path(currentDate() + StatFileDefs::BinaryFileExtension);
+	_journalFilePath = AttemptJournal::getJournalPath(_outputFilePath);
+	_snapshotIsValid = false;
+	_numberOfJournalRecords = 0;
+	_sessionWriteFailed = false;
 
 	std::ofstream outputFileStream;
 	outputFileStream.open(_outputFilePath, std::ios::out);
@@ -62,127 +77,235 @@ void StatFileWriter::initializeStorage(const std::string& trainingPackCode)
 	outputFileStream.close();
 }
 
-void writeLine(std::ofstream& stream, const std::string& label, const std::string& value)
+void StatFileWriter::writeData()
 {
-	stream << label << "\t" << value << std::endl;
+	if (!_currentStats)
+	{
+		return;
+	}
+
+	// Rewriting the whole session gets more expensive the longer it lasts, so single attempts only get appended to the journal.
+	// If a previous write failed, the files are in an unknown state, so they get replaced by a snapshot
+	if (_snapshotIsValid && !_sessionWriteFailed && (statsAreUnchanged() || tryAppendJournalRecord()))
+	{
+		return;
+	}
+
+	writeSnapshot();
 }
 
-std::string bool_vector_to_string(const std::vector<bool>& values)
+void StatFileWriter::compactStorage()
 {
-	std::ostringstream stream;
-	for (auto value : values)
+	// Only compact if the stats are still the ones which were stored last, since an attempt might currently be in progress.
+	// If that is the case, the journal stays in place, which is fine since reading a session replays it anyway.
+	// A snapshot is also written if the previous write failed, since this is the last chance to store the session.
+	if (!_currentStats || (_numberOfJournalRecords == 0 && !_sessionWriteFailed) || !statsAreUnchanged())
 	{
-		stream << (value ? "1" : "0");
+		return;
 	}
-	return stream.str();
+
+	writeSnapshot();
+}
+
+StatFileWriter::WrittenStatsState StatFileWriter::getWrittenStatsState(const StatsData& statsData)
+{
+	WrittenStatsState state;
+	state.Attempts = statsData.Stats.Attempts;
+	state.Goals = statsData.Stats.Goals;
+	state.InitialHits = statsData.Stats.InitialHits;
+	state.NumberOfGoalSpeedValues = statsData.Stats.GoalSpeed.Count;
+	return state;
 }
 
-std::string float_vector_to_string(const std::vector<float>& values)
+bool StatFileWriter::statsAreUnchanged() const
 {
-	std::ostringstream stream;
-	const char vectorSeparator = '|';
-	stream << std::to_string(values.size()) + vectorSeparator;
-	for (auto value : values)
+	if (_currentStats->PerShotStats.size() != _writtenShotStates.size() ||
+		getImpactLocations().size() != _writtenNumberOfImpactLocations ||
+		getWrittenStatsState(_currentStats->AllShotStats) != _writtenSummaryState)
+	{
+		return false;
+	}
+
+	for (size_t shotIndex = 0; shotIndex < _writtenShotStates.size(); shotIndex++)
 	{
-		stream << value << vectorSeparator;
+		if (getWrittenStatsState(_currentStats->PerShotStats[shotIndex]) != _writtenShotStates[shotIndex])
+		{
+			return false;
+		}
 	}
-	return stream.str();
+	return true;
 }
 
-std::string shot_location_vector_to_string(const std::vector<Vector>& values)
+bool StatFileWriter::tryAppendJournalRecord()
 {
-	std::ostringstream stream;
-	const char vectorSeparator = '|';
-	stream << std::to_string(values.size()) + vectorSeparator;
-	for (auto vector : values)
+	if (_currentStats->PerShotStats.size() != _writtenShotStates.size()) { return false; }
+
+	// Exactly one attempt must have been added to the summary...
+	auto summaryState = getWrittenStatsState(_currentStats->AllShotStats);
+	if (summaryState.Attempts != _writtenSummaryState.Attempts + 1) { return false; }
+
+	// ... and to exactly one shot, without changing any other shot (which could e.g. happen when toggling the last attempt after switching shots)
+	int changedShotIndex = -1;
+	for (size_t shotIndex = 0; shotIndex < _writtenShotStates.size(); shotIndex++)
+	{
+		if (getWrittenStatsState(_currentStats->PerShotStats[shotIndex]) != _writtenShotStates[shotIndex])
+		{
+			if (changedShotIndex >= 0) { return false; }
+			changedShotIndex = (int)shotIndex;
+		}
+	}
+	if (changedShotIndex < 0) { return false; }
+
+	auto shotState = getWrittenStatsState(_currentStats->PerShotStats[changedShotIndex]);
+	const auto& writtenShotState = _writtenShotStates[changedShotIndex];
+	if (shotState.Attempts != writtenShotState.Attempts + 1) { return false; }
+
+	// A record can store at most one additional goal speed value, which must have been added to both the summary and the shot
+	auto numberOfNewGoalSpeedValues = summaryState.NumberOfGoalSpeedValues - _writtenSummaryState.NumberOfGoalSpeedValues;
+	if (summaryState.NumberOfGoalSpeedValues < _writtenSummaryState.NumberOfGoalSpeedValues ||
+		numberOfNewGoalSpeedValues > 1 ||
+		shotState.NumberOfGoalSpeedValues != writtenShotState.NumberOfGoalSpeedValues + numberOfNewGoalSpeedValues)
+	{
+		return false;
+	}
+
+	const auto& impactLocations = getImpactLocations();
+	if (impactLocations.size() < _writtenNumberOfImpactLocations ||
+		impactLocations.size() - _writtenNumberOfImpactLocations > AttemptJournalRecord::MaxImpactLocations)
 	{
-		stream << fmt::format("{},{},{}{}", vector.X, vector.Y, vector.Z, vectorSeparator);
+		return false;
 	}
-	return stream.str();
+	std::vector<Vector> newImpactLocations(impactLocations.begin() + _writtenNumberOfImpactLocations, impactLocations.end());
+
+	auto record = AttemptJournal::createRecord(*_currentStats, changedShotIndex, numberOfNewGoalSpeedValues == 1, newImpactLocations);
+	_numberOfJournalRecords++;
+	updateWrittenState();
+
+	// The record belongs to the session file, so a snapshot which gets queued later on makes it obsolete
+	executeWrite(_outputFilePath, false, [this, outputFilePath = _outputFilePath, journalFilePath = _journalFilePath, record, entry = getSessionIndexEntry()]() {
+		if (!AttemptJournal::appendRecord(journalFilePath, record))
+		{
+			_sessionWriteFailed = true;
+			return;
+		}
+		updateSessionIndex(outputFilePath, entry, false); // The index will notice the journal anyway when it gets loaded next time
+	});
+	invalidatePrefetchedSession();
+
+	// Without a storage worker, the record has been appended already. Otherwise, a failure will be noticed on the next write
+	return !_sessionWriteFailed; // Try writing a snapshot instead if appending failed
 }
 
-void StatFileWriter::writeStatsData(std::ofstream& stream, const StatsData& statsData, bool isSummaryData, bool skipUncomparableStats)
+void StatFileWriter::writeSnapshot()
 {
-	stream << StatFileDefs::ShotSeparator << std::endl;
+	// Sessions are stored in the binary format since they get read much more often than they get written.
+	// The content gets copied since the stats may change before the file gets written
+	auto heatmap = _shotDistributionTracker ? &_shotDistributionTracker->getHeatmap() : nullptr;
+	auto fileContent = std::string(_binarySerializer.serialize(*_currentStats, &getImpactLocations(), heatmap));
+	_numberOfJournalRecords = 0;
+	_sessionWriteFailed = false;
+	updateWrittenState();
+	_snapshotIsValid = true;
+
+	executeWrite(_outputFilePath, true, [this, outputFilePath = _outputFilePath, journalFilePath = _journalFilePath, fileContent = std::move(fileContent), entry = getSessionIndexEntry()]() {
+		if (!writeToFile(outputFilePath, fileContent, std::ios::binary))
+		{
+			_sessionWriteFailed = true;
+			return;
+		}
 
-	// Player Stats
-	writeLine(stream, StatFileDefs::Attempts, std::to_string(statsData.Stats.Attempts));
-	writeLine(stream, StatFileDefs::Goals, std::to_string(statsData.Stats.Goals));
-	writeLine(stream, StatFileDefs::InitialHits, std::to_string(statsData.Stats.InitialHits));
-	writeLine(stream, StatFileDefs::CurrentGoalStreak, std::to_string(statsData.Stats.GoalStreakCounter));
-	writeLine(stream, StatFileDefs::CurrentMissStreak, std::to_string(statsData.Stats.MissStreakCounter));
-	writeLine(stream, StatFileDefs::LongestGoalStreak, std::to_string(statsData.Stats.LongestGoalStreak));
-	writeLine(stream, StatFileDefs::LongestMissStreak, std::to_string(statsData.Stats.LongestMissStreak));
-	writeLine(stream, StatFileDefs::LastNShotsPercentage, bool_vector_to_string(statsData.Stats.Last50Shots));
-	writeLine(stream, StatFileDefs::LatestGoalSpeed, std::to_string(statsData.Stats.GoalSpeedStats()->getMostRecent()));
-	writeLine(stream, StatFileDefs::MaxGoalSpeed, std::to_string(statsData.Stats.GoalSpeedStats()->getMax()));
-	writeLine(stream, StatFileDefs::MinGoalSpeed, std::to_string(statsData.Stats.GoalSpeedStats()->getMin()));
-	writeLine(stream, StatFileDefs::MedianGoalSpeed, std::to_string(statsData.Stats.GoalSpeedStats()->getMedian()));
-	writeLine(stream, StatFileDefs::MeanGoalSpeed, std::to_string(statsData.Stats.GoalSpeedStats()->getMean()));
+		// The snapshot contains everything the journal contained. The journal is removed even if no record was appended since the last
+		// snapshot, since that snapshot might have been dropped in favor of this one
+		AttemptJournal::removeJournal(journalFilePath);
+		updateSessionIndex(outputFilePath, entry, true);
+	});
+	invalidatePrefetchedSession();
+}
 
-	// Calculated stats
-	writeLine(stream, StatFileDefs::InitialHitPercentage, std::to_string(statsData.Data.InitialHitPercentage));
-	writeLine(stream, StatFileDefs::TotalSuccessRate, std::to_string(statsData.Data.SuccessPercentage));
-	writeLine(stream, StatFileDefs::PeakSuccessRate, std::to_string(statsData.Data.PeakSuccessPercentage));
-	writeLine(stream, StatFileDefs::PeakAtShotNumber, std::to_string(statsData.Data.PeakShotNumber));
+void StatFileWriter::updateWrittenState()
+{
+	_writtenSummaryState = getWrittenStatsState(_currentStats->AllShotStats);
+	_writtenShotStates.clear();
+	for (const auto& shotStats : _currentStats->PerShotStats)
+	{
+		_writtenShotStates.push_back(getWrittenStatsState(shotStats));
+	}
+	_writtenNumberOfImpactLocations = getImpactLocations().size();
+}
 
-	// v1.1 stats
-	writeLine(stream, StatFileDefs::AirDribbleTouches, std::to_string(statsData.Stats.MaxAirDribbleTouches));
-	writeLine(stream, StatFileDefs::AirDribbleTime, std::to_string(statsData.Stats.MaxAirDribbleTime));
-	writeLine(stream, StatFileDefs::GroundDribbleTime, std::to_string(statsData.Stats.MaxGroundDribbleTime));
-	writeLine(stream, StatFileDefs::DoubleTapGoals, std::to_string(statsData.Stats.DoubleTapGoals));
-	writeLine(stream, StatFileDefs::DoubleTapPercentage, std::to_string(statsData.Data.DoubleTapGoalPercentage));
-	writeLine(stream, StatFileDefs::MaxFlipResets, std::to_string(statsData.Stats.MaxFlipResets));
-	writeLine(stream, StatFileDefs::TotalFlipResets, std::to_string(statsData.Stats.TotalFlipResets));
-	writeLine(stream, StatFileDefs::FlipResetsPerAttempt, std::to_string(statsData.Data.AverageFlipResetsPerAttempt));
-	writeLine(stream, StatFileDefs::FlipResetPercentage, std::to_string(statsData.Data.FlipResetGoalPercentage));
-	writeLine(stream, StatFileDefs::CloseMisses, std::to_string(statsData.Stats.CloseMisses));
-	writeLine(stream, StatFileDefs::CloseMissPercentage, std::to_string(statsData.Data.CloseMissPercentage));
+SessionIndexEntry StatFileWriter::getSessionIndexEntry() const
+{
+	SessionIndexEntry entry;
+	entry.Attempts = _currentStats->AllShotStats.Stats.Attempts;
+	entry.Goals = _currentStats->AllShotStats.Stats.Goals;
+	entry.NumberOfShots = (int)_currentStats->PerShotStats.size();
+	entry.Version = StatFileDefs::CurrentVersionNumber;
+	return entry;
+}
 
-	// v1.2 stats - Shot locations are only available once for the session rather than for every shot. They are also not tracked for the all time peak stats.
-	auto shotLocations = isSummaryData && !skipUncomparableStats ? _shotDistributionTracker->getImpactLocations() : std::vector<Vector>();
-	writeLine(stream, StatFileDefs::ImpactLocations, shot_location_vector_to_string(shotLocations));
+void StatFileWriter::updateSessionIndex(const std::filesystem::path& sessionFilePath, const SessionIndexEntry& entry, bool persist)
+{
+	if (!_sessionIndex) { return; }
 
-	// v1.3 stats
-	writeLine(stream, StatFileDefs::GoalSpeedValues, float_vector_to_string(statsData.Stats.GoalSpeedStats()->getAllShotValues()));
+	_sessionIndex->updateEntry(sessionFilePath, entry.Attempts, entry.Goals, entry.NumberOfShots, entry.Version, persist);
 }
 
-void StatFileWriter::writeData()
+void StatFileWriter::executeWrite(const std::filesystem::path& filePath, bool replacesFile, std::function<void()> write)
 {
-	if (!_currentStats)
+	if (!_storageWorker)
 	{
-		return;
+		write();
+	}
+	else if (replacesFile)
+	{
+		_storageWorker->queueWrite(filePath.u8string(), std::move(write));
 	}
+	else
+	{
+		_storageWorker->queueAppend(filePath.u8string(), std::move(write));
+	}
+}
 
-	writeToFile(_outputFilePath, _currentStats.get(), false /* do not skip uncomparable stats. */);
+const std::vector<Vector>& StatFileWriter::getImpactLocations() const
+{
+	static const std::vector<Vector> NoImpactLocations;
+	return _shotDistributionTracker ? _shotDistributionTracker->getImpactLocations() : NoImpactLocations;
 }
 
-void StatFileWriter::writeToFile(const std::filesystem::path& filePath, const ShotStats* const stats, bool skipUncomparableStats)
+void StatFileWriter::invalidatePrefetchedSession()
 {
-	if (!stats) { return; }
+	if (!_prefetchCache) { return; }
+
+	// Any reload of the cache gets queued after the write, so it will read the new content
+	_prefetchCache->invalidateSession(_outputFilePath, _currentStats->AllShotStats.Stats.Attempts);
+}
 
+bool StatFileWriter::writeToFile(const std::filesystem::path& filePath, std::string_view fileContent, std::ios::openmode additionalOpenMode)
+{
 	// Open the file with write access and replace anything that might have been in it
 	std::ofstream outputFileStream;
-	outputFileStream.open(filePath, std::ios::out | std::ios::trunc);
+	outputFileStream.open(filePath, std::ios::out | std::ios::trunc | additionalOpenMode);
 	if (outputFileStream.fail())
 	{
-		_currentStats = nullptr;
-		return;
+		return false;
 	}
 
-	writeLine(outputFileStream, StatFileDefs::Version, StatFileDefs::CurrentVersionNumber);
-	writeLine(outputFileStream, StatFileDefs::NumberOfShots, std::to_string(stats->PerShotStats.size()));
-
-	writeStatsData(outputFileStream, stats->AllShotStats, true, skipUncomparableStats);
-
-	for (const auto& shotStats : stats->PerShotStats)
-	{
-		writeStatsData(outputFileStream, shotStats, false, skipUncomparableStats);
-	}
+	// The content was created in memory first so it can be written with a single call, rather than flushing the stream for every line
+	outputFileStream.write(fileContent.data(), fileContent.size());
+	return true;
 }
 
 void StatFileWriter::writeTrainingPackStatistics(const ShotStats& shotStats, const std::string& trainingPackCode)
 {
-	auto filePath = fmt::format("{}\\{}.txt", StatFileDefs::getTrainingFolder(_gameWrapper, trainingPackCode), trainingPackCode);
-	writeToFile(filePath, &shotStats, true /* skip uncomparable stats. */);
+	// All time peak stats are still stored as text. Shot locations are not tracked for them
+	auto filePath = std::filesystem::u8path(fmt::format("{}\\{}{}", StatFileDefs::getTrainingFolder(_gameWrapper, trainingPackCode), trainingPackCode, StatFileDefs::TextFileExtension));
+	// A failure only affects this write. The next improvement of a peak writes the file again, and sessions are not affected at all
+	executeWrite(filePath, true, [filePath, fileContent = std::string(_textSerializer.serialize(shotStats, nullptr))]() {
+		writeToFile(filePath, fileContent, {});
+	});
+
+	if (_prefetchCache)
+	{
+		_prefetchCache->invalidatePeakStats(trainingPackCode);
+	}
 }
@@ -1,30 +1,104 @@
 #pragma once
 
+#include <atomic>
+#include <ios>
+#include <string_view>
+
 #include <bakkesmod/wrappers/GameWrapper.h>
 
 #include "../Core/IStatWriter.h"
 #include "../Data/ShotStats.h"
 #include "../Calculation/ShotDistributionTracker.h"
+#include "StatFileSerializer.h"
+#include "BinaryStatFileSerializer.h"
+#include "SessionIndex.h"
+#include "StorageWorker.h"
+#include "SessionPrefetchCache.h"
 
 /** Writes StatsData objects to the file system .*/
 class GOALPERCENTAGECOUNTER_IMPORT_EXPORT StatFileWriter : public IStatWriter
 {
 public:
-	StatFileWriter(std::shared_ptr<GameWrapper> gameWrapper, std::shared_ptr<ShotStats> shotStats, std::shared_ptr<ShotDistributionTracker> tracker);
+	/** Creates a writer for the given stats. If a storage worker is provided, files get written in the background.
+	 * If a prefetch cache is provided, it gets notified about any write which might change the stats it holds.
+	 * If no shot distribution tracker is provided, no impact locations are stored.
+	 */
+	StatFileWriter(
+		std::shared_ptr<GameWrapper> gameWrapper,
+		std::shared_ptr<ShotStats> shotStats,
+		std::shared_ptr<ShotDistributionTracker> tracker,
+		std::shared_ptr<SessionIndex> sessionIndex,
+		std::shared_ptr<StorageWorker> storageWorker,
+		std::shared_ptr<SessionPrefetchCache> prefetchCache);
 
 	// Inherited via IStatWriter
 	void initializeStorage(const std::string& trainingPackCode) override;
+	/** Like initializeStorage(), but creates the session file in the given folder rather than the folder of a training pack. */
+	void initializeStorageInFolder(const std::filesystem::path& folderPath);
 	void writeData() override; 
+	void compactStorage() override;
 
 	void writeTrainingPackStatistics(const ShotStats& shotStats, const std::string& trainingPackCode) override;
 	
 private:
-	void writeToFile(const std::filesystem::path& filePath, const ShotStats* const stats, bool skipUncomparableStats);
-	void writeStatsData(std::ofstream& stream, const StatsData& statsData, bool isSummaryData, bool skipUncomparableStats);
+	/** Stores the parts of a StatsData object which allow detecting which shot an attempt was made on. */
+	struct WrittenStatsState
+	{
+		int Attempts = 0;
+		int Goals = 0;
+		int InitialHits = 0;
+		size_t NumberOfGoalSpeedValues = 0;
+
+		inline bool operator==(const WrittenStatsState& other) const
+		{
+			return Attempts == other.Attempts && Goals == other.Goals && InitialHits == other.InitialHits && NumberOfGoalSpeedValues == other.NumberOfGoalSpeedValues;
+		}
+		inline bool operator!=(const WrittenStatsState& other) const { return !(*this == other); }
+	};
+	static WrittenStatsState getWrittenStatsState(const StatsData& statsData);
+
+	/** Returns true if the current stats still equal the ones which were stored last. */
+	bool statsAreUnchanged() const;
+	/** Appends a journal record if the stats changed by exactly one attempt since they were stored last. Returns false if a snapshot is required instead. */
+	bool tryAppendJournalRecord();
+	/** Writes the complete current stats to the session file and discards the journal. */
+	void writeSnapshot();
+	/** Remembers the current stats as the ones which were stored last. */
+	void updateWrittenState();
+	/** Retrieves the values of the current stats which are stored in the session index. */
+	SessionIndexEntry getSessionIndexEntry() const;
+	/** Updates the entry of the given session in the session index, and optionally writes the index. */
+	void updateSessionIndex(const std::filesystem::path& sessionFilePath, const SessionIndexEntry& entry, bool persist);
+
+	/** Executes the given file access on the storage worker, or right away if there is none.
+	 *
+	 * \param	filePath		The file which gets written. Pending writes of the same file get dropped if replacesFile is true.
+	 * \param	replacesFile	False if the file only gets appended to.
+	 */
+	void executeWrite(const std::filesystem::path& filePath, bool replacesFile, std::function<void()> write);
+	/** Retrieves the impact locations of the tracker, or an empty list if there is no tracker. */
+	const std::vector<Vector>& getImpactLocations() const;
+	/** Notifies the prefetch cache that the current session file is about to change. */
+	void invalidatePrefetchedSession();
+	/** Replaces the content of the given file. Returns false if the file could not be written. */
+	static bool writeToFile(const std::filesystem::path& filePath, std::string_view fileContent, std::ios::openmode additionalOpenMode);
 
 	std::shared_ptr<GameWrapper> _gameWrapper;
 	std::shared_ptr<ShotStats> _currentStats;
 	std::filesystem::path _outputFilePath; 
 	
 	std::shared_ptr<ShotDistributionTracker> _shotDistributionTracker; ///< This is used for writing shot locations and heat map data to the file
+	StatFileSerializer _textSerializer; ///< Formats the all time peak stats into a buffer which gets written to the file at once
+	BinaryStatFileSerializer _binarySerializer; ///< Converts the session stats into a buffer which gets written to the file at once
+
+	std::filesystem::path _journalFilePath; ///< The attempt journal of the current session. Finished attempts get appended here rather than rewriting the session file.
+	bool _snapshotIsValid = false; ///< True as soon as the session file contains a snapshot the journal can build upon.
+	int _numberOfJournalRecords = 0; ///< The number of attempts which were appended to the journal since the last snapshot.
+	WrittenStatsState _writtenSummaryState; ///< The state of the summary at the time the stats were stored last.
+	std::vector<WrittenStatsState> _writtenShotStates; ///< The state of each shot at the time the stats were stored last.
+	size_t _writtenNumberOfImpactLocations = 0; ///< The number of impact locations at the time the stats were stored last.
+	std::shared_ptr<SessionIndex> _sessionIndex; ///< Keeps track of the attempts and goals of each session so previous sessions can be found without reading them. May be nullptr. Only accessed by file access tasks.
+	std::shared_ptr<StorageWorker> _storageWorker; ///< Writes the files in the background. May be nullptr, in which case files get written right away.
+	std::shared_ptr<SessionPrefetchCache> _prefetchCache; ///< Holds stats which were read in advance and might be outdated after writing. May be nullptr.
+	std::atomic<bool> _sessionWriteFailed = false; ///< Set if the snapshot or a journal record could not be written. The next write will be a snapshot then, which replaces both.
 };
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include <pch.h>
+#include "StorageWorker.h"
+
+#include <algorithm>
+
+StorageWorker::StorageWorker(GameThreadExecutor executeOnGameThread)
+	: _executeOnGameThread(std::move(executeOnGameThread))
+	, _thread([this]() { processTasks(); })
+{
+}
+
+StorageWorker::~StorageWorker()
+{
+	shutdown();
+}
+
+void StorageWorker::queueWrite(const std::string& coalescingKey, std::function<void()> write)
+{
+	queueTask({ coalescingKey, std::move(write) }, true);
+}
+
+void StorageWorker::queueAppend(const std::string& coalescingKey, std::function<void()> append)
+{
+	queueTask({ coalescingKey, std::move(append) }, false);
+}
+
+void StorageWorker::queueTask(Task task, bool replacesFile)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (!_isShutDown)
+		{
+			if (replacesFile && !task.CoalescingKey.empty())
+			{
+				// The new content replaces the file anyway, so there is no point in writing the older one first
+				_pendingTasks.erase(std::remove_if(_pendingTasks.begin(), _pendingTasks.end(), [&task](const Task& pendingTask) {
+					return pendingTask.CoalescingKey == task.CoalescingKey;
+				}), _pendingTasks.end());
+			}
+			_pendingTasks.push_back(std::move(task));
+			_taskAvailable.notify_one();
+			return;
+		}
+	}
+
+	// There is no background thread anymore, but the task must not get lost (e.g. the final write of a session)
+	task.Execute();
+}
+
+void StorageWorker::drain()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_tasksFinished.wait(lock, [this]() { return _pendingTasks.empty() && !_taskIsRunning; });
+}
+
+void StorageWorker::shutdown()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_isShutDown) { return; }
+		_isShutDown = true;
+		_taskAvailable.notify_one();
+	}
+
+	// The background thread finishes all pending tasks before it stops
+	if (_thread.joinable())
+	{
+		_thread.join();
+	}
+	_callbackGuard.reset();
+}
+
+void StorageWorker::processTasks()
+{
+	while (true)
+	{
+		Task task;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_taskAvailable.wait(lock, [this]() { return !_pendingTasks.empty() || _isShutDown; });
+			if (_pendingTasks.empty())
+			{
+				return; // Shut down, and nothing left to do
+			}
+			task = std::move(_pendingTasks.front());
+			_pendingTasks.pop_front();
+			_taskIsRunning = true;
+		}
+
+		try
+		{
+			task.Execute();
+		}
+		catch (const std::exception&)
+		{
+			// The task failed to access the file system. Other tasks might still succeed, so keep going
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_taskIsRunning = false;
+			if (_pendingTasks.empty())
+			{
+				_tasksFinished.notify_all();
+			}
+		}
+	}
+}
+
+void StorageWorker::executeOnGameThread(std::function<void()> callback)
+{
+	if (!_executeOnGameThread) { return; }
+
+	// The callback might only get executed after the plugin was unloaded, so it must not run anymore after shutdown() has been called
+	std::weak_ptr<bool> callbackGuard = _callbackGuard;
+	_executeOnGameThread([callbackGuard, callback = std::move(callback)]() {
+		if (!callbackGuard.expired())
+		{
+			callback();
+		}
+	});
+}
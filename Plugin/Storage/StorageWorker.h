@@ -0,0 +1,105 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "../DLLImportExport.h"
+
+/** Executes file system operations on a background thread, so reading and writing stats does not stall the game.
+ *
+ * Tasks are executed one after another, in the order they were queued, so a task always sees the results of the tasks queued before it.
+ * Writes which replace the whole content of a file drop any pending write or append to the same file, since only the newest content of the
+ * file matters. Reads hand their result to a callback which gets executed on the game thread.
+ *
+ * Everything except the tasks themselves must be called from the game thread.
+ */
+class GOALPERCENTAGECOUNTER_IMPORT_EXPORT StorageWorker
+{
+public:
+	/** Executes the given function on the game thread at some point. Must be callable from any thread. */
+	using GameThreadExecutor = std::function<void(std::function<void()>)>;
+
+	/** Starts the background thread. */
+	explicit StorageWorker(GameThreadExecutor executeOnGameThread);
+	/** Executes any pending task and stops the background thread. */
+	~StorageWorker();
+
+	StorageWorker(const StorageWorker&) = delete;
+	StorageWorker& operator=(const StorageWorker&) = delete;
+
+	/** Queues a task which replaces the whole content of a file. Any pending task with the same coalescing key gets dropped.
+	 *
+	 * \param	coalescingKey	Identifies the file, e.g. by its path. An empty key never coalesces.
+	 */
+	void queueWrite(const std::string& coalescingKey, std::function<void()> write);
+
+	/** Queues a task which adds to a file. It never drops other tasks, but gets dropped by a later write with the same coalescing key,
+	 * since the new content of the file is expected to include anything which was appended before.
+	 */
+	void queueAppend(const std::string& coalescingKey, std::function<void()> append);
+
+	/** Executes the given read in the background and passes its result to onFinished on the game thread.
+	 * The callback does not get executed anymore if the worker was shut down by then.
+	 */
+	template<typename ResultType>
+	void queueRead(std::function<ResultType()> read, std::function<void(ResultType&)> onFinished)
+	{
+		queueTask({ {}, [this, read = std::move(read), onFinished = std::move(onFinished)]() {
+			auto result = std::make_shared<ResultType>(read());
+			executeOnGameThread([onFinished, result]() { onFinished(*result); });
+		} }, false);
+	}
+
+	/** Executes the given read after all pending tasks and blocks until it has finished. This is meant for the rare cases where the game
+	 * thread can't continue without the result, and it makes sure the read sees everything which was written before.
+	 */
+	template<typename ResultType>
+	ResultType readNow(std::function<ResultType()> read)
+	{
+		std::packaged_task<ResultType()> task(std::move(read));
+		auto result = task.get_future();
+		queueTask({ {}, [&task]() { task(); } }, false);
+		return result.get();
+	}
+
+	/** Blocks until every pending task has been executed. */
+	void drain();
+
+	/** Executes any pending task and stops the background thread. Callbacks of reads which have not been executed yet get discarded, and any
+	 * task which gets queued afterwards is executed right away on the calling thread. This must be called before anything the tasks or
+	 * callbacks refer to gets destroyed, e.g. when the plugin gets unloaded.
+	 */
+	void shutdown();
+
+private:
+	/** A task and the key it may be coalesced by. */
+	struct Task
+	{
+		std::string CoalescingKey;
+		std::function<void()> Execute;
+	};
+
+	/** Adds the given task to the queue, or executes it right away if the worker was shut down already. */
+	void queueTask(Task task, bool replacesFile);
+	/** Executes tasks until the worker gets shut down. Runs on the background thread. */
+	void processTasks();
+	/** Passes the given callback to the game thread, unless the worker gets shut down before it gets executed. */
+	void executeOnGameThread(std::function<void()> callback);
+
+	GameThreadExecutor _executeOnGameThread;
+	std::shared_ptr<bool> _callbackGuard = std::make_shared<bool>(true); ///< Callbacks only get executed while this is alive. Reset on shutdown.
+
+	std::mutex _mutex;								///< Protects the members below.
+	std::condition_variable _taskAvailable;			///< Wakes up the background thread.
+	std::condition_variable _tasksFinished;			///< Wakes up anyone waiting in drain().
+	std::deque<Task> _pendingTasks;					///< The tasks which have not been started yet, in the order they were queued.
+	bool _taskIsRunning = false;					///< True while the background thread is executing a task.
+	bool _isShutDown = false;						///< True as soon as shutdown() has been called.
+	std::thread _thread;							///< The background thread. Started last, since it uses the members above.
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <charconv>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+/** Reads the lines of a text stat file (version 1.0 to 1.3) from a block of memory, e.g. a memory mapped file, without copying them.
+ *
+ * Lines and values are returned as views into the block, and numbers are parsed with std::from_chars, so reading a whole file does not
+ * allocate anything. Any line which is missing or can't be parsed makes the read fail and return false.
+ */
+class TextCursor
+{
+public:
+	TextCursor(const char* data, size_t size)
+		: _data(data)
+		, _size(size)
+	{
+	}
+
+	/** Reads the next line, without its line ending. */
+	inline bool readLine(std::string_view& line)
+	{
+		if (_offset >= _size) { return false; }
+
+		auto remainingText = std::string_view(_data + _offset, _size - _offset);
+		auto lineEnd = remainingText.find('\n');
+		if (lineEnd == std::string_view::npos)
+		{
+			lineEnd = remainingText.size(); // The last line does not need to be terminated
+			_offset = _size;
+		}
+		else
+		{
+			_offset += lineEnd + 1;
+		}
+
+		line = remainingText.substr(0, lineEnd);
+		if (!line.empty() && line.back() == '\r')
+		{
+			line.remove_suffix(1); // The file was written in text mode on Windows
+		}
+		return true;
+	}
+
+	/** Reads the next line and splits it into the label and the value, which are separated by a tab. */
+	inline bool readKeyValue(std::string_view& key, std::string_view& value)
+	{
+		std::string_view line;
+		if (!readLine(line)) { return false; }
+
+		auto separatorPos = line.find('\t');
+		if (separatorPos == std::string_view::npos) { return false; }
+
+		key = line.substr(0, separatorPos);
+		value = line.substr(separatorPos + 1);
+		return true;
+	}
+
+	/** Reads the next line and parses its value. Lines without a label or a value, and negative values, are rejected. */
+	template<typename T>
+	bool readValue(T& value)
+	{
+		std::string_view key, valueText;
+		T parsedValue;
+		if (!readKeyValue(key, valueText) || key.empty() || !parse(valueText, parsedValue) || parsedValue < 0)
+		{
+			return false;
+		}
+		value = parsedValue;
+		return true;
+	}
+
+	/** Removes everything up to and including the next separator from the given text. The part before the separator is returned as the token. */
+	static inline bool nextToken(std::string_view& text, char separator, std::string_view& token)
+	{
+		auto separatorPos = text.find(separator);
+		if (separatorPos == std::string_view::npos) { return false; }
+
+		token = text.substr(0, separatorPos);
+		text.remove_prefix(separatorPos + 1);
+		return true;
+	}
+
+	/** Parses the whole text as an integer. */
+	static inline bool parse(std::string_view text, int& value)
+	{
+		auto [end, errorCode] = std::from_chars(text.data(), text.data() + text.size(), value);
+		return errorCode == std::errc() && end == text.data() + text.size();
+	}
+
+	/** Parses the whole text as a decimal number. Both '.' and ',' are accepted as decimal separator. */
+	template<typename T>
+	static bool parse(std::string_view text, T& value)
+	{
+		static_assert(std::is_floating_point_v<T>, "Only integers and floating point values can be parsed");
+
+		// Decimal values used to be formatted with the C locale, so files which were written while e.g. a German locale was active contain "12,5"
+		char buffer[384]; // Large enough for any double value formatted through %f
+		auto commaPos = text.find(',');
+		if (commaPos != std::string_view::npos && text.size() <= sizeof(buffer))
+		{
+			std::memcpy(buffer, text.data(), text.size());
+			buffer[commaPos] = '.';
+			text = std::string_view(buffer, text.size());
+		}
+
+		auto [end, errorCode] = std::from_chars(text.data(), text.data() + text.size(), value);
+		return errorCode == std::errc() && end == text.data() + text.size();
+	}
+
+private:
+	const char* _data;		///< The start of the memory block.
+	size_t _size;			///< The size of the memory block.
+	size_t _offset = 0;		///< The start of the next line, relative to _data.
+};
@@ -0,0 +1,60 @@
+#include <pch.h>
+#include "SummaryRowCache.h"
+
+void SummaryRowCache::update(const StatRowPlan& plan, const StatsSnapshot& snapshot, bool diffShallBeDisplayed)
+{
+	if (_planVersion != plan.getVersion() || _diffShallBeDisplayed != diffShallBeDisplayed)
+	{
+		// Every cell might look different now
+		_planVersion = plan.getVersion();
+		_diffShallBeDisplayed = diffShallBeDisplayed;
+		for (auto& row : _rows)
+		{
+			row.Version = 0;
+		}
+	}
+
+	// Rows of shots which did not exist before have a version of zero, so they get formatted on first access
+	auto numberOfRows = snapshot.Stats.PerShotStats.size() + 1;
+	if (_rows.size() != numberOfRows)
+	{
+		_rows.back().Version = 0;
+		_rows.resize(numberOfRows);
+		_rows.back().Version = 0;
+	}
+}
+
+const std::vector<SingleStatStrings>& SummaryRowCache::getRow(const StatRowPlan& plan, const StatsSnapshot& snapshot, size_t rowIndex)
+{
+	const auto& shotStats = snapshot.Stats;
+	const auto& diffData = snapshot.Differences;
+	auto& row = _rows.at(rowIndex);
+
+	// The row of all shots changes with nearly every snapshot, while the row of a shot only changes when the shot gets played
+	auto isAllShotsRow = rowIndex == getAllShotsRowIndex();
+	auto statsVersion = isAllShotsRow ? snapshot.Version : snapshot.ShotVersions.at(rowIndex);
+	if (row.Version != 0 && row.Version == statsVersion)
+	{
+		return row.Cells;
+	}
+
+	const StatsData* statsDataDiff = nullptr;
+	if (isAllShotsRow)
+	{
+		if (_diffShallBeDisplayed)
+		{
+			statsDataDiff = &diffData.AllShotStats;
+		}
+		row.Cells = plan.formatRows(shotStats.AllShotStats, statsDataDiff);
+	}
+	else
+	{
+		if (_diffShallBeDisplayed)
+		{
+			statsDataDiff = &diffData.PerShotStats.at(rowIndex);
+		}
+		row.Cells = plan.formatRows(shotStats.PerShotStats.at(rowIndex), statsDataDiff);
+	}
+	row.Version = statsVersion;
+	return row.Cells;
+}
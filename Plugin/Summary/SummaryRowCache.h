@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../DLLImportExport.h"
+#include "../Data/StatsSnapshot.h"
+#include "../Display/StatRowPlan.h"
+
+/** Stores the formatted cells of every row of the summary window, so a row only gets formatted again after the stats of its shot have changed.
+ *
+ * There is one row per shot, followed by a row for the stats of all shots.
+ */
+class GOALPERCENTAGECOUNTER_IMPORT_EXPORT SummaryRowCache
+{
+public:
+	/** Prepares the cache for the given snapshot. Drops every row if the plan or the visibility of the differences have changed since the previous call. */
+	void update(const StatRowPlan& plan, const StatsSnapshot& snapshot, bool diffShallBeDisplayed);
+
+	/** Retrieves the cells of the given row, and formats them first if the stats of the row have changed. update() must have been called for the same snapshot. */
+	const std::vector<SingleStatStrings>& getRow(const StatRowPlan& plan, const StatsSnapshot& snapshot, size_t rowIndex);
+
+	/** Retrieves the number of rows, including the row of all shots. */
+	inline size_t getNumberOfRows() const { return _rows.size(); }
+	/** Retrieves the index of the row which contains the stats of all shots. */
+	inline size_t getAllShotsRowIndex() const { return _rows.size() - 1; }
+
+private:
+	/** The formatted cells of a single row. */
+	struct Row
+	{
+		uint64_t Version = 0;					///< The version of the stats the cells have been formatted for. Zero if they have not been formatted yet.
+		std::vector<SingleStatStrings> Cells;	///< One cell per stat.
+	};
+
+	uint64_t _planVersion = 0;				///< The version of the plan the rows have been formatted with.
+	bool _diffShallBeDisplayed = false;		///< True if the rows have been formatted with differences.
+	std::vector<Row> _rows{ 1 };			///< The rows of every shot, followed by the row of all shots.
+};
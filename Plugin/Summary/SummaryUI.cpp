@@ -1,7 +1,6 @@
 #include "pch.h"
 #include "SummaryUI.h"
 #include "IMGUI/imgui.h"
-#include "Display/StatDisplay.h"
 
 #include <string>
 #include <sstream>
@@ -12,18 +11,24 @@ const std::string SummaryUI::MenuName = "custom_training_statistics_summary";
 
 void SummaryUI::initSummaryUi(
 	const std::shared_ptr<CVarManagerWrapper> cvarManager,
-	const std::shared_ptr<const ShotStats> shotStats,
-	const std::shared_ptr<const ShotStats> diffData,
+	const std::shared_ptr<TripleBuffer<StatsSnapshot>> snapshots,
 	const std::shared_ptr<const PluginState> pluginState)
 {
 	_cvarManager = cvarManager;
-	_shotStats = shotStats;
-	_diffData = diffData;
+	_snapshots = snapshots;
 	_pluginState = pluginState;
 }
 
 void SummaryUI::renderSummary()
 {
+	// This runs on the render thread, so the stats must only be accessed through the snapshot
+	const auto& snapshot = _snapshots->readLatest();
+	const auto& shotStats = snapshot.Stats;
+	const auto& diffData = snapshot.Differences;
+	_rowPlan.update(*_pluginState);
+	auto diffShallBeDisplayed = _pluginState->PreviousSessionDiffShallBeDisplayed && diffData.hasAttempts() && diffData.PerShotStats.size() == shotStats.PerShotStats.size();
+	_rowCache.update(_rowPlan, snapshot, diffShallBeDisplayed);
+
 	ImGui::Text(fmt::format("Statistics Summary for '{}' by {} (Code: {})", _pluginState->TrainingPackName, _pluginState->TrainingPackCreator, _pluginState->TrainingPackCode).c_str());
 	if (ImGui::Button("Copy Training Pack Info To Clipboard"))
 	{
@@ -32,7 +37,7 @@ void SummaryUI::renderSummary()
 	ImGui::SameLine();
 	if (ImGui::Button("Copy Visible Stats To Clipboard"))
 	{
-		copyStatisticsSummary();
+		copyStatisticsSummary(snapshot);
 	}
 	ImGui::BeginChild(
 		"#CustomTrainingStatisticsSummaryStats",
@@ -41,69 +46,49 @@ void SummaryUI::renderSummary()
 		false,
 		ImGuiWindowFlags_AlwaysVerticalScrollbar | ImGuiWindowFlags_AlwaysUseWindowPadding);
 
-	auto statsToBeRendered = StatDisplay::GetStatsToBeRendered(_shotStats->AllShotStats, _pluginState);
-	int numColumns = (int)statsToBeRendered.size() + 1; // +1 for shot number
+	// The header uses the labels of the row of all shots, since the shots have the same stats
+	const auto& headerCells = _rowCache.getRow(_rowPlan, snapshot, _rowCache.getAllShotsRowIndex());
+	int numColumns = (int)headerCells.size() + 1; // +1 for shot number
 	ImGui::Columns(numColumns, "custom_training_statistics_summary_stats_header");
 	ImGui::Separator();
 
 	ImGui::Text("Shot Number:");
 	ImGui::NextColumn();
-	for (const auto& statStrings : statsToBeRendered)
+	for (const auto& statStrings : headerCells)
 	{
-		ImGui::Text(statStrings.Label.c_str());
+		ImGui::TextUnformatted(statStrings.Label.c_str());
 		ImGui::NextColumn();
 	}
 
 	ImGui::Separator();
 	ImGui::Separator();
 
-	ImGuiListClipper clipper((int)_shotStats->PerShotStats.size() + 1); // +1 for AllShotStats
+	// Only visible rows get accessed, and they only get formatted again after their shot has changed
+	ImGuiListClipper clipper((int)_rowCache.getNumberOfRows());
 	while (clipper.Step())
 	{
 		for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
 		{
-			StatsData statsData;
-			const StatsData* statsDataDiff = nullptr;
-			// Get row data
-			if (i < _shotStats->PerShotStats.size())
+			if (i < (int)_rowCache.getAllShotsRowIndex())
 			{
-				ImGui::Text(std::to_string(i + 1).c_str()); // Shot number
-				ImGui::NextColumn();
-
-				statsData = _shotStats->PerShotStats.at(i);
-				if (_diffData && _pluginState->PreviousSessionDiffShallBeDisplayed && _diffData->hasAttempts())
-				{
-					statsDataDiff = &_diffData->PerShotStats.at(i);
-				}
+				ImGui::Text("%d", i + 1); // Shot number
 			}
 			else
 			{
 				ImGui::Text("All Shots");
-				ImGui::NextColumn();
-				statsData = _shotStats->AllShotStats;
-				if (_diffData && _pluginState->PreviousSessionDiffShallBeDisplayed && _diffData->hasAttempts())
-				{
-					statsDataDiff = &_diffData->AllShotStats;
-				}
 			}
+			ImGui::NextColumn();
 
-			auto statsToBeRendered = StatDisplay::GetStatsToBeRendered(statsData, _pluginState, statsDataDiff);
-			for (auto&& statStrings : statsToBeRendered)
+			for (const auto& statStrings : _rowCache.getRow(_rowPlan, snapshot, (size_t)i))
 			{
-				// ImGui displays text as a c string so percent signs are escaped
-				// Need to add an extra percent sign so it will display
-				if (statStrings.Unit.back() == '%')
-				{
-					statStrings.Unit.push_back('%');
-				}
-
-				ImGui::Text((statStrings.Value + " " + statStrings.Unit).c_str());
+				// Passing the strings as arguments means percent signs in the unit do not need to be escaped
+				ImGui::Text("%s %s", statStrings.Value.c_str(), statStrings.Unit.c_str());
 
 				if (statStrings.DiffValue.has_value())
 				{
-					auto textColor = (std::stod(statStrings.DiffValue.value()) >= .0 ? ImVec4{ 0.0f, 1.0f, 0.0f, 1.0f } : ImVec4{ 1.0f, 0.0f, 0.0f, 1.0f });
+					auto textColor = (!statStrings.DiffIsNegative ? ImVec4{ 0.0f, 1.0f, 0.0f, 1.0f } : ImVec4{ 1.0f, 0.0f, 0.0f, 1.0f });
 					ImGui::SameLine();
-					ImGui::TextColored(textColor, statStrings.DiffValue.value().c_str());
+					ImGui::TextColored(textColor, "%s", statStrings.DiffValue.value().c_str());
 				}
 				ImGui::NextColumn();
 			}
@@ -236,12 +221,12 @@ void SummaryUI::copyTrainingPackCode() const
 }
 
 template<typename T>
-std::string toTsvString(const std::list<T>& list, std::function<std::string(const T&)> converter)
+std::string toTsvString(const std::vector<T>& list, std::function<std::string(const T&)> converter)
 {
 	auto count = list.size();
 	auto index = 0;
 	std::ostringstream stream;
-	for (auto elem : list)
+	for (const auto& elem : list)
 	{
 		stream << converter(elem);
 		if (index < count - 1)
@@ -262,17 +247,18 @@ std::string getValueString(const SingleStatStrings& data)
 	//}
 	return result;
 }
-void SummaryUI::copyStatisticsSummary() const
+void SummaryUI::copyStatisticsSummary(const StatsSnapshot& snapshot)
 {
+	// The cells are the same as the ones in the window, so rows which have been displayed already do not need to be formatted again
 	std::ostringstream stream;
-	auto globalStats = StatDisplay::GetStatsToBeRendered(_shotStats->AllShotStats, _pluginState);
+	const auto& globalStats = _rowCache.getRow(_rowPlan, snapshot, _rowCache.getAllShotsRowIndex());
 
 	// Store headers
 	stream << "Shot Number\t" << toTsvString<SingleStatStrings>(globalStats, [](const SingleStatStrings& elem) { return elem.Label; }) << std::endl;
 	// Store single shot values
-	for (auto shotNumber = 0; shotNumber < _shotStats->PerShotStats.size(); shotNumber++)
+	for (size_t shotNumber = 0; shotNumber < _rowCache.getAllShotsRowIndex(); shotNumber++)
 	{
-		auto shotStats = StatDisplay::GetStatsToBeRendered(_shotStats->PerShotStats[shotNumber], _pluginState);
+		const auto& shotStats = _rowCache.getRow(_rowPlan, snapshot, shotNumber);
 		stream << std::to_string(shotNumber) << '\t' << toTsvString<SingleStatStrings>(shotStats, getValueString) << std::endl;
 	}
 	// Store global values
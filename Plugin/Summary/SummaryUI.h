@@ -5,8 +5,10 @@
 #include "bakkesmod/plugin/pluginwindow.h"
 #include "bakkesmod/wrappers/cvarmanagerwrapper.h"
 
-#include "Data/ShotStats.h"
+#include "Data/StatsSnapshot.h"
 #include "Data/PluginState.h"
+#include "Display/StatRowPlan.h"
+#include "Summary/SummaryRowCache.h"
 
 class SummaryUI : public BakkesMod::Plugin::PluginWindow
 {
@@ -14,8 +16,7 @@ public:
 	/** Initializes the stats summary UI. */
 	void initSummaryUi(
 		const std::shared_ptr<CVarManagerWrapper> cvarManager,
-		const std::shared_ptr<const ShotStats> shotStats,
-		const std::shared_ptr<const ShotStats> diffData,
+		const std::shared_ptr<TripleBuffer<StatsSnapshot>> snapshots,
 		const std::shared_ptr<const PluginState> pluginState);
 
 	/** Do ImGui rendering here */
@@ -54,12 +55,13 @@ public:
 private:
 	void renderSummary();
 	void copyTrainingPackCode() const;
-	void copyStatisticsSummary() const;
+	void copyStatisticsSummary(const StatsSnapshot& snapshot);
 
 	std::shared_ptr<CVarManagerWrapper> _cvarManager; ///< Allows registering and retrieving custom variables.
-	std::shared_ptr<const ShotStats> _shotStats;
-	std::shared_ptr<const ShotStats> _diffData;
+	std::shared_ptr<TripleBuffer<StatsSnapshot>> _snapshots; ///< Provides the stats and the differences with the previous session without waiting for the game thread.
 	std::shared_ptr<const PluginState> _pluginState;
+	StatRowPlan _rowPlan; ///< The stats to be displayed as columns, in display order.
+	SummaryRowCache _rowCache; ///< The formatted cells of every shot, which are shared by the window and the clipboard.
 	bool _shouldBlockInput = false;
 	bool _isWindowOpen = false;
 };
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "Fixtures/AllTimePeakHandlerTestFixture.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+TEST_F(AllTimePeakHandlerTestFixture, peak_file_is_not_written_when_nothing_improved)
+{
+	// Arrange
+	EXPECT_CALL(*_statReader, readTrainingPackStatistics(FakeTrainingPackCode)).WillOnce(Return(createPeakFile(5)));
+	EXPECT_CALL(*_statWriter, writeTrainingPackStatistics(_, _)).Times(0);
+	_shotStats->AllShotStats.Stats.LongestGoalStreak = 3;
+
+	// Act
+	peakHandler->updateMaximumStats(); // Loads the peak file
+	peakHandler->updateMaximumStats();
+	peakHandler->updateMaximumStats();
+
+	// Assert
+	// The mocks verify that the peak file was not written
+}
+
+TEST_F(AllTimePeakHandlerTestFixture, peak_file_is_written_once_per_improvement)
+{
+	// Arrange
+	EXPECT_CALL(*_statReader, readTrainingPackStatistics(FakeTrainingPackCode)).WillOnce(Return(createPeakFile(5)));
+	EXPECT_CALL(*_statWriter, writeTrainingPackStatistics(_, FakeTrainingPackCode)).Times(1);
+	peakHandler->updateMaximumStats(); // Loads the peak file
+
+	// Act
+	_shotStats->PerShotStats[1].Stats.LongestGoalStreak = 6;
+	peakHandler->updateMaximumStats();
+	peakHandler->updateMaximumStats(); // The peak was written already
+
+	// Assert
+	EXPECT_EQ(peakHandler->getPeakStats().PerShotStats[1].Stats.LongestGoalStreak, 6);
+	EXPECT_EQ(peakHandler->getPeakStats().PerShotStats[0].Stats.LongestGoalStreak, 5);
+}
+
+TEST_F(AllTimePeakHandlerTestFixture, missing_peak_file_gets_created)
+{
+	// Arrange
+	EXPECT_CALL(*_statReader, readTrainingPackStatistics(FakeTrainingPackCode)).WillOnce(Return(ShotStats()));
+	EXPECT_CALL(*_statWriter, writeTrainingPackStatistics(_, FakeTrainingPackCode)).Times(1);
+
+	// Act
+	peakHandler->updateMaximumStats();
+	peakHandler->updateMaximumStats();
+
+	// Assert
+	// The mocks verify that the peak file was written exactly once
+}
+
+TEST_F(AllTimePeakHandlerTestFixture, peaks_are_not_stored_before_twenty_attempts)
+{
+	// Arrange
+	EXPECT_CALL(*_statReader, readTrainingPackStatistics(FakeTrainingPackCode)).WillOnce(Return(createPeakFile(1)));
+	EXPECT_CALL(*_statWriter, writeTrainingPackStatistics(_, _)).Times(0);
+	peakHandler->updateMaximumStats(); // Loads the peak file
+
+	// Act
+	_shotStats->AllShotStats.Stats.Attempts = 19;
+	_shotStats->AllShotStats.Stats.LongestGoalStreak = 19;
+	peakHandler->updateMaximumStats();
+
+	// Assert
+	// The mocks verify that the peak file was not written
+}
@@ -0,0 +1,66 @@
+#include "Fixtures/AttemptJournalTestFixture.h"
+
+#include <fstream>
+
+TEST_F(AttemptJournalTestFixture, record_continues_stats)
+{
+	// Arrange
+	auto snapshot = createStats(1, 100.0f);
+	auto expectedStats = createStats(2, 100.0f);
+	auto record = AttemptJournal::createRecord(expectedStats, 0, true, { Vector(1.0f, 2.0f, 3.0f) });
+	std::vector<Vector> impactLocations;
+
+	// Act
+	auto recordWasApplied = AttemptJournal::applyRecord(record, snapshot, &impactLocations);
+
+	// Assert
+	EXPECT_TRUE(recordWasApplied);
+	EXPECT_EQ(snapshot.AllShotStats.Stats.Attempts, 2);
+	EXPECT_EQ(snapshot.AllShotStats.Stats.Goals, 2);
+	EXPECT_EQ(snapshot.AllShotStats.Stats.LongestGoalStreak, 2);
+	EXPECT_EQ(snapshot.AllShotStats.Stats.RecentShots, expectedStats.AllShotStats.Stats.RecentShots);
+	EXPECT_EQ(snapshot.AllShotStats.Stats.GoalSpeed.Count, 2);
+	EXPECT_EQ(snapshot.PerShotStats[0].Stats.Attempts, 2);
+	EXPECT_EQ(snapshot.PerShotStats[0].Stats.GoalSpeed.Count, 2);
+	EXPECT_EQ(snapshot.PerShotStats[1].Stats.Attempts, 0);
+	EXPECT_DOUBLE_EQ(snapshot.AllShotStats.Data.SuccessPercentage, 100.0);
+	ASSERT_EQ(impactLocations.size(), 1);
+	EXPECT_EQ(impactLocations[0].Z, 3.0f);
+}
+
+TEST_F(AttemptJournalTestFixture, record_which_is_part_of_snapshot_is_ignored)
+{
+	// Arrange
+	auto snapshot = createStats(2, 100.0f);
+	auto record = AttemptJournal::createRecord(createStats(2, 100.0f), 0, true, {});
+
+	// Act
+	auto recordWasApplied = AttemptJournal::applyRecord(record, snapshot, nullptr);
+
+	// Assert
+	EXPECT_FALSE(recordWasApplied);
+	EXPECT_EQ(snapshot.AllShotStats.Stats.Attempts, 2);
+	EXPECT_EQ(snapshot.AllShotStats.Stats.GoalSpeed.Count, 2);
+}
+
+TEST_F(AttemptJournalTestFixture, partially_written_record_is_ignored)
+{
+	// Arrange
+	auto firstRecord = AttemptJournal::createRecord(createStats(1, 100.0f), 0, true, {});
+	auto secondRecord = AttemptJournal::createRecord(createStats(2, 100.0f), 0, true, {});
+	ASSERT_TRUE(AttemptJournal::appendRecord(_journalPath, firstRecord));
+	ASSERT_TRUE(AttemptJournal::appendRecord(_journalPath, secondRecord));
+	{
+		// Simulate a crash while writing the third record
+		std::ofstream journalStream(_journalPath, std::ios::out | std::ios::binary | std::ios::app);
+		journalStream.write(reinterpret_cast<const char*>(&secondRecord), sizeof(secondRecord) / 2);
+	}
+
+	// Act
+	auto records = AttemptJournal::readRecords(_journalPath);
+
+	// Assert
+	ASSERT_EQ(records.size(), 2);
+	EXPECT_EQ(records[0].Summary.Attempts, 1);
+	EXPECT_EQ(records[1].Summary.Attempts, 2);
+}
@@ -0,0 +1,247 @@
+#include "Fixtures/BinaryStatFileTestFixture.h"
+
+TEST_F(BinaryStatFileTestFixture, stats_survive_round_trip)
+{
+	// Arrange
+	ShotStats stats;
+	stats.PerShotStats.resize(2);
+	stats.AllShotStats.Stats.Attempts = 3;
+	stats.AllShotStats.Stats.Goals = 2;
+	stats.AllShotStats.Stats.LongestMissStreak = 1;
+	stats.AllShotStats.Stats.MaxAirDribbleTime = 1.5f;
+	stats.AllShotStats.Stats.RecentShots = { true, false, true };
+	stats.AllShotStats.Data.SuccessPercentage = 66.67;
+	stats.PerShotStats[1].Stats.Attempts = 3;
+	stats.PerShotStats[1].Stats.Goals = 2;
+	stats.insertGoalSpeed(1, 80.0f);
+	stats.insertGoalSpeed(1, 100.0f);
+
+	BinaryStatFileSerializer serializer;
+	writeFile(serializer.serialize(stats, nullptr));
+
+	// Act
+	auto readStats = _statReader->readStats(_filePath.u8string(), RestorableFields);
+
+	// Assert
+	EXPECT_EQ(_statReader->peekAttemptAmount(_filePath.u8string()), 3);
+	EXPECT_EQ(readStats.AllShotStats.Stats.Attempts, 3);
+	EXPECT_EQ(readStats.AllShotStats.Stats.Goals, 2);
+	EXPECT_EQ(readStats.AllShotStats.Stats.LongestMissStreak, 1);
+	EXPECT_EQ(readStats.AllShotStats.Stats.MaxAirDribbleTime, 1.5f);
+	EXPECT_EQ(readStats.AllShotStats.Stats.RecentShots, stats.AllShotStats.Stats.RecentShots);
+	EXPECT_EQ(readStats.AllShotStats.Stats.GoalSpeed.Count, 2);
+	EXPECT_EQ(readStats.AllShotStats.Stats.GoalSpeed.Median, 90.0f);
+	EXPECT_EQ(readStats.getGoalSpeedValues(-1).getValues(), std::vector<float>({ 80.0f, 100.0f }));
+	EXPECT_DOUBLE_EQ(readStats.AllShotStats.Data.SuccessPercentage, 66.67);
+	ASSERT_EQ(readStats.PerShotStats.size(), 2);
+	EXPECT_EQ(readStats.PerShotStats[0].Stats.Attempts, 0);
+	EXPECT_EQ(readStats.PerShotStats[1].Stats.Attempts, 3);
+	EXPECT_EQ(readStats.PerShotStats[1].Stats.GoalSpeed.Count, 2);
+	EXPECT_EQ(readStats.getGoalSpeedValues(1).getCount(), 2);
+}
+
+TEST_F(BinaryStatFileTestFixture, truncated_file_is_rejected)
+{
+	// Arrange
+	ShotStats stats;
+	stats.PerShotStats.resize(2);
+	stats.AllShotStats.Stats.Attempts = 1;
+
+	BinaryStatFileSerializer serializer;
+	auto fileContent = serializer.serialize(stats, nullptr);
+	writeFile(fileContent.substr(0, fileContent.size() / 2));
+
+	// Act
+	auto readStats = _statReader->readStats(_filePath.u8string(), StatFieldMask::DiffComparable);
+
+	// Assert
+	EXPECT_FALSE(readStats.hasAttempts());
+	EXPECT_TRUE(readStats.PerShotStats.empty());
+}
+
+TEST_F(BinaryStatFileTestFixture, diff_comparable_read_skips_goal_speed_values)
+{
+	// Arrange
+	ShotStats stats;
+	stats.PerShotStats.resize(1);
+	stats.AllShotStats.Stats.Attempts = 3;
+	for (auto goalSpeed : { 80.0f, 90.0f, 130.0f })
+	{
+		stats.insertGoalSpeed(0, goalSpeed);
+	}
+
+	BinaryStatFileSerializer serializer;
+	writeFile(serializer.serialize(stats, nullptr));
+
+	// Act
+	auto comparableStats = _statReader->readStats(_filePath.u8string(), StatFieldMask::DiffComparable);
+	auto summaryStats = _statReader->readStats(_filePath.u8string(), StatFieldMask::SummaryOnly);
+
+	// Assert
+	const auto& expectedGoalSpeedStats = stats.AllShotStats.Stats.GoalSpeed;
+	const auto& goalSpeedStats = comparableStats.AllShotStats.Stats.GoalSpeed;
+	EXPECT_EQ(goalSpeedStats.Count, 0); // The values were not restored
+	EXPECT_EQ(comparableStats.getGoalSpeedValues(-1).getCount(), 0);
+	EXPECT_EQ(goalSpeedStats.Median, expectedGoalSpeedStats.Median);
+	EXPECT_EQ(goalSpeedStats.Mean, expectedGoalSpeedStats.Mean);
+	EXPECT_EQ(goalSpeedStats.Max, expectedGoalSpeedStats.Max);
+	EXPECT_FLOAT_EQ(goalSpeedStats.StdDev, expectedGoalSpeedStats.StdDev);
+	ASSERT_EQ(comparableStats.PerShotStats.size(), 1);
+	EXPECT_FLOAT_EQ(comparableStats.PerShotStats[0].Stats.GoalSpeed.StdDev, expectedGoalSpeedStats.StdDev);
+
+	EXPECT_EQ(summaryStats.AllShotStats.Stats.Attempts, 3);
+	EXPECT_EQ(summaryStats.AllShotStats.Stats.GoalSpeed.Median, expectedGoalSpeedStats.Median);
+	EXPECT_TRUE(summaryStats.PerShotStats.empty());
+}
+
+TEST_F(BinaryStatFileTestFixture, rolling_windows_and_more_than_64_recent_shots_survive_round_trip)
+{
+	// Arrange
+	ShotStats stats;
+	stats.PerShotStats.resize(1);
+	for (int shotNumber = 0; shotNumber < 130; shotNumber++)
+	{
+		stats.AllShotStats.Stats.RecentShots.push_back(shotNumber % 3 == 0);
+	}
+	stats.AllShotStats.Stats.Attempts = 130;
+	stats.AllShotStats.Data.RollingWindows[0] = RollingWindow{ 10, 4, 40.0, 70.0, 35 };
+	stats.AllShotStats.Data.RollingWindows[1] = RollingWindow{ 100, 34, 34.0, 36.0, 101 };
+
+	BinaryStatFileSerializer serializer;
+	writeFile(serializer.serialize(stats, nullptr));
+
+	// Act
+	auto readStats = _statReader->readStats(_filePath.u8string(), RestorableFields);
+
+	// Assert
+	EXPECT_EQ(readStats.AllShotStats.Stats.RecentShots, stats.AllShotStats.Stats.RecentShots);
+	const auto& windows = readStats.AllShotStats.Data.RollingWindows;
+	EXPECT_EQ(windows[0].Size, 10);
+	EXPECT_EQ(windows[0].Goals, 4);
+	EXPECT_DOUBLE_EQ(windows[0].PeakPercentage, 70.0);
+	EXPECT_EQ(windows[0].PeakShotNumber, 35);
+	EXPECT_EQ(windows[1].Size, 100);
+	EXPECT_DOUBLE_EQ(windows[1].Percentage, 34.0);
+	EXPECT_EQ(windows[2].Size, 0);
+	ASSERT_EQ(readStats.PerShotStats.size(), 1);
+	EXPECT_EQ(readStats.PerShotStats[0].Data.RollingWindows[0].Size, 0);
+}
+
+TEST_F(BinaryStatFileTestFixture, goal_speed_sketch_read_skips_goal_speed_values)
+{
+	// Arrange
+	ShotStats stats;
+	stats.PerShotStats.resize(1);
+	stats.AllShotStats.Stats.Attempts = 3;
+	for (auto goalSpeed : { 80.0f, 90.0f, 130.0f })
+	{
+		stats.insertGoalSpeed(0, goalSpeed);
+	}
+
+	BinaryStatFileSerializer serializer;
+	writeFile(serializer.serialize(stats, nullptr));
+
+	// Act
+	auto sketchedStats = _statReader->readStats(_filePath.u8string(), StatFieldMask::Summary | StatFieldMask::PerShotStats | StatFieldMask::GoalSpeedSketch);
+
+	// Assert
+	const auto& expectedGoalSpeedStats = stats.getGoalSpeedValues(-1);
+	const auto& goalSpeedStats = sketchedStats.GoalSpeedSketch;
+	EXPECT_EQ(sketchedStats.getGoalSpeedValues(-1).getCount(), 0); // The values were not restored
+	EXPECT_EQ(goalSpeedStats.getCount(), 3);
+	EXPECT_EQ(goalSpeedStats.getMostRecent(), 130.0f);
+	EXPECT_EQ(goalSpeedStats.getMin(), 80.0f);
+	EXPECT_EQ(goalSpeedStats.getPercentile(.25f), 85.0f);
+	EXPECT_EQ(goalSpeedStats.getMedian(), expectedGoalSpeedStats.getMedian());
+	EXPECT_FLOAT_EQ(goalSpeedStats.getMean(), expectedGoalSpeedStats.getMean());
+	EXPECT_FLOAT_EQ(goalSpeedStats.getStdDev(), expectedGoalSpeedStats.getStdDev());
+	EXPECT_EQ(sketchedStats.AllShotStats.Stats.GoalSpeed.Count, 3);
+	EXPECT_FLOAT_EQ(sketchedStats.AllShotStats.Stats.GoalSpeed.StdDev, expectedGoalSpeedStats.getStdDev());
+	ASSERT_EQ(sketchedStats.PerShotStats.size(), 1);
+	EXPECT_EQ(sketchedStats.PerShotStats[0].Stats.GoalSpeed.Max, 130.0f);
+
+	// Sketches of several sessions can be merged
+	SketchedGoalSpeed history;
+	goalSpeedStats.mergeInto(history);
+	expectedGoalSpeedStats.mergeInto(history);
+	EXPECT_EQ(history.getCount(), 6);
+	EXPECT_EQ(history.getMedian(), 90.0f);
+	EXPECT_FLOAT_EQ(history.getMean(), expectedGoalSpeedStats.getMean());
+}
+
+TEST_F(BinaryStatFileTestFixture, heatmap_survives_round_trip)
+{
+	// Arrange
+	ShotStats stats;
+	stats.PerShotStats.resize(1);
+	stats.AllShotStats.Stats.Attempts = 3;
+	std::vector<Vector> impactLocations = { { -3990.0f, 5090.0f, 10.0f }, { 0.0f, 5090.0f, 1000.0f }, { 60.0f, 5090.0f, 1000.0f } };
+	ImpactHeatmap heatmap;
+	for (const auto& impactLocation : impactLocations)
+	{
+		heatmap.addImpact(impactLocation);
+	}
+
+	BinaryStatFileSerializer serializer;
+	writeFile(serializer.serialize(stats, &impactLocations, &heatmap));
+
+	// Act
+	auto impacts = _statReader->readImpactLocations(_filePath.u8string());
+
+	// Assert
+	ASSERT_EQ(impacts.Locations.size(), 3);
+	EXPECT_EQ(impacts.Locations[1].Z, 1000.0f);
+	ASSERT_NE(impacts.Heatmap, nullptr);
+	EXPECT_EQ(impacts.NumberOfLocationsInHeatmap, 3);
+	EXPECT_EQ(impacts.Heatmap->getMaximumValue(), heatmap.getMaximumValue());
+	EXPECT_TRUE(impacts.Heatmap->getData() == heatmap.getData());
+}
+
+TEST_F(BinaryStatFileTestFixture, file_without_heatmap_provides_impact_locations_only)
+{
+	// Arrange
+	ShotStats stats;
+	stats.PerShotStats.resize(1);
+	stats.AllShotStats.Stats.Attempts = 1;
+	std::vector<Vector> impactLocations = { { 0.0f, 5090.0f, 1000.0f } };
+
+	BinaryStatFileSerializer serializer;
+	writeFile(serializer.serialize(stats, &impactLocations));
+
+	// Act
+	auto impacts = _statReader->readImpactLocations(_filePath.u8string());
+
+	// Assert
+	EXPECT_EQ(impacts.Locations.size(), 1);
+	EXPECT_EQ(impacts.Heatmap, nullptr);
+	EXPECT_EQ(impacts.NumberOfLocationsInHeatmap, 0);
+}
+
+TEST_F(BinaryStatFileTestFixture, file_of_newer_minor_version_is_read)
+{
+	// Arrange
+	ShotStats stats;
+	stats.PerShotStats.resize(1);
+	stats.AllShotStats.Stats.Attempts = 4;
+
+	BinaryStatFileSerializer serializer;
+	auto fileContent = std::string(serializer.serialize(stats, nullptr));
+
+	// Pretend a newer version appended a section this version does not know
+	uint16_t newerMinorVersion = BinaryStatFileDefs::MinorVersion + 1;
+	std::memcpy(fileContent.data() + 6, &newerMinorVersion, sizeof(newerMinorVersion));
+	uint32_t numberOfSections;
+	std::memcpy(&numberOfSections, fileContent.data() + 16, sizeof(numberOfSections));
+	numberOfSections++;
+	std::memcpy(fileContent.data() + 16, &numberOfSections, sizeof(numberOfSections));
+	uint32_t unknownSection[] = { 999, 4, 12345 };
+	fileContent.append(reinterpret_cast<const char*>(unknownSection), sizeof(unknownSection));
+	writeFile(fileContent);
+
+	// Act
+	auto readStats = _statReader->readStats(_filePath.u8string(), RestorableFields);
+
+	// Assert
+	EXPECT_EQ(readStats.AllShotStats.Stats.Attempts, 4);
+	ASSERT_EQ(readStats.PerShotStats.size(), 1);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <memory>
+
+#include <gmock/gmock.h>
+
+#include <Plugin/Calculation/AllTimePeakHandler.h>
+
+#include "../Mocks/IStatReaderMock.h"
+#include "../Mocks/IStatWriterMock.h"
+
+class AllTimePeakHandlerTestFixture : public ::testing::Test
+{
+public:
+	std::shared_ptr<ShotStats> _shotStats = std::make_shared<ShotStats>();
+	std::shared_ptr<PluginState> _pluginState = std::make_shared<PluginState>();
+	std::shared_ptr<IStatReaderMock> _statReader;
+	std::shared_ptr<IStatWriterMock> _statWriter;
+
+	std::shared_ptr<AllTimePeakHandler> peakHandler;
+
+	static constexpr const char* FakeTrainingPackCode = "ABCD-0123-EF45-6789";
+
+	void SetUp() override
+	{
+		_statReader = std::make_shared<::testing::StrictMock<IStatReaderMock>>();
+		_statWriter = std::make_shared<::testing::StrictMock<IStatWriterMock>>();
+		peakHandler = std::make_shared<AllTimePeakHandler>(_statReader, _statWriter, _pluginState, _shotStats, nullptr /* read files right away */);
+		_pluginState->TrainingPackCode = FakeTrainingPackCode;
+
+		// Two shots, with enough attempts for peak stats to be stored
+		_shotStats->AllShotStats.Stats.Attempts = 20;
+		_shotStats->PerShotStats.resize(2);
+		_shotStats->PerShotStats[0].Stats.Attempts = 10;
+		_shotStats->PerShotStats[1].Stats.Attempts = 10;
+	}
+
+	/** Creates the content of an existing peak file where the longest goal streak of the training pack and of every shot is the given value. */
+	ShotStats createPeakFile(int longestGoalStreak) const
+	{
+		auto peakStats = *_shotStats;
+		peakStats.AllShotStats.Stats.LongestGoalStreak = longestGoalStreak;
+		for (auto& statsData : peakStats.PerShotStats)
+		{
+			statsData.Stats.LongestGoalStreak = longestGoalStreak;
+		}
+		return peakStats;
+	}
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <filesystem>
+
+#include <gmock/gmock.h>
+
+#include <Plugin/Data/ShotStats.h>
+#include <Plugin/Storage/AttemptJournal.h>
+
+class AttemptJournalTestFixture : public ::testing::Test
+{
+public:
+	std::filesystem::path _journalPath;
+
+	void SetUp() override
+	{
+		_journalPath = std::filesystem::temp_directory_path() / "AttemptJournalTest.journal";
+		AttemptJournal::removeJournal(_journalPath);
+	}
+
+	void TearDown() override
+	{
+		AttemptJournal::removeJournal(_journalPath);
+	}
+
+	/** Creates stats for two shots, where the given amount of attempts was made on the first shot. Every attempt is a goal with the given speed. */
+	static ShotStats createStats(int numberOfGoals, float goalSpeed)
+	{
+		ShotStats stats;
+		stats.PerShotStats.resize(2);
+		for (auto* statsData : { &stats.AllShotStats, &stats.PerShotStats[0] })
+		{
+			statsData->Stats.Attempts = numberOfGoals;
+			statsData->Stats.Goals = numberOfGoals;
+			statsData->Stats.GoalStreakCounter = numberOfGoals;
+			statsData->Stats.LongestGoalStreak = numberOfGoals;
+			statsData->Data.SuccessPercentage = numberOfGoals > 0 ? 100.0 : .0;
+			for (int goal = 0; goal < numberOfGoals; goal++)
+			{
+				statsData->Stats.RecentShots.push_back(true);
+			}
+		}
+		for (int goal = 0; goal < numberOfGoals; goal++)
+		{
+			stats.insertGoalSpeed(0, goalSpeed);
+		}
+		return stats;
+	}
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+
+#include <gmock/gmock.h>
+
+#include <Plugin/Data/ShotStats.h>
+#include <Plugin/Storage/BinaryStatFileSerializer.h>
+#include <Plugin/Storage/StatFileReader.h>
+
+class BinaryStatFileTestFixture : public ::testing::Test
+{
+public:
+	std::filesystem::path _filePath;
+	std::shared_ptr<StatFileReader> _statReader;
+
+	/** Everything but the impact locations, which would require a shot distribution tracker. */
+	static constexpr StatFieldMask RestorableFields = StatFieldMask::AllExceptImpactLocations;
+
+	void SetUp() override
+	{
+		_filePath = std::filesystem::temp_directory_path() / "BinaryStatFileTest.bin";
+		// No game wrapper and no shot distribution tracker are required as long as stats are not about to be restored
+		_statReader = std::make_shared<StatFileReader>(nullptr, nullptr, nullptr);
+	}
+
+	void TearDown() override
+	{
+		std::error_code errorCode;
+		std::filesystem::remove(_filePath, errorCode);
+	}
+
+	void writeFile(std::string_view fileContent)
+	{
+		std::ofstream fileStream(_filePath, std::ios::out | std::ios::trunc | std::ios::binary);
+		fileStream.write(fileContent.data(), fileContent.size());
+	}
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <gmock/gmock.h>
+
+#include <Plugin/Calculation/ImpactHeatmap.h>
+
+class ImpactHeatmapTestFixture : public ::testing::Test
+{
+public:
+	std::unique_ptr<ImpactHeatmap> heatmap = std::make_unique<ImpactHeatmap>();
+
+	/** Calculates the expected value of the given bracket after a single impact, the way the heatmap was calculated before the kernel was precomputed. */
+	static float getReferenceValue(int x, int z, int xBracket, int zBracket)
+	{
+		auto xDifference = std::abs(x - xBracket);
+		auto zDifference = std::abs(z - zBracket);
+		if (xDifference > ImpactHeatmap::KernelRadius || zDifference > ImpactHeatmap::KernelRadius)
+		{
+			return .0f;
+		}
+		return 0.5f / std::pow(2.0f, (float)xDifference) + 0.5f / std::pow(2.0f, (float)zDifference);
+	}
+
+	/** Creates impact locations which are spread across the whole backboard, including some which are partially outside of it. */
+	static std::vector<Vector> createImpactLocations(size_t numberOfLocations)
+	{
+		std::vector<Vector> locations;
+		locations.reserve(numberOfLocations);
+		for (size_t index = 0; index < numberOfLocations; index++)
+		{
+			locations.emplace_back((float)((index * 7919) % 8400) - 4200.0f, 5100.0f, (float)((index * 104729) % 4200));
+		}
+		return locations;
+	}
+};
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <gmock/gmock.h>
+
+#include <Plugin/Display/NumberFormatter.h>
+
+class NumberFormatterTestFixture : public ::testing::Test
+{
+public:
+	NumberFormatter pointFormatter{ '.' };
+	NumberFormatter commaFormatter{ ',' };
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <gmock/gmock.h>
+
+#include <Plugin/Data/OrderStatisticTree.h>
+
+class OrderStatisticTreeTestFixture : public ::testing::Test
+{
+public:
+	OrderStatisticTree tree;
+
+	void SetUp() override
+	{
+		tree.clear();
+	}
+
+	void expectMedian(float value)
+	{
+		EXPECT_EQ(tree.getPercentile(.5), value);
+	}
+
+	void expectCount(size_t value)
+	{
+		EXPECT_EQ(tree.size(), value);
+	}
+};
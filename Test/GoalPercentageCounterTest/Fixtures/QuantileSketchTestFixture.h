@@ -0,0 +1,34 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <gmock/gmock.h>
+
+#include <Plugin/Data/QuantileSketch.h>
+
+class QuantileSketchTestFixture : public ::testing::Test
+{
+public:
+	QuantileSketch sketch;
+
+	/** Creates the given number of distinct values in a scrambled order. */
+	static std::vector<float> createValues(int numberOfValues, int offset = 0)
+	{
+		std::vector<float> values;
+		for (auto index = 0; index < numberOfValues; index++)
+		{
+			values.push_back(50.0f + (float)((index * 7919 + offset) % numberOfValues) * .001f);
+		}
+		return values;
+	}
+
+	/** Expects the percentile of the sketch to be at most maximumRankError (relative to the number of values) away from the exact percentile of the given sorted values. */
+	void expectPercentileRank(const std::vector<float>& sortedValues, double percentile, double maximumRankError)
+	{
+		auto value = sketch.getPercentile(percentile);
+		auto rank = (double)(std::lower_bound(sortedValues.begin(), sortedValues.end(), value) - sortedValues.begin());
+		auto expectedRank = percentile * (double)(sortedValues.size() - 1);
+		EXPECT_LE(std::abs(rank - expectedRank) / (double)sortedValues.size(), maximumRankError) << "Percentile " << percentile;
+	}
+};
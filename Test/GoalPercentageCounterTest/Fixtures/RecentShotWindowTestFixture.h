@@ -0,0 +1,31 @@
+#pragma once
+
+#include <gmock/gmock.h>
+
+#include <Plugin/Data/RecentShotWindow.h>
+
+class RecentShotWindowTestFixture : public ::testing::Test
+{
+public:
+	RecentShotWindow<70> recentShots; // Spans two words, so the wrap around can happen in either of them
+
+	/** Adds the given number of shots, where every third shot is a goal. */
+	void addShots(size_t numberOfShots)
+	{
+		for (size_t shotNumber = 0; shotNumber < numberOfShots; shotNumber++)
+		{
+			recentShots.push_back(shotNumber % 3 == 0);
+		}
+	}
+
+	/** Counts the goals among the most recent shots one by one, for comparison. */
+	size_t countGoalsInLast(size_t numberOfShots) const
+	{
+		size_t numberOfGoals = 0;
+		for (auto index = recentShots.size() - numberOfShots; index < recentShots.size(); index++)
+		{
+			if (recentShots[index]) { numberOfGoals++; }
+		}
+		return numberOfGoals;
+	}
+};
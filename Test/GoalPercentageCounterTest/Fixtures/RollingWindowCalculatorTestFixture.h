@@ -0,0 +1,33 @@
+#pragma once
+
+#include <gmock/gmock.h>
+
+#include <Plugin/Calculation/RollingWindowCalculator.h>
+
+class RollingWindowCalculatorTestFixture : public ::testing::Test
+{
+public:
+	StatsData statsData;
+
+	/** Adds the given number of attempts, where every third attempt is a goal, and updates the percentages like StatUpdater does. */
+	void addShots(int numberOfShots)
+	{
+		for (int shotNumber = 0; shotNumber < numberOfShots; shotNumber++)
+		{
+			statsData.Stats.Attempts++;
+			RollingWindowCalculator::addShot(statsData, shotNumber % 3 == 0);
+			RollingWindowCalculator::updatePercentages(statsData);
+		}
+	}
+
+	/** Retrieves the window of the given size. Fails the test if there is no such window. */
+	const RollingWindow& getWindow(int windowSize) const
+	{
+		for (const auto& window : statsData.Data.RollingWindows)
+		{
+			if (window.Size == windowSize) { return window; }
+		}
+		ADD_FAILURE() << "There is no window of size " << windowSize;
+		return statsData.Data.RollingWindows.front();
+	}
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+
+#include <gmock/gmock.h>
+
+#include <Plugin/Storage/SessionIndex.h>
+
+class SessionIndexTestFixture : public ::testing::Test
+{
+public:
+	std::filesystem::path _folderPath;
+	SessionIndex::SummaryReader _readSummary;
+	int _numberOfReadSessions = 0;
+
+	void SetUp() override
+	{
+		_folderPath = std::filesystem::temp_directory_path() / "SessionIndexTest";
+		std::filesystem::remove_all(_folderPath);
+		std::filesystem::create_directories(_folderPath);
+
+		// Pretend every session has as many attempts as its name has characters
+		_numberOfReadSessions = 0;
+		_readSummary = [this](const std::filesystem::path& sessionFilePath, SessionIndexEntry& entry) {
+			_numberOfReadSessions++;
+			entry.Attempts = (int)sessionFilePath.stem().u8string().size();
+			entry.Goals = 1;
+			entry.NumberOfShots = 2;
+			entry.Version = "2.0";
+			return true;
+		};
+	}
+
+	void TearDown() override
+	{
+		std::filesystem::remove_all(_folderPath);
+	}
+
+	void createFile(const std::string& fileName)
+	{
+		std::ofstream(_folderPath / fileName) << "content";
+	}
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <memory>
+
+#include <gmock/gmock.h>
+
+#include <Plugin/Storage/SessionPrefetchCache.h>
+
+#include "../Mocks/IStatReaderMock.h"
+
+class SessionPrefetchCacheTestFixture : public ::testing::Test
+{
+public:
+	std::shared_ptr<IStatReaderMock> _statReader;
+	std::shared_ptr<SessionPrefetchCache> _prefetchCache;
+
+	static const std::string FakeTrainingPackCode;
+	static const std::string MostRecentSession;
+	static const std::string PreviousSession;
+
+	void SetUp() override
+	{
+		_statReader = std::make_shared<::testing::StrictMock<IStatReaderMock>>();
+		_prefetchCache = std::make_shared<SessionPrefetchCache>(_statReader, nullptr /* not testing impact locations */, nullptr /* load right away */);
+
+		ON_CALL(*_statReader, getAvailableResourcePaths(FakeTrainingPackCode)).WillByDefault(::testing::Return(std::vector<std::string>{ MostRecentSession, PreviousSession }));
+		ON_CALL(*_statReader, peekAttemptAmount(::testing::_)).WillByDefault(::testing::Return(1));
+		ON_CALL(*_statReader, readStats(MostRecentSession, ::testing::_)).WillByDefault(::testing::Return(createStats(10)));
+		ON_CALL(*_statReader, readStats(PreviousSession, ::testing::_)).WillByDefault(::testing::Return(createStats(20)));
+		ON_CALL(*_statReader, readTrainingPackStatistics(FakeTrainingPackCode)).WillByDefault(::testing::Return(createStats(30)));
+	}
+
+	/** Creates stats which can be identified by their number of attempts. */
+	static ShotStats createStats(int attempts)
+	{
+		ShotStats stats;
+		stats.AllShotStats.Stats.Attempts = attempts;
+		return stats;
+	}
+
+	/** Expects both previous sessions to be read the given number of times, and the peak stats to be read once.
+	 * Single sessions which are read on demand only add to the number of times the most recent session is looked up.
+	 */
+	void expectSessionLoads(int numberOfLoads, int numberOfSingleReads = 0)
+	{
+		EXPECT_CALL(*_statReader, readTrainingPackStatistics(FakeTrainingPackCode)).Times(1);
+		EXPECT_CALL(*_statReader, getAvailableResourcePaths(FakeTrainingPackCode)).Times(numberOfLoads + numberOfSingleReads);
+		EXPECT_CALL(*_statReader, peekAttemptAmount(::testing::_)).Times(2 * numberOfLoads + numberOfSingleReads);
+		EXPECT_CALL(*_statReader, readStats(MostRecentSession, StatFieldMask::AllExceptImpactLocations)).Times(numberOfLoads);
+		EXPECT_CALL(*_statReader, readImpactLocations(MostRecentSession)).Times(numberOfLoads);
+		EXPECT_CALL(*_statReader, readStats(PreviousSession, StatFieldMask::DiffComparable)).Times(numberOfLoads);
+	}
+
+	/** Requests a previous session and returns its number of attempts, or -1 if the request was not answered. */
+	int requestAttempts(int numberOfSkips)
+	{
+		auto attempts = -1;
+		_prefetchCache->requestPreviousSession(FakeTrainingPackCode, numberOfSkips, [&attempts](const ShotStats& stats) {
+			attempts = stats.AllShotStats.Stats.Attempts;
+		});
+		return attempts;
+	}
+};
+
+inline const std::string SessionPrefetchCacheTestFixture::FakeTrainingPackCode = "ABCD-EFGH-IJKL-MNOP";
+inline const std::string SessionPrefetchCacheTestFixture::MostRecentSession = "session_2";
+inline const std::string SessionPrefetchCacheTestFixture::PreviousSession = "session_1";
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <filesystem>
+
+#include <gmock/gmock.h>
+
+#include <Plugin/Data/ShotStats.h>
+#include <Plugin/Storage/StatFileReader.h>
+#include <Plugin/Storage/StatFileWriter.h>
+
+class StatFileWriterTestFixture : public ::testing::Test
+{
+public:
+	std::filesystem::path _folderPath;
+	std::shared_ptr<ShotStats> _shotStats = std::make_shared<ShotStats>();
+	std::shared_ptr<StatFileWriter> _statWriter;
+	std::shared_ptr<StatFileReader> _statReader;
+
+	void SetUp() override
+	{
+		_folderPath = std::filesystem::temp_directory_path() / "StatFileWriterTest";
+		std::error_code errorCode;
+		std::filesystem::remove_all(_folderPath, errorCode);
+
+		// Files are written right away without a storage worker. No shot distribution tracker is required as long as there are no impacts
+		_statWriter = std::make_shared<StatFileWriter>(nullptr, _shotStats, nullptr, nullptr, nullptr, nullptr);
+		_statReader = std::make_shared<StatFileReader>(nullptr, nullptr, nullptr);
+		_shotStats->PerShotStats.resize(1);
+	}
+
+	void TearDown() override
+	{
+		std::error_code errorCode;
+		std::filesystem::remove_all(_folderPath, errorCode);
+	}
+
+	/** Retrieves the session file which was created by the writer. */
+	std::filesystem::path findSessionFile() const
+	{
+		for (const auto& entry : std::filesystem::directory_iterator(_folderPath))
+		{
+			if (entry.path().extension() == ".bin") { return entry.path(); }
+		}
+		return {};
+	}
+
+	/** Adds a miss to the only shot. */
+	void addAttempt()
+	{
+		_shotStats->AllShotStats.Stats.Attempts++;
+		_shotStats->PerShotStats[0].Stats.Attempts++;
+	}
+
+	int readAttempts(const std::filesystem::path& sessionFilePath) const
+	{
+		return _statReader->readStats(sessionFilePath.u8string(), StatFieldMask::AllExceptImpactLocations).AllShotStats.Stats.Attempts;
+	}
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+
+#include <Plugin/Display/StatRowPlan.h>
+
+class StatRowPlanTestFixture : public ::testing::Test
+{
+public:
+	StatRowPlan plan;
+	StatsData statsData;
+
+	/** Retrieves the ids of the planned stats, in display order. */
+	std::vector<StatRowId> getPlannedIds() const
+	{
+		std::vector<StatRowId> ids;
+		for (const auto& entry : plan.getEntries())
+		{
+			ids.push_back(entry.Id);
+		}
+		return ids;
+	}
+};
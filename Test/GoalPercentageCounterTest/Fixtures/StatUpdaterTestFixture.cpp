@@ -15,14 +15,14 @@ void StatUpdaterTestFixture::expectTotalStats(const PlayerStats& expectedStats)
 	EXPECT_EQ(allShotStats.MissStreakCounter, expectedStats.MissStreakCounter);
 	EXPECT_EQ(allShotStats.LongestGoalStreak, expectedStats.LongestGoalStreak);
 	EXPECT_EQ(allShotStats.LongestMissStreak, expectedStats.LongestMissStreak);
-	if (expectedStats.Last50Shots.empty())
+	if (expectedStats.RecentShots.empty())
 	{
-		EXPECT_EQ(allShotStats.Last50Shots.empty(), true);
+		EXPECT_EQ(allShotStats.RecentShots.empty(), true);
 	}
 	else
 	{
-		EXPECT_EQ(allShotStats.Last50Shots.size(), expectedStats.Last50Shots.size());
-		EXPECT_EQ(allShotStats.Last50Shots.back(), expectedStats.Last50Shots.back());
+		EXPECT_EQ(allShotStats.RecentShots.size(), expectedStats.RecentShots.size());
+		EXPECT_EQ(allShotStats.RecentShots.back(), expectedStats.RecentShots.back());
 	}
 }
 void StatUpdaterTestFixture::expectPerShotStats(const PlayerStats& expectedStats, int shotNumber) const
@@ -40,13 +40,13 @@ void StatUpdaterTestFixture::expectPerShotStats(const PlayerStats& expectedStats
 	EXPECT_EQ(perShotStats.MissStreakCounter, expectedStats.MissStreakCounter);
 	EXPECT_EQ(perShotStats.LongestGoalStreak, expectedStats.LongestGoalStreak);
 	EXPECT_EQ(perShotStats.LongestMissStreak, expectedStats.LongestMissStreak);
-	if (expectedStats.Last50Shots.empty())
+	if (expectedStats.RecentShots.empty())
 	{
-		EXPECT_EQ(perShotStats.Last50Shots.empty(), true);
+		EXPECT_EQ(perShotStats.RecentShots.empty(), true);
 	}
 	else
 	{
-		EXPECT_EQ(perShotStats.Last50Shots.size(), expectedStats.Last50Shots.size());
-		EXPECT_EQ(perShotStats.Last50Shots.back(), expectedStats.Last50Shots.back());
+		EXPECT_EQ(perShotStats.RecentShots.size(), expectedStats.RecentShots.size());
+		EXPECT_EQ(perShotStats.RecentShots.back(), expectedStats.RecentShots.back());
 	}
 }
\ No newline at end of file
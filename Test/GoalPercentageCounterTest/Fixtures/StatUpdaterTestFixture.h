@@ -15,6 +15,7 @@ class StatUpdaterTestFixture : public ::testing::Test
 public:
 	std::shared_ptr<ShotStats> _shotStats = std::make_shared<ShotStats>();
 	std::shared_ptr<PluginState> _pluginState = std::make_shared<PluginState>();
+	std::shared_ptr<StatsSnapshotPublisher> _snapshotPublisher = std::make_shared<StatsSnapshotPublisher>();
 
 	std::shared_ptr<StatUpdater> statUpdater;
 	std::shared_ptr<IStatReaderMock> _statReader;
@@ -24,7 +25,7 @@ public:
 	void SetUp() override
 	{
 		_statReader = std::make_shared<::testing::StrictMock<IStatReaderMock>>();
-		statUpdater = std::make_shared<StatUpdater>(_shotStats, nullptr /* not testing stat differences */, _pluginState, _statReader, nullptr /* not testing peak stats */);
+		statUpdater = std::make_shared<StatUpdater>(_shotStats, nullptr /* not testing stat differences */, _pluginState, _statReader, nullptr /* not testing peak stats */, nullptr /* read files right away */, _snapshotPublisher);
 		statUpdater->publishTrainingPackCode(FakeTrainingPackCode);
 		_pluginState->TotalRounds = 2;
 		_pluginState->CurrentRoundIndex = 0;
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <future>
+#include <mutex>
+#include <vector>
+
+#include <gmock/gmock.h>
+
+#include <Plugin/Storage/StorageWorker.h>
+
+class StorageWorkerTestFixture : public ::testing::Test
+{
+public:
+	std::shared_ptr<StorageWorker> _storageWorker;
+	std::promise<void> _workerRelease;
+
+	std::mutex _mutex;
+	std::vector<int> _executedTasks;
+	std::vector<std::function<void()>> _gameThreadCallbacks;
+
+	void SetUp() override
+	{
+		// The game thread is simulated by collecting the callbacks and executing them on request
+		_storageWorker = std::make_shared<StorageWorker>([this](std::function<void()> callback) {
+			std::lock_guard<std::mutex> lock(_mutex);
+			_gameThreadCallbacks.push_back(callback);
+		});
+	}
+
+	void TearDown() override
+	{
+		_storageWorker->shutdown();
+	}
+
+	/** Keeps the worker busy until releaseWorker() gets called, so tasks can be queued up. */
+	void blockWorker()
+	{
+		auto release = _workerRelease.get_future().share();
+		_storageWorker->queueAppend({}, [release]() { release.wait(); });
+	}
+
+	void releaseWorker()
+	{
+		_workerRelease.set_value();
+	}
+
+	/** Creates a task which remembers it was executed. */
+	std::function<void()> createTask(int taskNumber)
+	{
+		return [this, taskNumber]() {
+			std::lock_guard<std::mutex> lock(_mutex);
+			_executedTasks.push_back(taskNumber);
+		};
+	}
+
+	void runGameThreadCallbacks()
+	{
+		std::vector<std::function<void()>> callbacks;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			callbacks.swap(_gameThreadCallbacks);
+		}
+		for (const auto& callback : callbacks)
+		{
+			callback();
+		}
+	}
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <gmock/gmock.h>
+
+#include <Plugin/Summary/SummaryRowCache.h>
+
+class SummaryRowCacheTestFixture : public ::testing::Test
+{
+public:
+	StatRowPlan plan;
+	SummaryRowCache cache;
+	StatsSnapshotPublisher publisher;
+	std::shared_ptr<TripleBuffer<StatsSnapshot>> snapshots = publisher.addReader();
+	ShotStats shotStats;
+
+	void SetUp() override
+	{
+		plan.rebuild(StatVisibilityMask::AttemptsAndGoals, { "Attempts/Goals" });
+		shotStats.PerShotStats.resize(2);
+		publisher.publish(shotStats, nullptr);
+	}
+
+	/** Changes the number of attempts of the given shot and of all shots, and publishes the stats the way they get published after an attempt. */
+	void setAttempts(int shotIndex, int attempts)
+	{
+		shotStats.PerShotStats[shotIndex].Stats.Attempts = attempts;
+		shotStats.AllShotStats.Stats.Attempts = attempts;
+		publisher.publishShot(shotStats, nullptr, shotIndex);
+	}
+
+	/** Reads the latest snapshot, updates the cache and retrieves the number of attempts displayed in the given row. */
+	std::string getDisplayedAttempts(size_t rowIndex)
+	{
+		const auto& snapshot = snapshots->readLatest();
+		cache.update(plan, snapshot, false);
+		return cache.getRow(plan, snapshot, rowIndex).front().Value;
+	}
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+
+#include <gmock/gmock.h>
+
+#include <Plugin/Data/ShotStats.h>
+#include <Plugin/Storage/StatFileSerializer.h>
+#include <Plugin/Storage/StatFileReader.h>
+
+class TextStatFileTestFixture : public ::testing::Test
+{
+public:
+	std::filesystem::path _filePath;
+	std::shared_ptr<StatFileReader> _statReader;
+
+	/** Everything but the impact locations, which would require a shot distribution tracker. */
+	static constexpr StatFieldMask RestorableFields = StatFieldMask::AllExceptImpactLocations;
+
+	void SetUp() override
+	{
+		_filePath = std::filesystem::temp_directory_path() / "TextStatFileTest.txt";
+		// No game wrapper and no shot distribution tracker are required as long as stats are not about to be restored
+		_statReader = std::make_shared<StatFileReader>(nullptr, nullptr, nullptr);
+	}
+
+	void TearDown() override
+	{
+		std::error_code errorCode;
+		std::filesystem::remove(_filePath, errorCode);
+	}
+
+	void writeFile(std::string_view fileContent)
+	{
+		std::ofstream fileStream(_filePath, std::ios::out | std::ios::trunc | std::ios::binary);
+		fileStream.write(fileContent.data(), fileContent.size());
+	}
+
+	/** Creates the stat block of a version 1.0 file, with Windows line endings and a decimal comma like a German locale would have produced. */
+	static std::string createVersion_1_0_Block(int attempts, int goals)
+	{
+		return fmt::format(
+			"------\r\nAttempts\t{}\r\nGoals\t{}\r\nInitialHits\t0\r\nCurrentGoalStreak\t0\r\nCurrentMissStreak\t0\r\nLongestGoalStreak\t1\r\nLongestMissStreak\t2\r\n"
+			"Last50ShotsPercentage\t010\r\nLatestGoalSpeed\t0,000000\r\nMaxGoalSpeed\t0,000000\r\nMinGoalSpeed\t0,000000\r\nMedianGoalSpeed\t0,000000\r\nMeanGoalSpeed\t0,000000\r\n"
+			"InitialHitPercentage\t0,000000\r\nTotalSuccessRate\t33,330000\r\nPeakSuccessRate\t50,000000\r\nPeakAtShotNumber\t2\r\n",
+			attempts, goals
+		);
+	}
+};
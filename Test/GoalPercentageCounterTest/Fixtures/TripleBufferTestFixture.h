@@ -0,0 +1,20 @@
+#pragma once
+
+#include <vector>
+
+#include <gmock/gmock.h>
+
+#include <Plugin/Data/TripleBuffer.h>
+
+class TripleBufferTestFixture : public ::testing::Test
+{
+public:
+	TripleBuffer<std::vector<int>> buffer;
+
+	/** Writes a list which contains the given value the given number of times, and publishes it. */
+	void publishValue(int value, size_t count = 1)
+	{
+		buffer.getWriteBuffer().assign(count, value);
+		buffer.publish();
+	}
+};
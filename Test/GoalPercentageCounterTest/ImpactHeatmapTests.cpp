@@ -0,0 +1,69 @@
+#include "Fixtures/ImpactHeatmapTestFixture.h"
+
+#include <chrono>
+
+TEST_F(ImpactHeatmapTestFixture, impact_matches_reference_falloff)
+{
+	// Act
+	heatmap->addImpact(40, 20);
+
+	// Assert
+	const auto& data = heatmap->getData();
+	for (auto x = 0; x < ImpactHeatmap::XBrackets; x++)
+	{
+		for (auto z = 0; z < ImpactHeatmap::ZBrackets; z++)
+		{
+			ASSERT_EQ(data[x][z], getReferenceValue(x, z, 40, 20)) << "x = " << x << ", z = " << z;
+		}
+	}
+	EXPECT_EQ(heatmap->getMaximumValue(), 1.0f);
+}
+
+TEST_F(ImpactHeatmapTestFixture, impact_at_the_border_gets_clipped)
+{
+	// Act
+	heatmap->addImpact(ImpactHeatmap::XBrackets - 2, 1);
+	heatmap->addImpact(-10, 20); // Completely outside of the grid
+
+	// Assert
+	const auto& data = heatmap->getData();
+	EXPECT_EQ(data[ImpactHeatmap::XBrackets - 2][1], 1.0f);
+	EXPECT_EQ(data[ImpactHeatmap::XBrackets - 1][0], getReferenceValue(ImpactHeatmap::XBrackets - 1, 0, ImpactHeatmap::XBrackets - 2, 1));
+	EXPECT_EQ(data[ImpactHeatmap::XBrackets - 7][1], getReferenceValue(ImpactHeatmap::XBrackets - 7, 1, ImpactHeatmap::XBrackets - 2, 1));
+	EXPECT_EQ(data[0][20], .0f);
+	EXPECT_EQ(heatmap->getMaximumValue(), 1.0f);
+}
+
+TEST_F(ImpactHeatmapTestFixture, overlapping_impacts_add_up)
+{
+	// Act
+	heatmap->addImpact(Vector{ 0.0f, 5100.0f, 1000.0f });
+	heatmap->addImpact(Vector{ 60.0f, 5100.0f, 1000.0f }); // One bracket to the right
+
+	// Assert
+	auto xBracket = 4000 / ImpactHeatmap::XBracketWidth;
+	auto zBracket = 1000 / ImpactHeatmap::ZBracketHeight;
+	EXPECT_EQ(heatmap->getData()[xBracket][zBracket], 1.0f + 0.75f);
+	EXPECT_EQ(heatmap->getData()[xBracket + 1][zBracket], 0.75f + 1.0f);
+	EXPECT_EQ(heatmap->getMaximumValue(), 1.75f);
+
+	heatmap->clear();
+	EXPECT_EQ(heatmap->getData()[xBracket][zBracket], .0f);
+	EXPECT_EQ(heatmap->getMaximumValue(), .0f);
+}
+
+// Run with --gtest_also_run_disabled_tests in a release build in order to measure how long restoring the heatmap of a large session takes
+TEST_F(ImpactHeatmapTestFixture, DISABLED_benchmark_restoring_50k_impacts)
+{
+	auto locations = createImpactLocations(50000);
+
+	auto start = std::chrono::steady_clock::now();
+	for (const auto& location : locations)
+	{
+		heatmap->addImpact(location);
+	}
+	auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+	std::cout << "Restoring " << locations.size() << " impacts took " << duration.count() << " microseconds" << std::endl;
+	EXPECT_GT(heatmap->getMaximumValue(), .0f);
+}
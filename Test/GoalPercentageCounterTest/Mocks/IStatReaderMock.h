@@ -7,7 +7,8 @@ class IStatReaderMock : public IStatReader
 {
 public:
 	MOCK_METHOD(std::vector<std::string>, getAvailableResourcePaths, (const std::string&), (override));
-	MOCK_METHOD(ShotStats, readStats, (const std::string&, bool), (override));
+	MOCK_METHOD(ShotStats, readStats, (const std::string&, StatFieldMask), (override));
 	MOCK_METHOD(int, peekAttemptAmount, (const std::string&), (override));
 	MOCK_METHOD(ShotStats, readTrainingPackStatistics, (const std::string& trainingPackCode), (override));
+	MOCK_METHOD(StoredImpacts, readImpactLocations, (const std::string&), (override));
 };
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <gmock/gmock.h>
+#include <Plugin/Core/IStatWriter.h>
+
+class IStatWriterMock : public IStatWriter
+{
+public:
+	MOCK_METHOD(void, initializeStorage, (const std::string&), (override));
+	MOCK_METHOD(void, writeData, (), (override));
+	MOCK_METHOD(void, compactStorage, (), (override));
+	MOCK_METHOD(void, writeTrainingPackStatistics, (const ShotStats&, const std::string&), (override));
+};
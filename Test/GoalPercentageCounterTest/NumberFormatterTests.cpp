@@ -0,0 +1,33 @@
+#include "Fixtures/NumberFormatterTestFixture.h"
+
+TEST_F(NumberFormatterTestFixture, formatFixed_uses_decimal_separator_of_the_formatter)
+{
+	EXPECT_EQ(pointFormatter.formatFixed(12.7531), "12.75");
+	EXPECT_EQ(commaFormatter.formatFixed(12.7531), "12,75");
+	EXPECT_EQ(commaFormatter.formatFixed(3.0, 0), "3");
+}
+
+TEST_F(NumberFormatterTestFixture, formatDifference_provides_sign_and_rounded_value)
+{
+	// Act
+	auto improvement = commaFormatter.formatDifference(1.256);
+	auto decline = commaFormatter.formatDifference(-3.0, 0);
+
+	// Assert
+	EXPECT_EQ(improvement.Text, "+1,26");
+	EXPECT_DOUBLE_EQ(improvement.Value, 1.26);
+	EXPECT_FALSE(improvement.IsNegative);
+	EXPECT_EQ(decline.Text, "-3");
+	EXPECT_DOUBLE_EQ(decline.Value, -3.0);
+	EXPECT_TRUE(decline.IsNegative);
+}
+
+TEST_F(NumberFormatterTestFixture, formatDifference_treats_values_which_round_to_zero_as_no_decline)
+{
+	// Act
+	auto difference = pointFormatter.formatDifference(-0.001);
+
+	// Assert
+	EXPECT_EQ(difference.Text, "+0.00");
+	EXPECT_FALSE(difference.IsNegative);
+}
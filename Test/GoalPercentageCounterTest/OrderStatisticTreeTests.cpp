@@ -0,0 +1,214 @@
+#include "Fixtures/OrderStatisticTreeTestFixture.h"
+
+#include <algorithm>
+
+TEST_F(OrderStatisticTreeTestFixture, increasing_insert)
+{
+	tree.insert(1.0f);
+	expectMedian(1.0f);
+	expectCount(1);
+
+	tree.insert(2.0f);
+	expectMedian(1.5f);
+	expectCount(2);
+
+	tree.insert(3.0f);
+	expectMedian(2.0f);
+	expectCount(3);
+
+	tree.insert(4.0f);
+	expectMedian(2.5f);
+	expectCount(4);
+
+	tree.insert(5.0f);
+	expectMedian(3.0f);
+	expectCount(5);
+}
+
+TEST_F(OrderStatisticTreeTestFixture, decreasing_insert)
+{
+	tree.insert(5.0f);
+	expectMedian(5.0f);
+	expectCount(1);
+
+	tree.insert(4.0f);
+	expectMedian(4.5f);
+	expectCount(2);
+
+	tree.insert(3.0f);
+	expectMedian(4.0f);
+	expectCount(3);
+
+	tree.insert(2.0f);
+	expectMedian(3.5f);
+	expectCount(4);
+
+	tree.insert(1.0f);
+	expectMedian(3.0f);
+	expectCount(5);
+}
+
+TEST_F(OrderStatisticTreeTestFixture, high_low_high)
+{
+	tree.insert(5.0f);
+	expectMedian(5.0f);
+	expectCount(1);
+
+	tree.insert(1.0f);
+	expectMedian(3.0f);
+	expectCount(2);
+
+	tree.insert(4.0f);
+	expectMedian(4.0f);
+	expectCount(3);
+
+	tree.insert(2.0f);
+	expectMedian(3.0f);
+	expectCount(4);
+
+	tree.insert(3.0f);
+	expectMedian(3.0f);
+	expectCount(5);
+}
+
+TEST_F(OrderStatisticTreeTestFixture, low_high_low)
+{
+	tree.insert(1.0f);
+	expectMedian(1.0f);
+	expectCount(1);
+
+	tree.insert(5.0f);
+	expectMedian(3.0f);
+	expectCount(2);
+
+	tree.insert(2.0f);
+	expectMedian(2.0f);
+	expectCount(3);
+
+	tree.insert(4.0f);
+	expectMedian(3.0f);
+	expectCount(4);
+
+	tree.insert(3.0f);
+	expectMedian(3.0f);
+	expectCount(5);
+}
+
+TEST_F(OrderStatisticTreeTestFixture, clear_test)
+{
+	tree.insert(1.0f);
+	expectMedian(1.0f);
+	expectCount(1);
+
+	tree.insert(2.0f);
+	expectMedian(1.5f);
+	expectCount(2);
+
+	tree.insert(3.0f);
+	expectMedian(2.0f);
+	expectCount(3);
+
+	tree.clear();
+	expectMedian(0.0f);
+	expectCount(0);
+
+	tree.insert(4.0f);
+	expectMedian(4.0f);
+	expectCount(1);
+
+	tree.insert(5.0f);
+	expectMedian(4.5f);
+	expectCount(2);
+
+	tree.insert(6.0f);
+	expectMedian(5.0f);
+	expectCount(3);
+}
+
+TEST_F(OrderStatisticTreeTestFixture, percentiles)
+{
+	for (auto value = 1; value <= 11; value++)
+	{
+		tree.insert((float)value * 10.0f);
+	}
+
+	EXPECT_EQ(tree.getPercentile(.0), 10.0f);
+	EXPECT_EQ(tree.getPercentile(.1), 20.0f);
+	EXPECT_EQ(tree.getPercentile(.25), 35.0f);
+	EXPECT_EQ(tree.getPercentile(.75), 85.0f);
+	EXPECT_EQ(tree.getPercentile(.9), 100.0f);
+	EXPECT_EQ(tree.getPercentile(1.0), 110.0f);
+	EXPECT_EQ(tree.getMin(), 10.0f);
+	EXPECT_EQ(tree.getMax(), 110.0f);
+}
+
+TEST_F(OrderStatisticTreeTestFixture, erase)
+{
+	tree.insert(3.0f);
+	tree.insert(1.0f);
+	tree.insert(2.0f);
+	tree.insert(2.0f);
+	expectMedian(2.0f);
+	expectCount(4);
+
+	EXPECT_FALSE(tree.erase(4.0f));
+	expectCount(4);
+
+	EXPECT_TRUE(tree.erase(2.0f));
+	expectMedian(2.0f);
+	expectCount(3);
+
+	EXPECT_TRUE(tree.erase(2.0f));
+	expectMedian(2.0f);
+	expectCount(2);
+	EXPECT_FALSE(tree.erase(2.0f));
+
+	EXPECT_TRUE(tree.erase(1.0f));
+	expectMedian(3.0f);
+	expectCount(1);
+
+	EXPECT_TRUE(tree.erase(3.0f));
+	expectMedian(.0f);
+	expectCount(0);
+	EXPECT_TRUE(tree.empty());
+
+	tree.insert(5.0f);
+	expectMedian(5.0f);
+	expectCount(1);
+}
+
+TEST_F(OrderStatisticTreeTestFixture, large_session_is_exact)
+{
+	// Insert 100k distinct values in a scrambled order, plus a duplicate of every tenth value
+	constexpr auto valueCount = 100000;
+	std::vector<float> values;
+	for (auto index = 0; index < valueCount; index++)
+	{
+		auto value = 50.0f + (float)((index * 7919) % valueCount) * .001f;
+		tree.insert(value);
+		values.push_back(value);
+		if (index % 10 == 0)
+		{
+			tree.insert(value);
+			values.push_back(value);
+		}
+	}
+	std::sort(values.begin(), values.end());
+	expectCount(values.size());
+
+	for (size_t rank = 0; rank < values.size(); rank += 997)
+	{
+		EXPECT_EQ(tree.select(rank), values[rank]);
+	}
+	EXPECT_EQ(tree.countLessThan(values[1234]), (size_t)(std::lower_bound(values.begin(), values.end(), values[1234]) - values.begin()));
+	EXPECT_EQ(tree.getMin(), values.front());
+	EXPECT_EQ(tree.getMax(), values.back());
+
+	// Erasing every value but the last one must keep the remaining ranks intact
+	for (size_t index = 0; index + 1 < values.size(); index++)
+	{
+		ASSERT_TRUE(tree.erase(values[index]));
+	}
+	expectCount(1);
+	expectMedian(values.back());
+}
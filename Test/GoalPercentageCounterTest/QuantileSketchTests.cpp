@@ -0,0 +1,87 @@
+#include "Fixtures/QuantileSketchTestFixture.h"
+
+TEST_F(QuantileSketchTestFixture, small_sessions_are_exact)
+{
+	for (auto value = 1; value <= 11; value++)
+	{
+		sketch.insert((float)(12 - value) * 10.0f);
+	}
+
+	EXPECT_TRUE(sketch.isExact());
+	EXPECT_EQ(sketch.getCount(), 11);
+	EXPECT_EQ(sketch.getMin(), 10.0f);
+	EXPECT_EQ(sketch.getMax(), 110.0f);
+	EXPECT_EQ(sketch.getPercentile(.25), 35.0f);
+	EXPECT_EQ(sketch.getPercentile(.5), 60.0f);
+	EXPECT_EQ(sketch.getPercentile(.9), 100.0f);
+
+	sketch.clear();
+	EXPECT_TRUE(sketch.empty());
+	EXPECT_EQ(sketch.getPercentile(.5), .0f);
+}
+
+TEST_F(QuantileSketchTestFixture, large_sessions_use_bounded_memory)
+{
+	auto values = createValues(100000);
+	size_t maximumNumberOfStoredValues = 0;
+	for (auto value : values)
+	{
+		sketch.insert(value);
+		maximumNumberOfStoredValues = std::max<size_t>(maximumNumberOfStoredValues, sketch.getNumberOfStoredValues());
+	}
+	std::sort(values.begin(), values.end());
+
+	EXPECT_FALSE(sketch.isExact());
+	EXPECT_EQ(sketch.getCount(), 100000);
+	EXPECT_LE(maximumNumberOfStoredValues, 3 * QuantileSketch::DefaultAccuracy + 2 * sketch.getLevels().size());
+	EXPECT_EQ(sketch.getPercentile(.0), values.front());
+	EXPECT_EQ(sketch.getPercentile(1.0), values.back());
+	for (auto percentile : { .1, .25, .5, .75, .9 })
+	{
+		expectPercentileRank(values, percentile, .01);
+	}
+}
+
+TEST_F(QuantileSketchTestFixture, merged_sessions_are_as_accurate_as_one_session)
+{
+	// Three sessions of different size and range
+	std::vector<float> allValues;
+	for (auto [numberOfValues, offset] : { std::pair{ 30000, 0 }, std::pair{ 150, 7 }, std::pair{ 50000, 11 } })
+	{
+		QuantileSketch sessionSketch;
+		for (auto value : createValues(numberOfValues, offset))
+		{
+			sessionSketch.insert(value + (float)offset);
+			allValues.push_back(value + (float)offset);
+		}
+		sketch.merge(sessionSketch);
+	}
+	std::sort(allValues.begin(), allValues.end());
+
+	EXPECT_EQ(sketch.getCount(), allValues.size());
+	EXPECT_EQ(sketch.getMin(), allValues.front());
+	EXPECT_EQ(sketch.getMax(), allValues.back());
+	EXPECT_LE(sketch.getNumberOfStoredValues(), 3 * QuantileSketch::DefaultAccuracy + 2 * sketch.getLevels().size());
+	for (auto percentile : { .1, .25, .5, .75, .9 })
+	{
+		expectPercentileRank(allValues, percentile, .01);
+	}
+}
+
+TEST_F(QuantileSketchTestFixture, restore_accepts_only_consistent_levels)
+{
+	for (auto value : createValues(5000))
+	{
+		sketch.insert(value);
+	}
+
+	QuantileSketch restoredSketch;
+	EXPECT_TRUE(restoredSketch.restore(sketch.getCount(), sketch.getMin(), sketch.getMax(), sketch.getLevels()));
+	EXPECT_EQ(restoredSketch.getCount(), sketch.getCount());
+	EXPECT_EQ(restoredSketch.getPercentile(.5), sketch.getPercentile(.5));
+	EXPECT_EQ(restoredSketch.getPercentile(.9), sketch.getPercentile(.9));
+
+	// The weights of the levels don't add up to the count
+	EXPECT_FALSE(restoredSketch.restore(sketch.getCount() + 1, sketch.getMin(), sketch.getMax(), sketch.getLevels()));
+	EXPECT_TRUE(restoredSketch.empty());
+}
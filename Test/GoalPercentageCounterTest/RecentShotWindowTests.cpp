@@ -0,0 +1,64 @@
+#include "Fixtures/RecentShotWindowTestFixture.h"
+
+TEST_F(RecentShotWindowTestFixture, oldest_shots_are_dropped_when_full)
+{
+	// Act
+	recentShots.push_back(true);
+	recentShots.push_back(true);
+	for (int shotNumber = 0; shotNumber < 69; shotNumber++)
+	{
+		recentShots.push_back(false);
+	}
+
+	// Assert
+	EXPECT_EQ(recentShots.size(), 70);
+	EXPECT_EQ(recentShots.numberOfGoals(), 1);
+	EXPECT_TRUE(recentShots[0]);
+	EXPECT_FALSE(recentShots.back());
+}
+
+TEST_F(RecentShotWindowTestFixture, goals_in_last_shots_are_counted_across_the_wrap_around)
+{
+	// Arrange
+	addShots(100);
+
+	// Act & Assert
+	for (size_t numberOfShots = 1; numberOfShots <= recentShots.size(); numberOfShots++)
+	{
+		EXPECT_EQ(recentShots.numberOfGoalsInLast(numberOfShots), countGoalsInLast(numberOfShots)) << "for the last " << numberOfShots << " shots";
+	}
+}
+
+TEST_F(RecentShotWindowTestFixture, string_conversion_keeps_the_order_of_shots)
+{
+	// Arrange
+	recentShots = RecentShotWindow<70>::fromString("0110");
+
+	// Act
+	recentShots.push_back(true);
+
+	// Assert
+	EXPECT_EQ(recentShots.toString(), "01101");
+	EXPECT_EQ(recentShots.numberOfGoals(), 3);
+}
+
+TEST_F(RecentShotWindowTestFixture, packed_words_restore_the_shots_after_the_wrap_around)
+{
+	// Arrange
+	for (auto index = 0; index < 75; index++)
+	{
+		recentShots.push_back(index % 3 == 0);
+	}
+	RecentShotWindow<70> restoredShots;
+
+	// Act
+	auto firstWord = recentShots.getPackedWord(0);
+	auto secondWord = recentShots.getPackedWord(1);
+	restoredShots.pushPackedWord(firstWord, 64);
+	restoredShots.pushPackedWord(secondWord, recentShots.size() - 64);
+
+	// Assert
+	EXPECT_EQ(firstWord & 0xF, 0x2); // The oldest shot is the sixth one, so of the four oldest shots, only the second one is a goal
+	EXPECT_EQ(secondWord >> 6, 0);
+	EXPECT_EQ(restoredShots, recentShots);
+}
@@ -0,0 +1,59 @@
+#include "Fixtures/RollingWindowCalculatorTestFixture.h"
+
+TEST_F(RollingWindowCalculatorTestFixture, goal_counts_match_recent_shots)
+{
+	// Arrange
+	RollingWindowCalculator::configureWindows(statsData, { 10, 25, 50, 100, 500 });
+
+	// Act
+	addShots(620);
+
+	// Assert
+	for (const auto& window : statsData.Data.RollingWindows)
+	{
+		EXPECT_EQ((size_t)window.Goals, statsData.Stats.RecentShots.numberOfGoalsInLast(window.Size)) << "for window size " << window.Size;
+	}
+}
+
+TEST_F(RollingWindowCalculatorTestFixture, peak_is_tracked_per_window)
+{
+	// Arrange
+	RollingWindowCalculator::configureWindows(statsData, { 3, 100 });
+
+	// Act
+	addShots(30);
+
+	// Assert
+	// Three consecutive shots always contain exactly one goal, but the first window of three was reached at the third attempt
+	auto& smallWindow = getWindow(3);
+	EXPECT_DOUBLE_EQ(smallWindow.PeakPercentage, 33.33);
+	EXPECT_EQ(smallWindow.PeakShotNumber, 3);
+
+	// The large window only tracks its peak from the 20th attempt on, so the early 100% don't count. 8 out of 22 is the best after that
+	auto& largeWindow = getWindow(100);
+	EXPECT_DOUBLE_EQ(largeWindow.PeakPercentage, 36.36);
+	EXPECT_EQ(largeWindow.PeakShotNumber, 22);
+}
+
+TEST_F(RollingWindowCalculatorTestFixture, reconfiguring_keeps_existing_windows)
+{
+	// Arrange
+	RollingWindowCalculator::configureWindows(statsData, { 10, 50 });
+	addShots(60);
+	auto previousWindow = getWindow(50);
+
+	// Act
+	RollingWindowCalculator::configureWindows(statsData, { 25, 50, 1000 });
+
+	// Assert
+	EXPECT_TRUE(RollingWindowCalculator::hasWindowSizes(statsData, { 25, 50 }));
+	EXPECT_EQ(statsData.Data.RollingWindows[2].Size, 0); // Too large
+	auto& keptWindow = getWindow(50);
+	EXPECT_EQ(keptWindow.Goals, previousWindow.Goals);
+	EXPECT_DOUBLE_EQ(keptWindow.PeakPercentage, previousWindow.PeakPercentage);
+
+	// The new window counts the goals among the shots which were made already
+	auto& newWindow = getWindow(25);
+	EXPECT_EQ((size_t)newWindow.Goals, statsData.Stats.RecentShots.numberOfGoalsInLast(25));
+	EXPECT_DOUBLE_EQ(newWindow.PeakPercentage, newWindow.Percentage);
+}
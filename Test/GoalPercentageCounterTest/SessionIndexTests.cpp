@@ -0,0 +1,130 @@
+#include "Fixtures/SessionIndexTestFixture.h"
+
+TEST_F(SessionIndexTestFixture, entries_are_sorted_and_exclude_other_files)
+{
+	// Arrange
+	createFile("2023_01_01.txt");
+	createFile("2023_01_03.bin");
+	createFile("2023_01_03.journal");
+	createFile("2023_01_02.bin");
+	createFile("PACKCODE.txt");
+	SessionIndex sessionIndex;
+
+	// Act
+	auto entries = sessionIndex.getEntries(_folderPath, "PACKCODE.txt", _readSummary);
+
+	// Assert
+	ASSERT_EQ(entries.size(), 3);
+	EXPECT_EQ(entries[0].FileName, "2023_01_03.bin");
+	EXPECT_EQ(entries[1].FileName, "2023_01_02.bin");
+	EXPECT_EQ(entries[2].FileName, "2023_01_01.txt");
+	EXPECT_EQ(entries[0].Attempts, 10);
+	EXPECT_EQ(_numberOfReadSessions, 3);
+}
+
+TEST_F(SessionIndexTestFixture, manifest_is_reused_and_only_changed_sessions_are_read)
+{
+	// Arrange
+	createFile("2023_01_01.bin");
+	createFile("2023_01_02.bin");
+	SessionIndex().getEntries(_folderPath, "PACKCODE.txt", _readSummary);
+	_numberOfReadSessions = 0;
+
+	auto changedFilePath = _folderPath / "2023_01_02.bin";
+	std::filesystem::last_write_time(changedFilePath, std::filesystem::last_write_time(changedFilePath) + std::chrono::hours(1));
+	SessionIndex sessionIndex;
+
+	// Act
+	auto entries = sessionIndex.getEntries(_folderPath, "PACKCODE.txt", _readSummary);
+
+	// Assert
+	EXPECT_EQ(entries.size(), 2);
+	EXPECT_EQ(_numberOfReadSessions, 1);
+}
+
+TEST_F(SessionIndexTestFixture, updated_entry_is_visible_without_reading_the_session)
+{
+	// Arrange
+	createFile("2023_01_01.bin");
+	SessionIndex sessionIndex;
+	sessionIndex.getEntries(_folderPath, "PACKCODE.txt", _readSummary);
+	createFile("2023_01_02.bin");
+
+	// Act
+	sessionIndex.updateEntry(_folderPath / "2023_01_02.bin", 7, 3, 5, "2.0", true);
+
+	// Assert
+	auto entry = sessionIndex.findEntry(_folderPath / "2023_01_02.bin");
+	ASSERT_NE(entry, nullptr);
+	EXPECT_EQ(entry->Attempts, 7);
+	EXPECT_EQ(entry->Goals, 3);
+	EXPECT_EQ(sessionIndex.getEntries(_folderPath, "PACKCODE.txt", _readSummary).front().FileName, "2023_01_02.bin");
+	EXPECT_EQ(_numberOfReadSessions, 1);
+
+	// A new index must not need to read the session either, since the manifest was written
+	_numberOfReadSessions = 0;
+	SessionIndex().getEntries(_folderPath, "PACKCODE.txt", _readSummary);
+	EXPECT_EQ(_numberOfReadSessions, 0);
+}
+
+TEST_F(SessionIndexTestFixture, sessions_added_or_removed_outside_of_the_plugin_are_noticed)
+{
+	// Arrange
+	createFile("2023_01_01.bin");
+	createFile("2023_01_02.bin");
+	SessionIndex sessionIndex;
+	sessionIndex.getEntries(_folderPath, "PACKCODE.txt", _readSummary);
+	_numberOfReadSessions = 0;
+
+	std::filesystem::remove(_folderPath / "2023_01_01.bin");
+	createFile("2023_01_03.bin");
+
+	// Act
+	auto entries = sessionIndex.getEntries(_folderPath, "PACKCODE.txt", _readSummary);
+
+	// Assert
+	ASSERT_EQ(entries.size(), 2);
+	EXPECT_EQ(entries[0].FileName, "2023_01_03.bin");
+	EXPECT_EQ(entries[1].FileName, "2023_01_02.bin");
+	EXPECT_EQ(_numberOfReadSessions, 1);
+}
+
+TEST_F(SessionIndexTestFixture, manifest_is_not_written_if_no_entry_changed)
+{
+	// Arrange
+	createFile("2023_01_01.bin");
+	SessionIndex sessionIndex;
+	sessionIndex.getEntries(_folderPath, "PACKCODE.txt", _readSummary);
+	sessionIndex.updateEntry(_folderPath / "2023_01_01.bin", 7, 3, 5, "2.0", true);
+	auto manifestPath = _folderPath / "Sessions.index";
+	std::filesystem::remove(manifestPath);
+
+	// Act
+	sessionIndex.updateEntry(_folderPath / "2023_01_01.bin", 7, 3, 5, "2.0", true);
+	auto manifestWasWritten = std::filesystem::exists(manifestPath);
+	sessionIndex.updateEntry(_folderPath / "2023_01_01.bin", 8, 3, 5, "2.0", true);
+
+	// Assert
+	EXPECT_FALSE(manifestWasWritten);
+	EXPECT_TRUE(std::filesystem::exists(manifestPath));
+}
+
+TEST_F(SessionIndexTestFixture, loaded_folder_is_not_read_again_while_it_is_unchanged)
+{
+	// Arrange
+	createFile("2023_01_01.bin");
+	SessionIndex sessionIndex;
+	sessionIndex.getEntries(_folderPath, "PACKCODE.txt", _readSummary);
+	_numberOfReadSessions = 0;
+
+	// Changing a session does not change the folder. The stat writer updates the entries of its sessions instead
+	auto changedFilePath = _folderPath / "2023_01_01.bin";
+	std::filesystem::last_write_time(changedFilePath, std::filesystem::last_write_time(changedFilePath) + std::chrono::hours(1));
+
+	// Act
+	auto entries = sessionIndex.getEntries(_folderPath, "PACKCODE.txt", _readSummary);
+
+	// Assert
+	EXPECT_EQ(entries.size(), 1);
+	EXPECT_EQ(_numberOfReadSessions, 0);
+}
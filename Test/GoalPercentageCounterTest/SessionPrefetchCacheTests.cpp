@@ -0,0 +1,50 @@
+#include "Fixtures/SessionPrefetchCacheTestFixture.h"
+
+TEST_F(SessionPrefetchCacheTestFixture, prefetched_sessions_are_answered_from_memory)
+{
+	// Arrange
+	expectSessionLoads(1);
+	_prefetchCache->prefetch(FakeTrainingPackCode);
+
+	// Act
+	auto mostRecentAttempts = requestAttempts(0);
+	auto previousAttempts = requestAttempts(1);
+	auto repeatedAttempts = requestAttempts(0);
+
+	// Assert
+	EXPECT_EQ(mostRecentAttempts, 10);
+	EXPECT_EQ(previousAttempts, 20);
+	EXPECT_EQ(repeatedAttempts, 10);
+}
+
+TEST_F(SessionPrefetchCacheTestFixture, writing_a_session_with_attempts_causes_a_reload)
+{
+	// Arrange
+	expectSessionLoads(2);
+	_prefetchCache->prefetch(FakeTrainingPackCode);
+	_prefetchCache->invalidateSession(std::filesystem::u8path("session_3"), 0); // A new session without attempts is no previous session yet
+	requestAttempts(0);
+
+	// Act
+	_prefetchCache->invalidateSession(std::filesystem::u8path("session_3"), 1);
+	auto attempts = requestAttempts(0);
+
+	// Assert
+	EXPECT_EQ(attempts, 10);
+}
+
+TEST_F(SessionPrefetchCacheTestFixture, restored_session_is_handed_over_only_once)
+{
+	// Arrange
+	expectSessionLoads(1, 1);
+	EXPECT_CALL(*_statReader, readStats(MostRecentSession, StatFieldMask::DiffComparable)).WillOnce(::testing::Return(createStats(11)));
+	_prefetchCache->prefetch(FakeTrainingPackCode);
+
+	// Act
+	auto restoredStats = _prefetchCache->restorePreviousSession(FakeTrainingPackCode);
+	auto attempts = requestAttempts(0);
+
+	// Assert
+	EXPECT_EQ(restoredStats.AllShotStats.Stats.Attempts, 10);
+	EXPECT_EQ(attempts, 11); // Read again since the prefetched stats are owned by the current session now
+}
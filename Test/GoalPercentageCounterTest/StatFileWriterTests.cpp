@@ -0,0 +1,45 @@
+#include "Fixtures/StatFileWriterTestFixture.h"
+
+TEST_F(StatFileWriterTestFixture, failed_snapshot_does_not_stop_further_writes)
+{
+	// Arrange
+	_statWriter->initializeStorageInFolder(_folderPath);
+	auto sessionFilePath = findSessionFile();
+	ASSERT_FALSE(sessionFilePath.empty());
+
+	// A directory in place of the session file makes writing it fail
+	std::filesystem::remove(sessionFilePath);
+	std::filesystem::create_directory(sessionFilePath);
+	addAttempt();
+	_statWriter->writeData();
+	std::filesystem::remove(sessionFilePath);
+
+	// Act
+	addAttempt();
+	_statWriter->writeData();
+
+	// Assert: A snapshot is written rather than a journal record which would be based on the failed snapshot
+	EXPECT_EQ(readAttempts(sessionFilePath), 2);
+}
+
+TEST_F(StatFileWriterTestFixture, failed_write_does_not_affect_the_next_session)
+{
+	// Arrange
+	_statWriter->initializeStorageInFolder(_folderPath);
+	auto sessionFilePath = findSessionFile();
+	ASSERT_FALSE(sessionFilePath.empty());
+	std::filesystem::remove(sessionFilePath);
+	std::filesystem::create_directory(sessionFilePath);
+	addAttempt();
+	_statWriter->writeData();
+	std::filesystem::remove(sessionFilePath);
+
+	// Act
+	_statWriter->initializeStorageInFolder(_folderPath);
+	_statWriter->writeData();
+
+	// Assert
+	auto newSessionFilePath = findSessionFile();
+	ASSERT_FALSE(newSessionFilePath.empty());
+	EXPECT_EQ(readAttempts(newSessionFilePath), 1);
+}
@@ -0,0 +1,52 @@
+#include "Fixtures/StatRowPlanTestFixture.h"
+
+TEST_F(StatRowPlanTestFixture, rebuild_plans_visible_stats_in_display_order)
+{
+	// Arrange
+	std::vector<std::string> orderedStats = { "Total Success Rate", "Most Recent Goal Speed", "Attempts/Goals" };
+
+	// Act
+	plan.rebuild(StatVisibilityMask::TotalSuccessRate | StatVisibilityMask::AttemptsAndGoals, orderedStats);
+
+	// Assert
+	EXPECT_EQ(getPlannedIds(), std::vector<StatRowId>({ StatRowId::TotalSuccessRate, StatRowId::Attempts, StatRowId::Goals }));
+}
+
+TEST_F(StatRowPlanTestFixture, formatRows_uses_speed_units_of_the_plan)
+{
+	// Arrange
+	std::vector<std::string> orderedStats = { "Most Recent Goal Speed" };
+
+	// Act
+	plan.rebuild(StatVisibilityMask::MostRecentGoalSpeed, orderedStats);
+	auto imperialRows = plan.formatRows(statsData);
+	plan.rebuild(StatVisibilityMask::MostRecentGoalSpeed | StatVisibilityMask::MetricUnits, orderedStats);
+	auto metricRows = plan.formatRows(statsData);
+
+	// Assert
+	ASSERT_EQ(imperialRows.size(), 1);
+	ASSERT_EQ(metricRows.size(), 1);
+	EXPECT_EQ(imperialRows.front().Label, "Latest Goal Speed:");
+	EXPECT_EQ(imperialRows.front().Unit, "mph");
+	EXPECT_EQ(metricRows.front().Unit, "km/h");
+}
+
+TEST_F(StatRowPlanTestFixture, formatRows_adds_difference_only_if_diff_data_is_provided)
+{
+	// Arrange
+	StatsData diffData;
+	diffData.Stats.LongestGoalStreak = -2;
+	plan.rebuild(StatVisibilityMask::LongestStreaks, { "Longest Miss/Goal Streaks" });
+
+	// Act
+	auto rows = plan.formatRows(statsData);
+	auto rowsWithDiff = plan.formatRows(statsData, &diffData);
+
+	// Assert
+	ASSERT_EQ(rows.size(), 2);
+	ASSERT_EQ(rowsWithDiff.size(), 2);
+	EXPECT_FALSE(rows.front().DiffValue.has_value());
+	EXPECT_EQ(rowsWithDiff.front().DiffValue, "-2");
+	EXPECT_TRUE(rowsWithDiff.front().DiffIsNegative);
+	EXPECT_EQ(rowsWithDiff.front().DiffNumber, -2.0);
+}
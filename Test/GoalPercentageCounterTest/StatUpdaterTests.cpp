@@ -14,7 +14,7 @@ TEST_F(StatUpdaterTestFixture, verify_fixture)
 	expectedStats.MissStreakCounter = 0;
 	expectedStats.LongestGoalStreak = 0;
 	expectedStats.LongestMissStreak = 0;
-	expectedStats.Last50Shots.clear();
+	expectedStats.RecentShots.clear();
 
 	statUpdater->processReset(_pluginState->TotalRounds); // A reset is always sent when a new training pack is being loaded
 
@@ -51,7 +51,7 @@ TEST_F(StatUpdaterTestFixture, goal_attempt_increases_goals)
 	expectedStats.InitialHits = 1;
 	expectedStats.GoalStreakCounter = 1;
 	expectedStats.LongestGoalStreak = 1;
-	expectedStats.Last50Shots.push_back(true);
+	expectedStats.RecentShots.push_back(true);
 
 	// Act
 	statUpdater->processReset(_pluginState->TotalRounds); // A reset is always sent when a new training pack is being loaded
@@ -75,7 +75,7 @@ TEST_F(StatUpdaterTestFixture, miss_attempt_increases_misses)
 	expectedStats.InitialHits = 0; // We simulate a complete miss
 	expectedStats.MissStreakCounter = 1;
 	expectedStats.LongestMissStreak = 1;
-	expectedStats.Last50Shots.push_back(false);
+	expectedStats.RecentShots.push_back(false);
 
 	// Act
 	statUpdater->processReset(_pluginState->TotalRounds); // A reset is always sent when a new training pack is being loaded
@@ -108,7 +108,9 @@ TEST_F(StatUpdaterTestFixture, the_51st_goal_removes_oldest_last_50_shots_entry)
 	// Record one miss and then 50 goals
 	statUpdater->processAttempt();
 	statUpdater->processMiss();
-	// We don't push the miss to Last50Shots since we expect it to be gone after 50 goals
+	statUpdater->updateData();
+	// The miss stays in RecentShots, which holds more shots than the largest rolling window, but it must be gone from the last 50 shots
+	expectedStats.RecentShots.push_back(false);
 	
 	for (auto index = 0; index < 50; index++)
 	{
@@ -116,12 +118,14 @@ TEST_F(StatUpdaterTestFixture, the_51st_goal_removes_oldest_last_50_shots_entry)
 		statUpdater->processInitialBallHit();
 		statUpdater->processGoal();
 		statUpdater->updateData();
-		expectedStats.Last50Shots.push_back(true);
+		expectedStats.RecentShots.push_back(true);
 	}
 
 	expectTotalStats(expectedStats);
 	expectPerShotStats(expectedStats, 0);
 	expectPerShotStats(defaultStats, 1);
+	EXPECT_EQ(_shotStats->AllShotStats.Data.Last50ShotsPercentage, 100.0);
+	EXPECT_EQ(_shotStats->PerShotStats[0].Data.Last50ShotsPercentage, 100.0);
 }
 
 TEST_F(StatUpdaterTestFixture, restoringStats_when_noFilesArePresent_will_returnDefaultStats)
@@ -200,7 +204,7 @@ TEST_F(StatUpdaterTestFixture, restoringStats_when_firstFileHasMoreThanZeroAttem
 		.WillOnce(Return(dummyStats.AllShotStats.Stats.Attempts));
 
 	// We expect a call which tries to read from the first file
-	EXPECT_CALL(*_statReader, readStats(firstFilePath, true))
+	EXPECT_CALL(*_statReader, readStats(firstFilePath, StatFieldMask::All))
 		.WillOnce(Return(dummyStats));
 
 	// Act
@@ -242,7 +246,7 @@ TEST_F(StatUpdaterTestFixture, restoringStats_when_secondFileHasMoreThanZeroAtte
 		.WillOnce(Return(dummyStats.AllShotStats.Stats.Attempts));
 
 	// We expect a call which tries to read from the first file
-	EXPECT_CALL(*_statReader, readStats(secondFilePath, true))
+	EXPECT_CALL(*_statReader, readStats(secondFilePath, StatFieldMask::All))
 		.WillOnce(Return(dummyStats));
 
 	// Act
@@ -287,10 +291,9 @@ TEST_F(StatUpdaterTestFixture, togglingLastShot_when_attemptsHaveBeenMade_will_a
 	oneGoalStats.InitialHits = 1;
 	oneGoalStats.GoalStreakCounter = 1;
 	oneGoalStats.LongestGoalStreak = 1;
-	oneGoalStats.Last50Shots.push_back(true);
+	oneGoalStats.RecentShots.push_back(true);
 
 	const auto goalSpeed = 100.0f;
-	oneGoalStats.GoalSpeedStats()->insert(goalSpeed);
 	_pluginState->setBallSpeed(goalSpeed / PluginState::UE_UNITS_TO_KPH); // We need to convert it to Unreal Engine units when setting it
 
 	// Record a miss and then toggle it
@@ -300,7 +303,7 @@ TEST_F(StatUpdaterTestFixture, togglingLastShot_when_attemptsHaveBeenMade_will_a
 	statUpdater->processMiss();
 	statUpdater->updateData();
 
-	ASSERT_EQ(_shotStats->AllShotStats.Stats.GoalSpeedStats()->getCount(), 0);
+	ASSERT_EQ(_shotStats->AllShotStats.Stats.GoalSpeed.Count, 0);
 
 	statUpdater->toggleLastAttempt();
 
@@ -309,10 +312,199 @@ TEST_F(StatUpdaterTestFixture, togglingLastShot_when_attemptsHaveBeenMade_will_a
 	expectPerShotStats(oneGoalStats, 0);
 	expectPerShotStats(defaultStats, 1);
 
-	EXPECT_EQ(_shotStats->AllShotStats.Stats.GoalSpeedStats()->getCount(), 1);
-	EXPECT_EQ(_shotStats->AllShotStats.Stats.GoalSpeedStats()->getMax(), goalSpeed);
-	EXPECT_EQ(_shotStats->PerShotStats[0].Stats.GoalSpeedStats()->getCount(), 1);
-	EXPECT_EQ(_shotStats->PerShotStats[0].Stats.GoalSpeedStats()->getMax(), goalSpeed);
+	EXPECT_EQ(_shotStats->AllShotStats.Stats.GoalSpeed.Count, 1);
+	EXPECT_EQ(_shotStats->AllShotStats.Stats.GoalSpeed.Max, goalSpeed);
+	EXPECT_EQ(_shotStats->PerShotStats[0].Stats.GoalSpeed.Count, 1);
+	EXPECT_EQ(_shotStats->PerShotStats[0].Stats.GoalSpeed.Max, goalSpeed);
+	EXPECT_EQ(_shotStats->getGoalSpeedValues(0).getValues(), std::vector<float>({ goalSpeed }));
+}
+
+TEST_F(StatUpdaterTestFixture, togglingLastShot_when_lastShotWasAGoal_will_removeGoalSpeed)
+{
+	statUpdater->processReset(2);
+	_pluginState->setBallSpeed(80.0f / PluginState::UE_UNITS_TO_KPH);
+	statUpdater->processAttempt();
+	statUpdater->processGoal();
+	statUpdater->updateData();
+	_pluginState->setBallSpeed(120.0f / PluginState::UE_UNITS_TO_KPH);
+	statUpdater->processAttempt();
+	statUpdater->processGoal();
+	statUpdater->updateData();
+
+	ASSERT_EQ(_shotStats->AllShotStats.Stats.GoalSpeed.Count, 2);
+
+	statUpdater->toggleLastAttempt();
+
+	const auto& goalSpeed = _shotStats->AllShotStats.Stats.GoalSpeed;
+	EXPECT_EQ(goalSpeed.Count, 1);
+	EXPECT_FLOAT_EQ(goalSpeed.MostRecent, 80.0f);
+	EXPECT_FLOAT_EQ(goalSpeed.Max, 80.0f);
+	EXPECT_FLOAT_EQ(goalSpeed.Mean, 80.0f);
+	EXPECT_EQ(_shotStats->PerShotStats[0].Stats.GoalSpeed.Count, 1);
+	EXPECT_EQ(_shotStats->getGoalSpeedValues(-1).getCount(), 1);
+}
+
+TEST_F(StatUpdaterTestFixture, undoingAttempts_when_attemptsHaveBeenMade_will_restoreEarlierStats)
+{
+	PlayerStats oneGoalStats;
+	PlayerStats defaultStats;
+	oneGoalStats.Attempts = 1;
+	oneGoalStats.Goals = 1;
+	oneGoalStats.GoalStreakCounter = 1;
+	oneGoalStats.LongestGoalStreak = 1;
+	oneGoalStats.RecentShots.push_back(true);
+
+	statUpdater->processReset(2);
+	_pluginState->setBallSpeed(80.0f / PluginState::UE_UNITS_TO_KPH);
+	statUpdater->processAttempt();
+	statUpdater->processGoal();
+	statUpdater->updateData();
+	statUpdater->processAttempt();
+	statUpdater->processGoal();
+	statUpdater->updateData();
+	statUpdater->processAttempt();
+	statUpdater->processMiss();
+	statUpdater->updateData();
+
+	statUpdater->undoLastAttempt();
+	statUpdater->undoLastAttempt();
+
+	expectTotalStats(oneGoalStats);
+	expectPerShotStats(oneGoalStats, 0);
+	expectPerShotStats(defaultStats, 1);
+	EXPECT_EQ(_shotStats->getGoalSpeedValues(-1).getCount(), 1);
+	EXPECT_EQ(_shotStats->getGoalSpeedValues(0).getCount(), 1);
+}
+
+TEST_F(StatUpdaterTestFixture, redoingAttempts_when_attemptsHaveBeenUndone_will_reapplyThem)
+{
+	statUpdater->processReset(2);
+	_pluginState->setBallSpeed(80.0f / PluginState::UE_UNITS_TO_KPH);
+	statUpdater->processAttempt();
+	statUpdater->processInitialBallHit();
+	statUpdater->processGoal();
+	statUpdater->updateData();
+	statUpdater->processAttempt();
+	statUpdater->processMiss();
+	statUpdater->updateData();
+	auto expectedStats = _shotStats->AllShotStats.Stats;
+
+	statUpdater->undoLastAttempt();
+	statUpdater->undoLastAttempt();
+	statUpdater->redoLastAttempt();
+	statUpdater->redoLastAttempt();
+	statUpdater->redoLastAttempt(); // There is nothing left to be redone
+
+	expectTotalStats(expectedStats);
+	expectPerShotStats(expectedStats, 0);
+	EXPECT_EQ(_shotStats->getGoalSpeedValues(-1).getValues(), std::vector<float>({ 80.0f }));
+}
+
+TEST_F(StatUpdaterTestFixture, togglingLastShot_when_shotHasBeenSwitched_will_adaptStatsOfTheAttemptedShot)
+{
+	PlayerStats oneGoalStats;
+	PlayerStats defaultStats;
+	oneGoalStats.Attempts = 1;
+	oneGoalStats.Goals = 1;
+	oneGoalStats.GoalStreakCounter = 1;
+	oneGoalStats.LongestGoalStreak = 1;
+	oneGoalStats.RecentShots.push_back(true);
+
+	statUpdater->processReset(2);
+	_pluginState->CurrentRoundIndex = 1;
+	statUpdater->processAttempt();
+	statUpdater->processMiss();
+	statUpdater->updateData();
+
+	_pluginState->CurrentRoundIndex = 0;
+	statUpdater->toggleLastAttempt();
+
+	expectTotalStats(oneGoalStats);
+	expectPerShotStats(defaultStats, 0);
+	expectPerShotStats(oneGoalStats, 1);
+}
+
+TEST_F(StatUpdaterTestFixture, updatingData_when_compareBaseIsAvailable_will_updateDifferencesOfTheCurrentShot)
+{
+	const std::string filePath = "path/to/file";
+	ShotStats compareBase;
+	compareBase.PerShotStats.resize(2);
+	compareBase.AllShotStats.Stats.Attempts = 5;
+	compareBase.AllShotStats.Stats.Goals = 3;
+	compareBase.PerShotStats[0].Stats.Attempts = 2;
+	compareBase.PerShotStats[0].Stats.Goals = 1;
+	compareBase.PerShotStats[1].Stats.Attempts = 3;
+	compareBase.PerShotStats[1].Stats.Goals = 2;
+
+	EXPECT_CALL(*_statReader, getAvailableResourcePaths(FakeTrainingPackCode))
+		.WillOnce(Return(std::vector<std::string>{ filePath }));
+	EXPECT_CALL(*_statReader, peekAttemptAmount(filePath))
+		.WillOnce(Return(compareBase.AllShotStats.Stats.Attempts));
+	EXPECT_CALL(*_statReader, readStats(filePath, StatFieldMask::DiffComparable))
+		.WillOnce(Return(compareBase));
+
+	_pluginState->StatsShallBeComparedToAllTimePeak = false;
+	auto differenceStats = std::make_shared<ShotStats>();
+	auto comparingStatUpdater = std::make_shared<StatUpdater>(_shotStats, differenceStats, _pluginState, _statReader, nullptr, nullptr, nullptr);
+	comparingStatUpdater->publishTrainingPackCode(FakeTrainingPackCode);
+	comparingStatUpdater->processReset(2);
+
+	comparingStatUpdater->processAttempt();
+	comparingStatUpdater->processGoal();
+	comparingStatUpdater->updateData();
+
+	ASSERT_EQ(differenceStats->PerShotStats.size(), 2);
+	EXPECT_EQ(differenceStats->AllShotStats.Stats.Goals, -2);
+	EXPECT_EQ(differenceStats->PerShotStats[0].Stats.Goals, 0);
+	EXPECT_EQ(differenceStats->PerShotStats[1].Stats.Goals, -2);
+
+	_pluginState->CurrentRoundIndex = 1;
+	comparingStatUpdater->processAttempt();
+	comparingStatUpdater->processGoal();
+	comparingStatUpdater->updateData();
+
+	EXPECT_EQ(differenceStats->AllShotStats.Stats.Goals, -1);
+	EXPECT_EQ(differenceStats->PerShotStats[0].Stats.Goals, 0);
+	EXPECT_EQ(differenceStats->PerShotStats[1].Stats.Goals, -1);
+	EXPECT_TRUE(differenceStats->hasAttempts());
+}
+
+TEST_F(StatUpdaterTestFixture, updatingData_when_readerHasBeenAdded_will_publishSnapshot)
+{
+	auto snapshots = _snapshotPublisher->addReader();
+	statUpdater->processReset(2);
+	auto versionAfterReset = snapshots->readLatest().Version;
+
+	statUpdater->processAttempt();
+	statUpdater->processGoal();
+
+	// Nothing gets published before the data has been updated
+	EXPECT_EQ(snapshots->readLatest().Version, versionAfterReset);
+
+	statUpdater->updateData();
+
+	const auto& snapshot = snapshots->readLatest();
+	EXPECT_GT(snapshot.Version, versionAfterReset);
+	EXPECT_EQ(snapshot.Stats.AllShotStats.Stats.Goals, 1);
+	ASSERT_EQ(snapshot.Stats.PerShotStats.size(), 2);
+	EXPECT_EQ(snapshot.Stats.PerShotStats[0].Stats.Goals, 1);
+	EXPECT_FALSE(snapshot.Differences.hasAttempts());
+}
+
+TEST_F(StatUpdaterTestFixture, undoingAttempt_when_attemptIsInProgress_will_notChangeAnything)
+{
+	statUpdater->processReset(2);
+	statUpdater->processAttempt();
+	statUpdater->processGoal();
+	statUpdater->updateData();
+	statUpdater->processAttempt();
+	statUpdater->updateData();
+
+	statUpdater->undoLastAttempt();
+	statUpdater->toggleLastAttempt();
+
+	EXPECT_EQ(_shotStats->AllShotStats.Stats.Attempts, 2);
+	EXPECT_EQ(_shotStats->AllShotStats.Stats.Goals, 1);
 }
 
 // Peak percentage is supposed to not be calculated before 20 attempts have been made
@@ -369,4 +561,24 @@ TEST_F(StatUpdaterTestFixture, missing_when_doing21stAttempt_will_notDecreasePea
 
 	// While the total success rate should be less than 5% (1/21), the peak should remain at 5%
 	EXPECT_FLOAT_EQ(_shotStats->AllShotStats.Data.PeakSuccessPercentage, 5.0f);
-}
\ No newline at end of file
+}
+TEST_F(StatUpdaterTestFixture, updatingData_when_readerHasBeenAdded_will_onlyIncreaseVersionOfCurrentShot)
+{
+	// Arrange
+	auto snapshots = _snapshotPublisher->addReader();
+	statUpdater->processReset(2);
+	auto shotVersionsAfterReset = snapshots->readLatest().ShotVersions;
+	ASSERT_EQ(shotVersionsAfterReset.size(), 2);
+
+	// Act
+	_pluginState->CurrentRoundIndex = 1;
+	statUpdater->processAttempt();
+	statUpdater->processGoal();
+	statUpdater->updateData();
+
+	// Assert
+	const auto& snapshot = snapshots->readLatest();
+	ASSERT_EQ(snapshot.ShotVersions.size(), 2);
+	EXPECT_EQ(snapshot.ShotVersions[0], shotVersionsAfterReset[0]);
+	EXPECT_EQ(snapshot.ShotVersions[1], snapshot.Version);
+}
@@ -0,0 +1,53 @@
+#include "Fixtures/StorageWorkerTestFixture.h"
+
+TEST_F(StorageWorkerTestFixture, newest_write_of_a_file_replaces_pending_writes_and_appends)
+{
+	// Arrange
+	blockWorker();
+	_storageWorker->queueWrite("session", createTask(1));
+	_storageWorker->queueAppend("session", createTask(2));
+	_storageWorker->queueWrite("peak", createTask(3));
+	_storageWorker->queueAppend("session", createTask(4));
+
+	// Act
+	_storageWorker->queueWrite("session", createTask(5));
+	releaseWorker();
+	_storageWorker->drain();
+
+	// Assert
+	EXPECT_THAT(_executedTasks, ::testing::ElementsAre(3, 5));
+}
+
+TEST_F(StorageWorkerTestFixture, read_result_is_passed_to_the_game_thread)
+{
+	// Arrange
+	auto result = 0;
+	_storageWorker->queueRead<int>([]() { return 42; }, [&result](int& value) { result = value; });
+	_storageWorker->drain();
+	EXPECT_EQ(result, 0);
+
+	// Act
+	runGameThreadCallbacks();
+
+	// Assert
+	EXPECT_EQ(result, 42);
+}
+
+TEST_F(StorageWorkerTestFixture, shutdown_executes_pending_writes_and_discards_callbacks)
+{
+	// Arrange
+	auto callbackWasExecuted = false;
+	blockWorker();
+	_storageWorker->queueWrite("session", createTask(1));
+	_storageWorker->queueRead<int>([]() { return 42; }, [&callbackWasExecuted](int&) { callbackWasExecuted = true; });
+
+	// Act
+	releaseWorker();
+	_storageWorker->shutdown();
+	runGameThreadCallbacks();
+	_storageWorker->queueWrite("session", createTask(2));
+
+	// Assert
+	EXPECT_THAT(_executedTasks, ::testing::ElementsAre(1, 2));
+	EXPECT_FALSE(callbackWasExecuted);
+}
@@ -0,0 +1,44 @@
+#include "Fixtures/SummaryRowCacheTestFixture.h"
+
+TEST_F(SummaryRowCacheTestFixture, update_provides_one_row_per_shot_and_one_for_all_shots)
+{
+	// Act
+	const auto& snapshot = snapshots->readLatest();
+	cache.update(plan, snapshot, false);
+
+	// Assert
+	EXPECT_EQ(cache.getNumberOfRows(), 3);
+	EXPECT_EQ(cache.getAllShotsRowIndex(), 2);
+	EXPECT_EQ(cache.getRow(plan, snapshot, 0).size(), 2);
+}
+
+TEST_F(SummaryRowCacheTestFixture, getRow_formats_only_rows_of_changed_shots_again)
+{
+	// Arrange
+	EXPECT_EQ(getDisplayedAttempts(0), "0");
+	EXPECT_EQ(getDisplayedAttempts(1), "0");
+	const auto* firstShotCells = &cache.getRow(plan, snapshots->readLatest(), 0).front();
+
+	// Act
+	setAttempts(1, 5);
+
+	// Assert
+	EXPECT_EQ(getDisplayedAttempts(1), "5");
+	EXPECT_EQ(getDisplayedAttempts(2), "5");
+	EXPECT_EQ(getDisplayedAttempts(0), "0");
+	EXPECT_EQ(&cache.getRow(plan, snapshots->readLatest(), 0).front(), firstShotCells); // The row has not been formatted again
+}
+
+TEST_F(SummaryRowCacheTestFixture, update_formats_every_row_again_after_plan_changed)
+{
+	// Arrange
+	EXPECT_EQ(getDisplayedAttempts(0), "0");
+
+	// Act
+	plan.rebuild(StatVisibilityMask::TotalSuccessRate, { "Total Success Rate" });
+	const auto& snapshot = snapshots->readLatest();
+	cache.update(plan, snapshot, false);
+
+	// Assert
+	EXPECT_EQ(cache.getRow(plan, snapshot, 0).front().Label, "Total Success Rate:");
+}
@@ -0,0 +1,69 @@
+#include "Fixtures/TextStatFileTestFixture.h"
+
+TEST_F(TextStatFileTestFixture, version_1_0_file_with_decimal_comma_is_read)
+{
+	// Arrange
+	writeFile("Version\t1.0\r\nNumberOfShots\t1\r\n" + createVersion_1_0_Block(3, 1) + createVersion_1_0_Block(3, 1));
+
+	// Act
+	auto readStats = _statReader->readStats(_filePath.u8string(), StatFieldMask::DiffComparable);
+
+	// Assert
+	EXPECT_EQ(_statReader->peekAttemptAmount(_filePath.u8string()), 3);
+	EXPECT_EQ(readStats.AllShotStats.Stats.Attempts, 3);
+	EXPECT_EQ(readStats.AllShotStats.Stats.Goals, 1);
+	EXPECT_EQ(readStats.AllShotStats.Stats.LongestMissStreak, 2);
+	EXPECT_EQ(readStats.AllShotStats.Stats.RecentShots.toString(), "010");
+	EXPECT_DOUBLE_EQ(readStats.AllShotStats.Data.SuccessPercentage, 33.33);
+	EXPECT_EQ(readStats.AllShotStats.Data.PeakShotNumber, 2);
+	ASSERT_EQ(readStats.PerShotStats.size(), 1);
+	EXPECT_EQ(readStats.PerShotStats[0].Stats.Attempts, 3);
+}
+
+TEST_F(TextStatFileTestFixture, current_text_version_survives_round_trip)
+{
+	// Arrange
+	ShotStats stats;
+	stats.PerShotStats.resize(2);
+	stats.AllShotStats.Stats.Attempts = 3;
+	stats.AllShotStats.Stats.Goals = 2;
+	stats.AllShotStats.Stats.MaxGroundDribbleTime = 2.25f;
+	stats.AllShotStats.Stats.CloseMisses = 1;
+	stats.AllShotStats.Data.CloseMissPercentage = 33.5;
+	stats.PerShotStats[0].Stats.Attempts = 3;
+	stats.insertGoalSpeed(0, 80.5f);
+	stats.insertGoalSpeed(-1, 100.0f);
+
+	StatFileSerializer serializer;
+	writeFile(serializer.serialize(stats, nullptr));
+
+	// Act
+	auto readStats = _statReader->readStats(_filePath.u8string(), RestorableFields);
+
+	// Assert
+	EXPECT_EQ(readStats.AllShotStats.Stats.Attempts, 3);
+	EXPECT_EQ(readStats.AllShotStats.Stats.Goals, 2);
+	EXPECT_EQ(readStats.AllShotStats.Stats.MaxGroundDribbleTime, 2.25f);
+	EXPECT_EQ(readStats.AllShotStats.Stats.CloseMisses, 1);
+	EXPECT_DOUBLE_EQ(readStats.AllShotStats.Data.CloseMissPercentage, 33.5);
+	EXPECT_EQ(readStats.getGoalSpeedValues(-1).getValues(), std::vector<float>({ 80.5f, 100.0f }));
+	EXPECT_EQ(readStats.AllShotStats.Stats.GoalSpeed.Count, 2);
+	ASSERT_EQ(readStats.PerShotStats.size(), 2);
+	EXPECT_EQ(readStats.PerShotStats[0].Stats.GoalSpeed.Count, 1);
+}
+
+TEST_F(TextStatFileTestFixture, malformed_value_is_rejected)
+{
+	// Arrange
+	const auto block = createVersion_1_0_Block(3, 1);
+	auto malformedBlock = block;
+	malformedBlock.replace(malformedBlock.find("Goals\t1"), 7, "Goals\tx");
+	writeFile("Version\t1.0\r\nNumberOfShots\t1\r\n" + block + malformedBlock);
+
+	// Act
+	auto readStats = _statReader->readStats(_filePath.u8string(), StatFieldMask::DiffComparable);
+
+	// Assert
+	EXPECT_FALSE(readStats.hasAttempts());
+	EXPECT_TRUE(readStats.PerShotStats.empty());
+}
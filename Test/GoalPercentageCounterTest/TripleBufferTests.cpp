@@ -0,0 +1,56 @@
+#include "Fixtures/TripleBufferTestFixture.h"
+
+#include <thread>
+
+TEST_F(TripleBufferTestFixture, reading_before_publishing_provides_empty_value)
+{
+	EXPECT_TRUE(buffer.readLatest().empty());
+}
+
+TEST_F(TripleBufferTestFixture, reading_provides_most_recently_published_value)
+{
+	// Act
+	publishValue(1);
+	publishValue(2);
+	publishValue(3);
+
+	// Assert
+	EXPECT_EQ(buffer.readLatest(), std::vector<int>({ 3 }));
+	EXPECT_EQ(buffer.readLatest(), std::vector<int>({ 3 })); // Nothing new has been published
+	publishValue(4);
+	EXPECT_EQ(buffer.readLatest(), std::vector<int>({ 4 }));
+}
+
+TEST_F(TripleBufferTestFixture, reading_while_publishing_provides_complete_values)
+{
+	// Arrange
+	const int numberOfValues = 20000;
+
+	// Act
+	std::thread writer([this, numberOfValues]() {
+		for (auto value = 1; value <= numberOfValues; value++)
+		{
+			// Different sizes force the lists to be reallocated from time to time
+			publishValue(value, (size_t)(value % 16) + 1);
+		}
+	});
+
+	auto previousValue = 0;
+	while (previousValue < numberOfValues)
+	{
+		const auto& values = buffer.readLatest();
+		if (values.empty()) { continue; }
+
+		// A torn value would contain different numbers, or a size which does not match its number.
+		// ASSERT_* would return before the writer got joined, so the loop gets left instead
+		EXPECT_EQ(values.size(), (size_t)(values.front() % 16) + 1);
+		EXPECT_EQ(values.front(), values.back());
+		EXPECT_GE(values.front(), previousValue);
+		if (HasFailure()) { break; }
+		previousValue = values.front();
+	}
+	writer.join();
+
+	// Assert
+	EXPECT_EQ(previousValue, numberOfValues);
+}